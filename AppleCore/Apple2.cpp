@@ -26,17 +26,62 @@
 // Apple2.cpp
 
 #include <stdint.h>
+#include <string.h>
 
 #include "Apple2.h"
 #include "Apple2Hw.h"
+#include "Apple2Disk2.h"
+#include "SaveState.h"
+
+#ifdef DEBUGIO
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGIO) printf("[%d] " f, cycles, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
 
 unsigned int cycles;
 
+// DOS 3.3's RWTS, where a 48K DOS puts it, and its first instructions.
+#define RWTS_ADDR	0xbd00
+
+static const uint8_t rwtsSig[] = {
+	0x84, 0x48,		// STY $48	IOB pointer
+	0x85, 0x49,		// STA $49
+	0xa0, 0x02,		// LDY #$02
+	0x8c, 0xf8, 0x06,	// STY $06F8	recalibrate count
+	0xa0, 0x04,		// LDY #$04
+	0x8c, 0xf8, 0x04,	// STY $04F8	seek count
+	0xa0, 0x01,		// LDY #$01
+	0xb1, 0x48,		// LDA ($48),Y	slot
+};
+
+// RWTS I/O block
+#define IOB_TYPE	0x00	// always 1
+#define IOB_SLOT	0x01	// slot * 16
+#define IOB_DRIVE	0x02
+#define IOB_VOLUME	0x03	// expected, or 0 for any
+#define IOB_TRACK	0x04
+#define IOB_SECTOR	0x05
+#define IOB_BUFFER	0x08	// 16 bits
+#define IOB_COMMAND	0x0c
+#define IOB_ERROR	0x0d
+#define IOB_VOLFOUND	0x0e
+#define IOB_LASTSLOT	0x0f
+#define IOB_LASTDRIVE	0x10
+#define IOB_SIZE	0x11
+
+#define RWTS_READ	1
+#define RWTS_WRITE	2
+
 void
 Apple2::reset(void)
 {
 	applehw.reset();
 	cpu.reset();
+	if (input_cb)
+		input_cb(APPLE_INPUT_RESET, 0, 0);
 }
 
 void
@@ -44,6 +89,116 @@ Apple2::restart(void)
 {
 	applehw.restart();
 	cpu.reset();
+	if (input_cb)
+		input_cb(APPLE_INPUT_RESTART, 0, 0);
+}
+
+// The paddle position is passed on bit for bit so a replay is exact.
+void
+Apple2::setPaddle(int n, float val)
+{
+	applehw.setPaddle(n, val);
+	if (input_cb) {
+		int bits;
+		memcpy(&bits, &val, sizeof(bits));
+		input_cb(APPLE_INPUT_PADDLE, n, bits);
+	}
+}
+
+// Apply an input event reported earlier by the input callback.
+void
+Apple2::input(int type, int a, int b)
+{
+	float val;
+
+	switch (type) {
+	case APPLE_INPUT_KEY:
+		setkey(a);
+		break;
+	case APPLE_INPUT_PADDLE:
+		memcpy(&val, &b, sizeof(val));
+		setPaddle(a, val);
+		break;
+	case APPLE_INPUT_BUTTON:
+		setButton(a, b != 0);
+		break;
+	case APPLE_INPUT_RESET:
+		reset();
+		break;
+	case APPLE_INPUT_RESTART:
+		restart();
+		break;
+	}
+}
+
+// Do an RWTS call in place of DOS, as far as it can be seen to be an
+// ordinary one, and return from it.  Returns false to let RWTS run.
+bool
+Apple2::rwtsTrap(void)
+{
+	Apple2Disk2 *disk = applehw.getDisk();
+	uint8_t code[sizeof(rwtsSig)];
+	uint8_t iob[IOB_SIZE];
+
+	// Not while debugging or for nibble images, which may be protected.
+	if (!disk->haveImage() || disk->getFormat() == DISK2_NIB ||
+	    cpu.getNumBreaks() > 0 || cpu.isStepping())
+		return false;
+
+	applehw.readRam(RWTS_ADDR, code, sizeof(code));
+	if (memcmp(code, rwtsSig, sizeof(code)) != 0)
+		return false;
+
+	// IOB address in A and Y.
+	uint16_t iobaddr = cpu.getY() | (cpu.getA() << 8);
+	if (iobaddr > RAM_SIZE - IOB_SIZE)
+		return false;
+	applehw.readRam(iobaddr, iob, IOB_SIZE);
+
+	uint16_t buf = iob[IOB_BUFFER] | (iob[IOB_BUFFER + 1] << 8);
+	int cmd = iob[IOB_COMMAND];
+	if (iob[IOB_TYPE] != 1 || iob[IOB_SLOT] != 0x60 ||
+	    iob[IOB_DRIVE] != 1 || buf > RAM_SIZE - 256 ||
+	    (iob[IOB_VOLUME] != 0 && iob[IOB_VOLUME] != DISK2_VOLUME) ||
+	    (cmd != RWTS_READ && cmd != RWTS_WRITE))
+		return false;
+
+	// Errors are left to RWTS to report.
+	uint8_t data[256];
+	if (cmd == RWTS_READ) {
+		if (!disk->readSector(iob[IOB_TRACK], iob[IOB_SECTOR], data))
+			return false;
+		applehw.writeRam(buf, data, 256);
+	} else {
+		applehw.readRam(buf, data, 256);
+		if (!disk->writeSector(iob[IOB_TRACK], iob[IOB_SECTOR], data))
+			return false;
+	}
+
+	DPRINTF(2, "Apple2::%s: cmd=%d trk=%d sec=%d buf=0x%04x\n",
+		__func__, cmd, iob[IOB_TRACK], iob[IOB_SECTOR], buf);
+
+	// What RWTS leaves behind that DOS looks at.
+	uint8_t ptr[2] = { (uint8_t)iobaddr, (uint8_t)(iobaddr >> 8) };
+	applehw.writeRam(0x48, ptr, 2);
+	iob[IOB_ERROR] = 0;
+	iob[IOB_VOLFOUND] = DISK2_VOLUME;
+	iob[IOB_LASTSLOT] = iob[IOB_SLOT];
+	iob[IOB_LASTDRIVE] = iob[IOB_DRIVE];
+	applehw.writeRam(iobaddr + IOB_ERROR, &iob[IOB_ERROR],
+			 IOB_SIZE - IOB_ERROR);
+
+	// RTS with carry clear.
+	uint8_t ret[2];
+	uint8_t sp = cpu.getSp();
+	applehw.readRam(0x100 + (uint8_t)(sp + 1), &ret[0], 1);
+	applehw.readRam(0x100 + (uint8_t)(sp + 2), &ret[1], 1);
+	cpu.setSp(sp + 2);
+	cpu.setPc((ret[0] | (ret[1] << 8)) + 1);
+	cpu.setA(0);
+	cpu.setP(cpu.getP() & ~0x01);
+
+	return true;
 }
 
 bool
@@ -52,6 +207,20 @@ Apple2::cycle(void)
 	bool retv;
 
 	applehw.cycle();
+
+	// A fast disk access takes its time with the CPU held.
+	if (stall > 0) {
+		stall--;
+		cycles++;
+		return true;
+	}
+	if (fastdisk > 0 && cpu.getPc() == RWTS_ADDR && cpu.isFetching() &&
+	    rwtsTrap()) {
+		stall = fastdisk - 1;
+		cycles++;
+		return true;
+	}
+
 	retv = cpu.cycle();
 
 	cycles++;
@@ -59,3 +228,56 @@ Apple2::cycle(void)
 	return retv;
 }
 
+// Only if a fast disk access is under way.
+void
+Apple2::saveStall(StateWriter &w)
+{
+	if (stall > 0) {
+		w.beginChunk("FDSK");
+		w.putInt(stall);
+		w.endChunk();
+	}
+}
+
+// Save the whole machine between cycles.  The writer's buffer is reused
+// so this doesn't allocate once it has grown.
+void
+Apple2::saveState(StateWriter &w)
+{
+	w.begin("APL2");
+	cpu.saveState(w);
+	applehw.saveState(w);
+	saveStall(w);
+}
+
+// Returns false if the state is not for this machine and version, or is
+// damaged.  A damaged state can leave the machine partly loaded.
+bool
+Apple2::loadState(StateReader &r)
+{
+	if (!r.begin("APL2"))
+		return false;
+	cpu.loadState(r);
+	applehw.loadState(r);
+
+	// Only there if a fast disk access was under way.
+	stall = 0;
+	if (r.findChunk("FDSK")) {
+		stall = r.getInt();
+		r.endChunk();
+	}
+
+	return r.isOk();
+}
+
+// A hash of the whole machine, equal whenever the state is.  RAM is
+// hashed as it is written, so only the CPU and I/O are hashed here.
+uint64_t
+Apple2::stateHash(void)
+{
+	hashw.begin("APL2");
+	cpu.saveState(hashw);
+	saveStall(hashw);
+
+	return applehw.stateHash(hashw);
+}
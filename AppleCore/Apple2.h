@@ -28,22 +28,47 @@
 #ifndef __APPLE2_H__
 #define __APPLE2_H__
 
+#include <functional>
+
 #include "Cpu6502.h"
 #include "Apple2Video.h"
 #include "Apple2Hw.h"
+#include "SaveState.h"
 
 class Apple2Disk2;
 
+// Input events, as reported to the input callback and replayed by
+// input().
+#define APPLE_INPUT_KEY		0	// a=key
+#define APPLE_INPUT_PADDLE	1	// a=paddle b=position as float bits
+#define APPLE_INPUT_BUTTON	2	// a=button b=pressed
+#define APPLE_INPUT_RESET	3
+#define APPLE_INPUT_RESTART	4
+
+// Clocks a fast disk sector read or write takes.  Spinning to a sector
+// takes 13000 on average.
+#define APPLE_FASTDISK_CLOCKS	1000
+
 class Apple2 {
 private:
 	Cpu6502		cpu;
 	Apple2Hw	applehw;
+	StateWriter	hashw;
+	int		fastdisk;	// clocks per sector, or 0 if off
+	int		stall;		// clocks left of a fast disk access
 
+	std::function<void (int, int, int)> input_cb;
+
+	bool		rwtsTrap(void);
+	void		saveStall(StateWriter &w);
 public:
 	Apple2(Apple2Video *video = 0)
 		: cpu(&applehw),
 		  applehw(&cpu, video)
-	{  }
+	{
+		fastdisk = 0;
+		stall = 0;
+	}
 	void		reset(void);
 	void		restart(void);
 	bool		cycle(void);
@@ -57,16 +82,46 @@ public:
 	void		setRom(uint16_t addr, const uint8_t *data,
 			int length)
 	{ applehw.setRom(addr, data, length); }
+	void		setRom(uint16_t addr, ImageRef image, size_t offset,
+			       int length)
+	{ applehw.setRom(addr, image, offset, length); }
 	void		setkey(uint8_t d8)
-	{ applehw.setkey(d8); }
-	void		setPaddle(int n, float val)
-	{ applehw.setPaddle(n, val); }
+	{
+		applehw.setkey(d8);
+		if (input_cb)
+			input_cb(APPLE_INPUT_KEY, d8, 0);
+	}
+	void		setPaddle(int n, float val);
 	void		setButton(int n, bool flag)
-	{ applehw.setButton(n, flag); }
+	{
+		applehw.setButton(n, flag);
+		if (input_cb)
+			input_cb(APPLE_INPUT_BUTTON, n, flag);
+	}
+	void		input(int type, int a, int b);
+	void		setInputCallback(std::function<void (int, int, int)>
+					 _cb)
+	{ this->input_cb = _cb; }
+	void		setAudioRing(AudioRing *ring)
+	{ applehw.setAudioRing(ring); }
 	Cpu6502		*getCpu(void)
 	{ return &cpu; }
+	DirtyPages	*getDirtyPages(void)
+	{ return applehw.getDirtyPages(); }
 	Apple2Disk2	*getDisk(void)
 	{ return applehw.getDisk(); }
+	// Catch DOS 3.3 reading and writing sectors of a sector image and
+	// do it directly.  Anything else goes to the disk controller.
+	void		setFastDisk(bool flag,
+				    int clocks = APPLE_FASTDISK_CLOCKS)
+	{ fastdisk = flag ? clocks : 0; }
+
+	void		saveState(StateWriter &w);
+	bool		loadState(StateReader &r);
+	uint64_t	stateHash(void);
+	// ROMs loaded, for telling apart states that need different ones.
+	uint64_t	romHash(void) const
+	{ return applehw.romHash(); }
 };
 
 #endif // __APPLE2_H__
@@ -24,8 +24,10 @@
 //
 
 #include <stdint.h>
+#include <string.h>
 
 #include "Apple2Disk2.h"
+#include "SaveState.h"
 
 #ifdef DEBUGIO
 extern unsigned int cycles;
@@ -45,7 +47,305 @@ extern unsigned int cycles;
 #define Q7L		0x0e
 #define Q7H		0x0f
 
-#define TRACK_SIZE	6656
+// 6-and-2 disk nibbles.
+static const uint8_t sixTwo[] = {
+	0x96, 0x97, 0x9a, 0x9b, 0x9d, 0x9e, 0x9f, 0xa6,
+	0xa7, 0xab, 0xac, 0xad, 0xae, 0xaf, 0xb2, 0xb3,
+	0xb4, 0xb5, 0xb6, 0xb7, 0xb9, 0xba, 0xbb, 0xbc,
+	0xbd, 0xbe, 0xbf, 0xcb, 0xcd, 0xce, 0xcf, 0xd3,
+	0xd6, 0xd7, 0xd9, 0xda, 0xdb, 0xdc, 0xdd, 0xde,
+	0xdf, 0xe5, 0xe6, 0xe7, 0xe9, 0xea, 0xeb, 0xec,
+	0xed, 0xee, 0xef, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6,
+	0xf7, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+};
+
+// Where each physical sector is in the image file.
+static const uint8_t dosSkew[] = {
+	0, 7, 14, 6, 13, 5, 12, 4, 11, 3, 10, 2, 9, 1, 8, 15
+};
+static const uint8_t prodosSkew[] = {
+	0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15
+};
+
+// Physical sector of each DOS 3.3 sector number.
+static const uint8_t dosPhys[] = {
+	0, 13, 11, 9, 7, 5, 3, 1, 14, 12, 10, 8, 6, 4, 2, 15
+};
+
+void
+Apple2Disk2::setImage(ImageRef _image, int _format)
+{
+	DPRINTF(1, "Apple2Disk2::%s: format=%d\n", __func__, _format);
+
+	image.set(_image);
+	format = _format;
+	if (format == DISK2_NIB)
+		ntracks = image.getSize() / DISK2_TRACK_SIZE;
+	else
+		ntracks = image.getSize() / DISK2_TRACK_BYTES;
+	if (ntracks > DISK2_N_TRACKS)
+		ntracks = DISK2_N_TRACKS;
+
+	for (int trk = 0; trk < DISK2_N_TRACKS; trk++) {
+		std::vector<uint8_t>().swap(tracks[trk]);
+		dirty[trk] = false;
+	}
+	trackdata = nullptr;
+	modified = false;
+}
+
+// Look up the nibbles under the head, encoding them if need be.  Past
+// the last track there is nothing but sync.
+void
+Apple2Disk2::seek(void)
+{
+	static const std::vector<uint8_t> blank(DISK2_TRACK_SIZE, 0xff);
+
+	if (track >= ntracks)
+		trackdata = blank.data();
+	else if (format == DISK2_NIB)
+		trackdata = image.getData() + track * DISK2_TRACK_SIZE;
+	else {
+		if (tracks[track].empty())
+			nibblize(track);
+		trackdata = tracks[track].data();
+	}
+}
+
+// Nibbles under the head to write to, or null if there is no track.
+uint8_t *
+Apple2Disk2::editTrack(void)
+{
+	uint8_t *p;
+
+	if (track >= ntracks)
+		return nullptr;
+
+	if (format == DISK2_NIB)
+		p = image.edit() + track * DISK2_TRACK_SIZE;
+	else {
+		if (tracks[track].empty())
+			nibblize(track);
+		p = tracks[track].data();
+		dirty[track] = true;
+	}
+
+	trackdata = p;
+	modified = true;
+	return p;
+}
+
+// Encode a track of sectors the way DOS 3.3 formats it.
+void
+Apple2Disk2::nibblize(int trk)
+{
+	DPRINTF(2, "Apple2Disk2::%s: trk=%d\n", __func__, trk);
+
+	const uint8_t *skew = format == DISK2_PRODOS ? prodosSkew : dosSkew;
+	std::vector<uint8_t> &nibs = tracks[trk];
+	int i;
+
+	nibs.assign(DISK2_TRACK_SIZE, 0xff);
+	uint8_t *p = nibs.data();
+
+	for (int sec = 0; sec < DISK2_N_SECS; sec++) {
+		const uint8_t *data = image.getData() +
+			trk * DISK2_TRACK_BYTES + skew[sec] * 256;
+
+		// Sync bytes
+		p += 20;
+
+		// Addr field prologue
+		*p++ = 0xd5;
+		*p++ = 0xaa;
+		*p++ = 0x96;
+
+		// Volume, track, sec, checksum
+		*p++ = 0xaa | (DISK2_VOLUME >> 1);
+		*p++ = 0xaa | DISK2_VOLUME;
+		*p++ = 0xaa | (trk >> 1);
+		*p++ = 0xaa | trk;
+		*p++ = 0xaa | (sec >> 1);
+		*p++ = 0xaa | sec;
+		*p++ = 0xaa | ((DISK2_VOLUME ^ trk ^ sec) >> 1);
+		*p++ = 0xaa | (DISK2_VOLUME ^ trk ^ sec);
+
+		// Addr field epilogue.
+		*p++ = 0xde;
+		*p++ = 0xaa;
+		*p++ = 0xeb;
+
+		// Sync bytes
+		p += 20;
+
+		// Data field prologue
+		*p++ = 0xd5;
+		*p++ = 0xaa;
+		*p++ = 0xad;
+
+		// Prenibblize: the low two bits of bytes i, i + 86 and
+		// i + 172, then the high six bits of every byte.  Like
+		// DOS 3.3, the last two aux bytes wrap around to take
+		// the low bits of bytes 0 and 1 a second time.
+		uint8_t prenib[342];
+		for (i = 0; i < 86; i++) {
+			uint8_t aux = 0;
+			for (int b = i, sh = 0; sh < 6; b += 86, sh += 2)
+				aux |= (((data[b & 0xff] & 0x02) >> 1) |
+					((data[b & 0xff] & 0x01) << 1)) << sh;
+			prenib[i] = aux;
+		}
+		for (i = 0; i < 256; i++)
+			prenib[86 + i] = data[i] >> 2;
+
+		// Encode nibbilized data.
+		uint8_t prev = 0;
+		for (i = 0; i < 342; i++) {
+			*p++ = sixTwo[prev ^ prenib[i]];
+			prev = prenib[i];
+		}
+		*p++ = sixTwo[prev];
+
+		// Data field epilogue
+		*p++ = 0xde;
+		*p++ = 0xaa;
+		*p++ = 0xeb;
+	}
+}
+
+// Find the sectors on a written track and put them back in the image.
+// A sector that doesn't read back cleanly keeps what it had.
+void
+Apple2Disk2::denibblize(int trk)
+{
+	DPRINTF(2, "Apple2Disk2::%s: trk=%d\n", __func__, trk);
+
+	static const std::vector<uint8_t> unSixTwo = [] {
+		std::vector<uint8_t> tab(256, 0xff);
+		for (int i = 0; i < 64; i++)
+			tab[sixTwo[i]] = i;
+		return tab;
+	}();
+
+	const uint8_t *skew = format == DISK2_PRODOS ? prodosSkew : dosSkew;
+	const uint8_t *nibs = tracks[trk].data();
+	uint8_t *secs = image.edit() + trk * DISK2_TRACK_BYTES;
+
+	// Fields can wrap around the end of the track.
+	for (int start = 0; start < DISK2_TRACK_SIZE; start++) {
+		auto nib = [&] (int i) {
+			return nibs[(start + i) % DISK2_TRACK_SIZE];
+		};
+		auto fourFour = [&] (int i) {
+			return ((nib(i) << 1) | 1) & nib(i + 1);
+		};
+
+		if (nib(0) != 0xd5 || nib(1) != 0xaa || nib(2) != 0x96)
+			continue;
+		int vol = fourFour(3);
+		int t = fourFour(5);
+		int sec = fourFour(7);
+		if ((vol ^ t ^ sec) != fourFour(9) || t != trk ||
+		    sec >= DISK2_N_SECS)
+			continue;
+
+		// The data field follows within a gap.
+		int d;
+		for (d = 11; d < 11 + 64; d++)
+			if (nib(d) == 0xd5 && nib(d + 1) == 0xaa &&
+			    nib(d + 2) == 0xad)
+				break;
+		if (d == 11 + 64)
+			continue;
+		d += 3;
+
+		uint8_t prenib[342];
+		uint8_t prev = 0;
+		int i;
+		for (i = 0; i < 342; i++) {
+			uint8_t v = unSixTwo[nib(d + i)];
+			if (v == 0xff)
+				break;
+			prev ^= v;
+			prenib[i] = prev;
+		}
+		if (i < 342 || unSixTwo[nib(d + 342)] != prev) {
+			DPRINTF(1, "Apple2Disk2::%s: bad sector trk=%d "
+				"sec=%d\n", __func__, trk, sec);
+			continue;
+		}
+
+		uint8_t *data = secs + skew[sec] * 256;
+		for (i = 0; i < 256; i++) {
+			uint8_t bits = prenib[i % 86] >> (i / 86 * 2);
+			data[i] = (prenib[86 + i] << 2) |
+				((bits & 0x01) << 1) | ((bits & 0x02) >> 1);
+		}
+	}
+}
+
+// Where a DOS 3.3 sector is in a sector image, with any writes to its
+// track decoded first.  Null if there is no such sector.
+const uint8_t *
+Apple2Disk2::sector(int trk, int sec)
+{
+	if (format == DISK2_NIB || trk < 0 || trk >= ntracks || sec < 0 ||
+	    sec >= DISK2_N_SECS)
+		return nullptr;
+
+	if (dirty[trk]) {
+		denibblize(trk);
+		dirty[trk] = false;
+	}
+
+	if (format == DISK2_PRODOS)
+		sec = prodosSkew[dosPhys[sec]];
+	return image.getData() + trk * DISK2_TRACK_BYTES + sec * 256;
+}
+
+bool
+Apple2Disk2::readSector(int trk, int sec, uint8_t *data)
+{
+	const uint8_t *p = sector(trk, sec);
+
+	if (!p)
+		return false;
+	memcpy(data, p, 256);
+
+	return true;
+}
+
+// The track's nibbles are dropped to be encoded again from the sectors.
+bool
+Apple2Disk2::writeSector(int trk, int sec, const uint8_t *data)
+{
+	const uint8_t *p = sector(trk, sec);
+
+	if (!p || writeprot)
+		return false;
+	size_t off = p - image.getData();
+	memcpy(image.edit() + off, data, 256);
+
+	std::vector<uint8_t>().swap(tracks[trk]);
+	if (trk == track)
+		trackdata = nullptr;
+	modified = true;
+
+	return true;
+}
+
+const uint8_t *
+Apple2Disk2::getData(void)
+{
+	if (format != DISK2_NIB)
+		for (int trk = 0; trk < ntracks; trk++)
+			if (dirty[trk]) {
+				denibblize(trk);
+				dirty[trk] = false;
+			}
+
+	return image.getData();
+}
 
 // Perform actions that are side-effects of either read or write.
 void
@@ -60,8 +360,9 @@ Apple2Disk2::reference(uint16_t addr)
 				// Ascending order, track arm moves inward.
 				phase = p;
 				if ((phase & 1) == 0) {
-					if (++track >= 35)
-						track = 35;
+					if (++track >= DISK2_N_TRACKS)
+						track = DISK2_N_TRACKS;
+					trackdata = nullptr;
 					DPRINTF(2, "Apple2Disk2::%s: trk=%d\n",
 						__func__, track);
 				}
@@ -71,6 +372,7 @@ Apple2Disk2::reference(uint16_t addr)
 				if ((phase & 1) == 0) {
 					if (--track < 0)
 						track = 0; // CLICK! CLICK!
+					trackdata = nullptr;
 					DPRINTF(2, "Apple2Disk2::%s: trk=%d\n",
 						__func__, track);
 				}
@@ -105,14 +407,14 @@ Apple2Disk2::reference(uint16_t addr)
 		case Q6L:
 			q6 = false;
 			// Strobe data latch for I/O
-			if (nibfile && motor && !drv1) {
-				if (++offset == TRACK_SIZE)
+			if (haveImage() && motor && !drv1) {
+				if (++offset == DISK2_TRACK_SIZE)
 					offset = 0;
 				if (q7 && !writeprot) {
 					// Write to disk.
-					nibfile[track * TRACK_SIZE + offset] =
-						data_latch;
-					nibmodified = true;
+					uint8_t *p = editTrack();
+					if (p)
+						p[offset] = data_latch;
 				}
 			}
 			break;
@@ -149,10 +451,12 @@ Apple2Disk2::read(uint16_t addr)
 
 	reference(addr);
 
-	if (addr == Q6L && nibfile && motor && !drv1 && !q7)
+	if (addr == Q6L && haveImage() && motor && !drv1 && !q7) {
 		// Read from disk.
-		d8 = nibfile[track * TRACK_SIZE + offset];
-	else if (addr == Q7L && q6)
+		if (!trackdata)
+			seek();
+		d8 = trackdata[offset];
+	} else if (addr == Q7L && q6)
 		// Sense write protect.
 		d8 = writeprot ? 0x80 : 0x00;
 
@@ -168,12 +472,58 @@ Apple2Disk2::reset(void)
 
 	phase = 0;
 	track = 20;
+	trackdata = nullptr;
 	motor = false;
 	drv1 = false;
 	offset = 0;
+	data_latch = 0;
 	q6 = false;
 	q7 = false;
 
 	if (disk_cb)
 		disk_cb(motor, track);
 }
+
+// Head, latch and drive select.  The disk image and its write protect
+// tab are media and not saved.
+void
+Apple2Disk2::saveState(StateWriter &w)
+{
+	w.beginChunk("DSK2");
+	w.putInt(track);
+	w.put8(phase);
+	w.put8(data_latch);
+	w.putBool(motor);
+	w.putBool(drv1);
+	w.putBool(q6);
+	w.putBool(q7);
+	w.putInt(offset);
+	w.endChunk();
+}
+
+void
+Apple2Disk2::loadState(StateReader &r)
+{
+	if (!r.openChunk("DSK2"))
+		return;
+	track = r.getInt();
+	phase = r.get8();
+	data_latch = r.get8();
+	motor = r.getBool();
+	drv1 = r.getBool();
+	q6 = r.getBool();
+	q7 = r.getBool();
+	offset = r.getInt();
+	r.endChunk();
+
+	trackdata = nullptr;
+	if (track < 0 || track > DISK2_N_TRACKS || offset < 0 ||
+	    offset >= DISK2_TRACK_SIZE) {
+		r.fail();
+		reset();
+		return;
+	}
+
+	if (disk_cb)
+		disk_cb(motor, track);
+}
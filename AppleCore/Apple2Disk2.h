@@ -27,12 +27,36 @@
 #define __APPLE2DISK2_H__
 
 #include <functional>
+#include <vector>
+
+#include "Image.h"
+
+class StateWriter;
+class StateReader;
+
+#define DISK2_N_TRACKS		35
+#define DISK2_N_SECS		16
+#define DISK2_TRACK_SIZE	6656	// nibbles per track
+#define DISK2_TRACK_BYTES	4096	// sector bytes per track
+#define DISK2_VOLUME		254
+
+// Disk image formats.
+#define DISK2_NIB		0	// nibbles as the head sees them
+#define DISK2_DOS		1	// sectors in DOS 3.3 order (.dsk, .do)
+#define DISK2_PRODOS		2	// sectors in ProDOS order (.po)
 
 class Apple2Disk2 {
 private:
-	uint8_t *nibfile;
+	CowImage image;		// shared until written
+	int	format;
+	int	ntracks;
+	// Sector images are nibblized a track at a time as the head
+	// first reads it.  Written tracks go back to sectors on getData().
+	std::vector<uint8_t> tracks[DISK2_N_TRACKS];
+	bool	dirty[DISK2_N_TRACKS];
+	const uint8_t *trackdata; // under the head, null until looked up
 	bool	writeprot;
-	bool	nibmodified;
+	bool	modified;
 	int	track;
 	uint8_t	phase;
 	uint8_t	data_latch;
@@ -44,29 +68,49 @@ private:
 	std::function<void (bool, int)> disk_cb;
 
 	void	reference(uint16_t addr);
+	void	seek(void);
+	uint8_t	*editTrack(void);
+	void	nibblize(int trk);
+	void	denibblize(int trk);
+	const uint8_t *sector(int trk, int sec);
 public:
 	Apple2Disk2()
 	{
-		nibfile = nullptr;
+		format = DISK2_NIB;
+		ntracks = 0;
+		trackdata = nullptr;
 		writeprot = false;
-		nibmodified = false;
+		modified = false;
 	}
 	void	write(uint16_t addr, uint8_t d8);
 	uint8_t	read(uint16_t addr);
 	void	reset(void);
-	void	setNib(uint8_t *_nibfile)
-	{
-		nibfile = _nibfile;
-		nibmodified = false;
-	}
-	bool	haveNib(void)
-	{ return nibfile != nullptr; }
+	void	saveState(StateWriter &w);
+	void	loadState(StateReader &r);
+	void	setImage(ImageRef image, int format = DISK2_NIB);
+	// What the disk holds now, written or not, in the format it was
+	// loaded in.
+	const uint8_t *getData(void);
+	size_t	getSize(void) const
+	{ return image.getSize(); }
+	int	getFormat(void) const
+	{ return format; }
+	bool	haveImage(void)
+	{ return image.getData() != nullptr; }
+	// Sectors by DOS 3.3 number, bypassing the nibbles.  Sector
+	// images only.
+	bool	readSector(int trk, int sec, uint8_t *data);
+	bool	writeSector(int trk, int sec, const uint8_t *data);
 	void	setWriteProt(bool flag)
 	{ writeprot = flag; }
+	bool	isWriteProt(void)
+	{ return writeprot; }
 	void	setDiskCallback(std::function<void (bool, int)> _cb)
 	{ disk_cb = _cb; }
-	bool	nibModified(void)
-	{ return nibmodified; }
+	bool	isModified(void)
+	{ return modified; }
+	bool	isMotorOn(void)
+	{ return motor; }
 };
 
 #endif // __APPLE2DISK2_H__
@@ -30,6 +30,7 @@
 #include "Apple2Hw.h"
 
 #include "Apple2Video.h"
+#include "SaveState.h"
 
 #define IO_ADDR		0xc000
 #define IO_SIZE		0x0800
@@ -46,8 +47,17 @@ Apple2Hw::Apple2Hw(Cpu6502 *cpu, Apple2Video *video)
 {
 	this->video = video;
 
-	for (int i = 0; i < ROM_SIZE; i++)
-		rom[i] = apple2Rom[i];
+	static ImageRef builtin = Image::wrap(apple2Rom, ROM_SIZE);
+
+	rom.set(0, builtin, 0, ROM_SIZE);
+	for (int i = 0; i < RAM_SIZE; i++)
+		ram[i] = 0xaa;
+	ramhash.rehash(ram, RAM_SIZE);
+
+	// RAM and ROM only change through write paths.
+	dirty.setTracked(0, RAM_SIZE >> DIRTY_PAGE_SHIFT);
+	dirty.setTracked(ROM_ADDR >> DIRTY_PAGE_SHIFT,
+			 ROM_SIZE >> DIRTY_PAGE_SHIFT);
 }
 
 void
@@ -61,6 +71,12 @@ Apple2Hw::restart(void)
 {
 	for (int i = 0; i < RAM_SIZE; i++)
 		ram[i] = 0xaa;
+	dirty.markAll();
+	ramhash.rehash(ram, RAM_SIZE);
+	// The renderer keeps its own copy of video RAM.
+	if (video)
+		for (int i = 0; i < RAM_SIZE; i++)
+			video->write(i, ram[i]);
 	reset();
 }
 
@@ -80,18 +96,69 @@ Apple2Hw::readRam(uint16_t addr, uint8_t *data, int len)
 void
 Apple2Hw::writeRam(uint16_t addr, const uint8_t *data, int len)
 {
-	for (int i = 0; i < len; i++)
+	for (int i = 0; i < len; i++) {
+		ramhash.write(addr + i, ram[addr + i], data[i]);
 		ram[addr + i] = data[i];
+	}
+	dirty.markRange(addr, len);
 }
 
+// Replace ROM with a copy of data.
 void
 Apple2Hw::setRom(uint16_t addr, const uint8_t *data, int len)
+{
+	setRom(addr, Image::copy(data, len), 0, len);
+}
+
+// Map ROM onto part of an image, which is shared, not copied.
+void
+Apple2Hw::setRom(uint16_t addr, ImageRef image, size_t offset, int len)
 {
 	if (addr < ROM_ADDR || (int)addr + len > ROM_ADDR + ROM_SIZE)
 		return;
 
-	for (int i = 0; i < len; i++)
-		rom[addr - ROM_ADDR + i] = data[i];
+	rom.set(addr - ROM_ADDR, image, offset, len);
+	dirty.markRange(addr, len);
+}
+
+// RAM, then I/O and video.  ROM is loaded media and not saved.
+void
+Apple2Hw::saveState(StateWriter &w)
+{
+	w.beginChunk("AHW ");
+	w.putRam(ram, RAM_SIZE, 0);
+	w.endChunk();
+
+	io.saveState(w);
+	if (video)
+		video->saveState(w);
+}
+
+void
+Apple2Hw::loadState(StateReader &r)
+{
+	if (!r.openChunk("AHW "))
+		return;
+	r.getRam(ram, RAM_SIZE);
+	r.endChunk();
+	dirty.markAll();
+	ramhash.rehash(ram, RAM_SIZE);
+
+	io.loadState(r);
+	if (video)
+		video->loadState(r);
+}
+
+// The RAM hash kept up on writes, and a hash of the rest of the state
+// added on to w.
+uint64_t
+Apple2Hw::stateHash(StateWriter &w)
+{
+	io.saveState(w);
+	if (video)
+		video->saveState(w);
+
+	return ramhash.get() ^ hashBytes(w.getData(), w.getSize());
 }
 
 /////////////////////// MemSpace interface to cpu6502 //////////////////////
@@ -102,7 +169,7 @@ Apple2Hw::read(uint16_t addr)
 	if (addr < RAM_SIZE)
 		return ram[addr];
 	else if (addr >= ROM_ADDR && addr < ROM_ADDR + ROM_SIZE)
-		return rom[addr - ROM_ADDR];
+		return rom.read(addr - ROM_ADDR);
 	else if (addr >= IO_ADDR && addr < IO_ADDR + IO_SIZE)
 		return io.read(addr - IO_ADDR);
 
@@ -113,7 +180,9 @@ void
 Apple2Hw::write(uint16_t addr, uint8_t d8)
 {
 	if (addr < RAM_SIZE) {
+		ramhash.write(addr, ram[addr], d8);
 		ram[addr] = d8;
+		dirty.mark(addr);
 		if (video)
 			video->write(addr, d8);
 	} else if (addr >= IO_ADDR && addr < IO_ADDR + IO_SIZE)
@@ -29,11 +29,16 @@
 #define __APPLE2HW_H__
 
 #include "MemSpace.h"
+#include "DirtyPages.h"
+#include "StateHash.h"
+#include "Image.h"
 #include "Apple2Io.h"
 
 class Cpu6502;
 class Apple2Video;
 class Apple2Disk2;
+class StateWriter;
+class StateReader;
 
 #define RAM_SIZE	0xc000	// 48K
 #define ROM_SIZE	0x3000	// 12K
@@ -43,7 +48,9 @@ private:
 	Apple2Io	io;
 	Apple2Video	*video;
 	uint8_t		ram[RAM_SIZE];
-	uint8_t		rom[ROM_SIZE];
+	RomPages<(ROM_SIZE >> ROM_PAGE_SHIFT)> rom;	// shared images
+	DirtyPages	dirty;
+	RamHash		ramhash;
 
 public:
 	Apple2Hw(Cpu6502 *, Apple2Video *);
@@ -62,14 +69,24 @@ public:
 	void 	writeRam(uint16_t addr, const uint8_t *data, int len);
 	void 	readRam(uint16_t addr, uint8_t *data, int len);
 	void	setRom(uint16_t addr, const uint8_t *data, int len);
+	void	setRom(uint16_t addr, ImageRef image, size_t offset, int len);
 	void 	setkey(uint8_t d8)
 	{ io.setkey(d8); }
 	void	setPaddle(int n, float val)
 	{ io.setPaddle(n, val); }
 	void	setButton(int n, bool flag)
 	{ io.setButton(n, flag); }
+	void	setAudioRing(AudioRing *ring)
+	{ io.setAudioRing(ring); }
 	Apple2Disk2 *getDisk(void)
 	{ return io.getDisk(); }
+	DirtyPages *getDirtyPages(void)
+	{ return &dirty; }
+	void	saveState(StateWriter &w);
+	void	loadState(StateReader &r);
+	uint64_t stateHash(StateWriter &w);
+	uint64_t romHash(void) const
+	{ return rom.hash(); }
 };
 
 #endif // __APPLE2HW_H__
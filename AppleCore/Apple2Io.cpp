@@ -33,6 +33,7 @@
 #include "Cpu6502.h"
 #include "Apple2Video.h"
 #include "Apple2Disk2.h"
+#include "SaveState.h"
 
 #ifdef DEBUGIO
 extern unsigned int cycles;
@@ -72,6 +73,10 @@ extern unsigned int cycles;
 #define IO_GC3_ADDR		0x0007
 #define IO_GCSTRB_ADDR		0x0070
 
+#define FRAME_CLOCKS	APPLE_FRAME_CLOCKS
+#define SPKR_AMPLITUDE	12000	// sound sample level of a toggle
+#define SPKR_CUTOFF	20.0	// Hz, speaker decays to rest position
+
 extern const uint8_t disk2Rom[];
 
 void
@@ -80,8 +85,15 @@ Apple2Io::reset(void)
 	DPRINTF(1, "Apple2Io::%s:\n", __func__);
 
 	keycode = 0;
+	for (int i = 0; i < 4; i++)
+		paddlecount[i] = 0;
 	paddlemask = 0;
 	disk.reset();
+
+	spkr = false;
+	frame_clk = 0;
+	sound.reset();
+	sound.setDcCutoff(SPKR_CUTOFF);
 }
 
 void
@@ -116,6 +128,11 @@ Apple2Io::reference(uint16_t addr)
 	case IO_KEYCLR_ADDR:
 		keycode &= 0x7f;
 		break;
+	case IO_SPKROUT_ADDR:
+		// Toggle speaker.  Just timestamp it within the frame.
+		spkr = !spkr;
+		sound.addTransition(frame_clk, spkr ? SPKR_AMPLITUDE : 0);
+		break;
 	case IO_GRFX_ADDR:
 		switch (addr & IO_GRFX_MASK) {
 		case IO_GRFX_MODE_ADDR:
@@ -148,7 +165,7 @@ Apple2Io::read(uint16_t addr)
 
 	if ((addr & IO_PROM_MASK) != 0)
 		// Device PROMS.
-		if (IO_PROM_SLOT(addr) == 6 && disk.haveNib())
+		if (IO_PROM_SLOT(addr) == 6 && disk.haveImage())
 			d8 = disk2Rom[addr & 0xff];
 		else
 			d8 = 0xff;
@@ -215,9 +232,56 @@ Apple2Io::write(uint16_t addr, uint8_t d8)
 void
 Apple2Io::cycle(void)
 {
+	if (++frame_clk == FRAME_CLOCKS) {
+		sound.endFrame(frame_clk);
+		video->vsync();
+		frame_clk = 0;
+	}
+
 	if (paddlemask != 0) {
 		for (int i = 0; i < 4; i++)
 			if (paddlecount[i] == 0 || --paddlecount[i] == 0)
 				paddlemask &= ~(1 << i);
 	}
 }
+
+void
+Apple2Io::saveState(StateWriter &w)
+{
+	w.beginChunk("AIO ");
+	w.put8(keycode);
+	for (int i = 0; i < 3; i++)
+		w.putBool(button[i]);
+	for (int i = 0; i < 4; i++) {
+		w.put16(paddle[i]);
+		w.put16(paddlecount[i]);
+	}
+	w.put8(paddlemask);
+	w.putBool(spkr);
+	w.putInt(frame_clk);
+	w.endChunk();
+
+	disk.saveState(w);
+}
+
+void
+Apple2Io::loadState(StateReader &r)
+{
+	if (!r.openChunk("AIO "))
+		return;
+	keycode = r.get8();
+	for (int i = 0; i < 3; i++)
+		button[i] = r.getBool();
+	for (int i = 0; i < 4; i++) {
+		paddle[i] = r.get16();
+		paddlecount[i] = r.get16();
+	}
+	paddlemask = r.get8();
+	spkr = r.getBool();
+	frame_clk = r.getInt();
+	r.endChunk();
+
+	sound.seek(frame_clk, spkr ? SPKR_AMPLITUDE : 0);
+
+	disk.loadState(r);
+}
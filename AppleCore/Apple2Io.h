@@ -30,9 +30,16 @@
 
 #include "MemSpace.h"
 #include "Apple2Disk2.h"
+#include "BlepSynth.h"
 
 class Cpu6502;
 class Apple2Video;
+class AudioRing;
+class StateWriter;
+class StateReader;
+
+#define APPLE_CLOCK_RATE	1020484		// Hz
+#define APPLE_FRAME_CLOCKS	17030		// clocks per frame (65 x 262)
 
 class Apple2Io : MemSpace {
 private:
@@ -44,13 +51,21 @@ private:
 	short		paddle[4];
 	short		paddlecount[4];
 	uint8_t		paddlemask;
+	BlepSynth	sound;
+	bool		spkr;		// speaker cone position
+	int		frame_clk;	// clocks into current video frame
 
 	void reference(uint16_t addr);
 public:
 	Apple2Io(Cpu6502 *cpu, Apple2Video *video)
 		: cpu(cpu),
-		  video(video)
+		  video(video),
+		  sound(APPLE_CLOCK_RATE)
 	{
+		for (int i = 0; i < 3; i++)
+			button[i] = false;
+		for (int i = 0; i < 4; i++)
+			paddle[i] = 0;
 		reset();
 		disk.reset();
 	}
@@ -64,6 +79,11 @@ public:
 	void setButton(int n, bool flag);
 	void reset(void);
 	void cycle(void);
+	void saveState(StateWriter &w);
+	void loadState(StateReader &r);
+
+	void setAudioRing(AudioRing *ring)
+	{ sound.setRing(ring); }
 
 	Apple2Disk2 *getDisk(void)
 	{ return &disk; }
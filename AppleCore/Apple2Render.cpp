@@ -0,0 +1,523 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Apple2Render.cpp
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Apple2Render.h"
+#include "SaveState.h"
+
+#ifdef DEBUGVID
+extern unsigned int cycles;
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGVID) printf("[%d] " f, cycles, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+extern const uint8_t apple2CharRom[];
+
+#define TEXT0_ADDR	0x400
+#define TEXT1_ADDR	0x800
+#define TEXT_SIZE	0x400
+#define HIRES0_ADDR	0x2000
+#define HIRES1_ADDR	0x4000
+#define HIRES_SIZE	0x2000
+
+#define FLASH_FRAMES	14	// frames between flash toggles (~230ms)
+
+// Palette indices
+#define COLOR_BLACK	0
+#define COLOR_WHITE	15
+#define COLOR_GREY1	16
+#define COLOR_GREY2	17
+
+// RGB colors for LORES and HIRES graphics.  Posted on comp.emulators.apple2,
+// Thanks, Robert Munafo, https://mrob.com/pub/xapple2/colors.html
+//
+static const uint8_t loresrgb[][3] =
+	{{0, 0, 0},     {227, 30, 96},   {96, 78, 189},   {255, 68, 253},
+	 {0, 163, 96},  {156, 156, 156}, {20, 207, 253},  {208, 195, 255},
+	 {96, 114, 3},  {255, 106, 60},  {156, 156, 156}, {255, 160, 208},
+	 {20, 245, 60}, {208, 221, 141}, {114, 255, 208}, {255, 255, 255}};
+
+// The HIRES colors are all LORES colors: black, green, violet, white,
+// black, orange, blue, white.
+static const uint8_t hirescolor[] = { 0, 12, 3, 15, 0, 9, 6, 15 };
+
+static const uint8_t greycolor[] =
+	{ COLOR_BLACK, COLOR_GREY1, COLOR_GREY2, COLOR_WHITE };
+
+Apple2Render::Apple2Render()
+	: fb(APPLE_NATIVE_WIDTH, APPLE_NATIVE_HEIGHT)
+{
+	DPRINTF(1, "Apple2Render::%s:\n", __func__);
+
+	for (int i = 0; i < 16; i++)
+		fb.setPalette(i, loresrgb[i][0], loresrgb[i][1],
+			      loresrgb[i][2]);
+	fb.setPalette(COLOR_GREY1, 85, 85, 85);
+	fb.setPalette(COLOR_GREY2, 171, 171, 171);
+
+	flashing = true;
+
+	// Same as the RAM Apple2Hw powers up with.
+	memset(vidmem, 0xaa, APPLE_VIDMEM_SIZE);
+
+	reset();
+}
+
+// Update frame for one byte of character memory at col, row.
+void
+Apple2Render::updateChar(int col, int row, uint8_t d8)
+{
+	DPRINTF(3, "Apple2Render::%s: col=%d row=%d d8=0x%02x\n", __func__,
+		col, row, d8);
+
+	int charoffset = 8 * ((d8 & 0x3f) ^ 0x20);
+	uint8_t pix[7];
+
+	for (int y = 0; y < 8; y++) {
+		uint8_t cdata = apple2CharRom[charoffset++];
+		if ((d8 & 0xc0) == 0 || ((d8 & 0xc0) == 0x40 && flash_on))
+			cdata ^= 0xff;
+		for (int x = 0; x < 7; x++) {
+			pix[x] = (cdata & 1) != 0 ? COLOR_WHITE : COLOR_BLACK;
+			cdata >>= 1;
+		}
+		fb.putSpan(col * 7, row * 8 + y, pix, 7);
+	}
+}
+
+// Update frame for one byte of lores memory (two blocks stacked vertically).
+void
+Apple2Render::updateLores(int col, int row, uint8_t d8)
+{
+	DPRINTF(3, "Apple2Render::%s: col=%d row=%d d8=0x%02x\n", __func__,
+		col, row, d8);
+
+	uint8_t pix[7];
+
+	for (int y = 0; y < 8; y++) {
+		uint8_t bits = y < 4 ? (d8 & 0xf) : (d8 >> 4);
+		if (color)
+			memset(pix, bits, 7);
+		else
+			for (int x = 0; x < 7; x++)
+				pix[x] = greycolor[((x + col) & 1) ?
+						   (bits & 3) : (bits >> 2)];
+		fb.putSpan(col * 7, row * 8 + y, pix, 7);
+	}
+}
+
+// hiresPixel is used by updateHires to determine the color of a hires
+// pixel based upon the state of the adjacent pixels.  The pixel in
+// question is bit 1 of pixels and the adjacent pixels are bits 2 and 0.
+// So, if bit 1 is set and either of the adjacent pixels is set, the color
+// is white.  If bit 1 is set but no adjacent pixels are set, the pixel is
+// a color depending upon if the pixel is at and odd or even location and
+// if bit 7 in the pixel's byte (d8) is set.  If both adjacent pixels are
+// set but this one is not set, the color of adjacent pixels is "bled"
+// into this pixel.  Otherwise, the pixel is black.
+//
+static uint8_t
+hiresPixel(bool odd, uint16_t pixels, uint8_t d8)
+{
+	switch (pixels & 7) {
+	case 2:	// 010: Color.
+		return hirescolor[1 + (odd ? 0 : 1) + ((d8 & 0x80) ? 4 : 0)];
+	case 5:	// 101: Other color.
+		return hirescolor[1 + (odd ? 1 : 0) + ((d8 & 0x80) ? 4 : 0)];
+	case 3:
+	case 6:
+	case 7: // 011, 110, 111: White.
+		return hirescolor[3];
+	default:// Black.
+		return hirescolor[0];
+	}
+}
+
+//
+// updateHires: update all pixels possiblly affected by a change in a hires
+// memory byte, d8.  Single pixels to the left and right of the 7
+// pixels represented by this byte are also affected so we need the
+// value of the bytes to the left (d8l) and right (d8r) of the
+// updating byte.
+void
+Apple2Render::updateHires(int col, int y, uint8_t d8l, uint8_t d8,
+			   uint8_t d8r)
+{
+	DPRINTF(4, "Apple2Render::%s: col=%d y=%d d8l/d8/d8r="
+		"0x%x,0x%x,0x%x\n", __func__, col, y, d8l, d8, d8r);
+
+	uint8_t pix[9];
+	bool odd = (col & 1) != 0;
+
+	if (color) {
+		// Concat pixels of left, center, and right bytes.
+		uint16_t pixels =
+			((d8l >> 5) & 0x03) |
+			(((uint16_t)d8 << 2) & 0x1fc) |
+			(((uint16_t)d8r << 9) & 0x600);
+
+		// Pixel just to the left of updated byte.
+		pix[0] = hiresPixel(!odd, pixels, d8l);
+		pixels >>= 1;
+
+		// Seven pixels of updated byte.
+		for (int x = 1; x < 8; x++) {
+			pix[x] = hiresPixel(odd, pixels, d8);
+			pixels >>= 1;
+			odd = !odd;
+		}
+
+		// Pixel just to the right of updated byte.
+		pix[8] = hiresPixel(odd, pixels, d8r);
+
+		if (col == 0)
+			fb.putSpan(0, y, pix + 1, col < 39 ? 8 : 7);
+		else
+			fb.putSpan(col * 7 - 1, y, pix, col < 39 ? 9 : 8);
+	} else {
+		// Monochrome.
+		for (int x = 0; x < 7; x++) {
+			pix[x] = (d8 & 1) != 0 ? COLOR_WHITE : COLOR_BLACK;
+			d8 >>= 1;
+		}
+		fb.putSpan(col * 7, y, pix, 7);
+	}
+}
+
+// Update entire frame in response to changes in graphics modes.
+void
+Apple2Render::updateAll(void)
+{
+	int row;
+	int col;
+
+	DPRINTF(2, "Apple2Render::%s:\n", __func__);
+
+	if (!fb.isActive())
+		return;
+
+	// Update Text
+	if (mix_en || !gfx_en)
+		for (row = (mix_en && gfx_en) ? 20 : 0; row < 24; row++) {
+			int offset =  ((row & 0x07) << 7) | (row & 0x18) |
+				((row & 0x18) << 2);
+			offset += page_en ? TEXT1_ADDR : TEXT0_ADDR;
+			for (col = 0; col < 40; col++, offset++)
+				updateChar(col, row, vidmem[offset]);
+		}
+
+	// Update Lores
+	if (gfx_en && !hires_en)
+		for (row = 0; row < (mix_en ? 20 :24); row++) {
+			int offset =  ((row & 0x07) << 7) | (row & 0x18) |
+				((row & 0x18) << 2);
+			offset += page_en ? TEXT1_ADDR : TEXT0_ADDR;
+			for (col = 0; col < 40; col++, offset++)
+				updateLores(col, row, vidmem[offset]);
+		}
+
+	// Update Hires
+	if (gfx_en && hires_en)
+		for (int y = 0; y < (mix_en ? 160 : 192); y++) {
+			row = y >> 3;
+			int offset =  ((row & 0x07) << 7) | (row & 0x18) |
+				((row & 0x18) << 2);
+			offset += page_en ? HIRES1_ADDR : HIRES0_ADDR;
+			offset += (y & 7) << 10;
+			for (col = 0; col < 40; col++, offset++)
+				updateHires(col, y,
+				    col == 0 ? 0 : vidmem[offset - 1],
+				    vidmem[offset],
+				    col == 39 ? 0 : vidmem[offset + 1]);
+		}
+}
+
+void
+Apple2Render::reset(void)
+{
+	DPRINTF(1, "Apple2Render::%s:\n", __func__);
+
+	gfx_en = false;
+	hires_en = false;
+	mix_en = false;
+	page_en = false;
+	color = true;
+	flash_on = true;
+	flash_frames = 0;
+}
+
+// Never called but MemSpace interface requires this.
+uint8_t
+Apple2Render::read(uint16_t addr)
+{
+	DPRINTF(4, "Apple2Render::%s addr=0x%x:\n", __func__, addr);
+
+	if (addr >= APPLE_VIDMEM_SIZE)
+		return 0xaa;
+	else
+		return vidmem[addr];
+}
+
+// Called when any memory location that might be displayed is modified.
+// Routine tries to determine as quickly as possible that write has no effect
+// on display.
+void
+Apple2Render::write(uint16_t addr, uint8_t d8)
+{
+	DPRINTF(4, "Apple2Render::%s addr=0x%x d8=0x%02x:\n", __func__,
+		addr, d8);
+
+	if (addr >= APPLE_VIDMEM_SIZE || vidmem[addr] == d8)
+		return;
+
+	vidmem[addr] = d8;
+
+	if (!fb.isActive())
+		return;
+
+	if (addr >= TEXT0_ADDR && addr < TEXT0_ADDR + 2 * TEXT_SIZE) {
+		// TEXT or LORES graphics memory.
+		if ((addr < TEXT1_ADDR && page_en) ||
+		    (addr >= TEXT1_ADDR && !page_en))
+			return;
+		if (gfx_en && hires_en && !mix_en)
+			return;
+
+		int col = (addr & 0x07f);
+		int row = (addr & 0x380) >> 7;
+
+		if (col < 40)
+			;
+		else if (col < 80) {
+			row += 8;
+			col -= 40;
+		} else if (col < 120) {
+			row += 16;
+			col -= 80;
+		} else
+			return;
+
+		if (gfx_en && hires_en && row < 20)
+			return; // hidden by hires
+		else if (gfx_en && (!mix_en || row < 20)) {
+			// LORES graphics
+			updateLores(col, row, d8);
+		} else {
+			// TEXT mode
+			updateChar(col, row, d8);
+		}
+	} else if (addr >= HIRES0_ADDR && addr < HIRES0_ADDR +
+		   2 * HIRES_SIZE) {
+		// HIRES memory
+		if (!hires_en || !gfx_en)
+			return;
+		if ((addr < HIRES1_ADDR && page_en) ||
+		    (addr >= HIRES1_ADDR && !page_en))
+			return;
+
+		int col = (addr & 0x07f);
+		int y = ((addr & 0x380) >> 4) | ((addr & 0x1c00) >> 10);
+
+		if (col < 40)
+			;
+		else if (col < 80) {
+			y += 0x40;
+			col -= 40;
+		} else if (col < 120) {
+			y += 0x80;
+			col -= 80;
+		} else
+			return;
+
+		// Hidden by text in mix-mode?
+		if (y >= 160 && mix_en)
+			return;
+
+		updateHires(col, y, col == 0 ? 0 : vidmem[addr - 1],
+			    vidmem[addr],
+			    col == 39 ? 0 : vidmem[addr + 1]);
+	}
+}
+
+void
+Apple2Render::setGfx(bool gfx)
+{
+	DPRINTF(2, "Apple2Render::%s: gfx=%d\n", __func__, gfx);
+
+	if (gfx != gfx_en) {
+		gfx_en = gfx;
+		updateAll();
+	}
+}
+
+void
+Apple2Render::setHires(bool hires)
+{
+	DPRINTF(2, "Apple2Render::%s: hires=%d\n", __func__, hires);
+
+	if (hires != hires_en) {
+		hires_en = hires;
+		updateAll();
+	}
+}
+
+void
+Apple2Render::setMix(bool mix)
+{
+	DPRINTF(2, "Apple2Render::%s: mix=%d\n", __func__, mix);
+
+	if (mix != mix_en) {
+		mix_en = mix;
+		updateAll();
+	}
+}
+
+void
+Apple2Render::setPage(bool page)
+{
+	DPRINTF(2, "Apple2Render::%s: page=%d\n", __func__, page);
+
+	if (page != page_en) {
+		page_en = page;
+		updateAll();
+	}
+}
+
+// Redraw all character locations with flash bit set.
+void
+Apple2Render::updateFlash(void)
+{
+	DPRINTF(3, "Apple2Render::%s: flash_on=%d\n", __func__, flash_on);
+
+	// Full graphics mode, nothing to do.
+	if (gfx_en && !mix_en)
+		return;
+
+	for (int row = gfx_en ? 20 : 0; row < 24; row++) {
+		int offset = (page_en ? TEXT1_ADDR : TEXT0_ADDR) |
+			(((row & 0x07) << 7) | (row & 0x18) |
+			 ((row & 0x18) << 2));
+		for (int col = 0; col < 40; col++, offset++)
+			if ((vidmem[offset] & 0xc0) == 0x40)
+				updateChar(col, row, vidmem[offset]);
+	}
+}
+
+// Called once per video frame.  Flashing characters are timed from here.
+void
+Apple2Render::vsync(void)
+{
+	// Flash timing is state and keeps going without a buffer.
+	if (flashing && ++flash_frames >= FLASH_FRAMES) {
+		flash_frames = 0;
+		flash_on = !flash_on;
+		if (fb.isActive())
+			updateFlash();
+	}
+
+	if (fb.isActive())
+		fb.frameComplete();
+}
+
+// Display modes and the renderer's copy of video memory.  Color and
+// flashing are preferences and not saved.
+void
+Apple2Render::saveState(StateWriter &w)
+{
+	w.beginChunk("AVID");
+	w.putBool(gfx_en);
+	w.putBool(hires_en);
+	w.putBool(mix_en);
+	w.putBool(page_en);
+	w.putBool(flash_on);
+	w.putInt(flash_frames);
+	w.putRam(vidmem, APPLE_VIDMEM_SIZE);
+	w.endChunk();
+}
+
+// Optional, since a state saved without a renderer has no AVID chunk.
+// If the modes are the same only bytes that differ are redrawn, which
+// is usually far cheaper than redrawing everything.
+void
+Apple2Render::loadState(StateReader &r)
+{
+	uint8_t mem[APPLE_VIDMEM_SIZE];
+
+	if (!r.findChunk("AVID"))
+		return;
+	bool gfx = r.getBool();
+	bool hires = r.getBool();
+	bool mix = r.getBool();
+	bool page = r.getBool();
+	bool flash = r.getBool();
+	flash_frames = r.getInt();
+	r.getRam(mem, APPLE_VIDMEM_SIZE);
+	r.endChunk();
+	if (!r.isOk())
+		return;
+
+	if (gfx == gfx_en && hires == hires_en && mix == mix_en &&
+	    page == page_en && flash == flash_on) {
+		for (int addr = 0; addr < APPLE_VIDMEM_SIZE; addr++)
+			if (mem[addr] != vidmem[addr])
+				write(addr, mem[addr]);
+		return;
+	}
+
+	gfx_en = gfx;
+	hires_en = hires;
+	mix_en = mix;
+	page_en = page;
+	flash_on = flash;
+	memcpy(vidmem, mem, APPLE_VIDMEM_SIZE);
+	updateAll();
+}
+
+// Enable or disable flashing (for pause mode).
+void
+Apple2Render::setFlashing(bool flag)
+{
+	DPRINTF(1, "Apple2Render::%s: flag=%d\n", __func__, flag);
+
+	flashing = flag;
+}
+
+void
+Apple2Render::setColor(bool flag)
+{
+	DPRINTF(1, "Apple2Render::%s: flag=%d\n", __func__, flag);
+
+	if (color != flag) {
+		color = flag;
+		updateAll();
+	}
+}
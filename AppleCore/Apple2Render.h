@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Apple2Render.h
+//
+//	Apple II video that draws into a core FrameBuffer.  Palette
+//	indices 0-15 are the LORES colors (0 black, 15 white), 16 and 17
+//	the two greys of monochrome LORES.
+//
+
+#ifndef __APPLE2RENDER_H__
+#define __APPLE2RENDER_H__
+
+#include "Apple2Video.h"
+#include "FrameBuffer.h"
+
+#define APPLE_VIDMEM_SIZE	0x6000
+
+#define APPLE_NATIVE_WIDTH	280
+#define APPLE_NATIVE_HEIGHT	192
+
+class Apple2Render : public Apple2Video {
+protected:
+	FrameBuffer	fb;
+
+	bool		flashing;
+	bool		color;
+	bool		flash_on;
+	int		flash_frames;
+
+	uint8_t		vidmem[APPLE_VIDMEM_SIZE];
+	bool		gfx_en;
+	bool		hires_en;
+	bool		mix_en;
+	bool		page_en;
+
+	void	updateChar(int col, int row, uint8_t d8);
+	void	updateLores(int col, int row, uint8_t d8);
+	void	updateHires(int col, int y, uint8_t d8l, uint8_t d8,
+			    uint8_t d8r);
+	void	updateFlash(void);
+public:
+	Apple2Render();
+
+	void	updateAll(void);
+	void	setFlashing(bool flag);
+	void	setColor(bool flag);
+	FrameBuffer *getFrameBuffer(void)
+	{ return &this->fb; }
+
+	// Apple2Video interface
+	void	reset(void);
+	void	cycle(void) { }
+	void	vsync(void);
+	void	setGfx(bool gfx);
+	void	setHires(bool hires);
+	void	setMix(bool mix);
+	void	setPage(bool page);
+
+	void	write(uint16_t addr, uint8_t d8);
+	uint8_t read(uint16_t addr);
+	void	saveState(StateWriter &w);
+	void	loadState(StateReader &r);
+};
+
+#endif // __APPLE2RENDER_H__
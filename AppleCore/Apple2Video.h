@@ -30,10 +30,14 @@
 
 #include "MemSpace.h"
 
+class StateWriter;
+class StateReader;
+
 class Apple2Video : public MemSpace {
 public:
 	virtual void	reset(void) = 0;
 	virtual void	cycle(void) = 0;
+	virtual void	vsync(void) = 0;
 	virtual void	setGfx(bool gfx) = 0;
 	virtual void	setHires(bool hires) = 0;
 	virtual void	setMix(bool mix) = 0;
@@ -41,6 +45,8 @@ public:
 
 	virtual uint8_t read(uint16_t addr) = 0;
 	virtual void	write(uint16_t addr, uint8_t d8) = 0;
+	virtual void	saveState(StateWriter &w) = 0;
+	virtual void	loadState(StateReader &r) = 0;
 };
 
 #endif // __APPLE2VIDEO_H__
@@ -34,6 +34,7 @@ class AppleVideoStub : public Apple2Video {
 public:
 	void	reset(void) { }
 	void	cycle(void) { }
+	void	vsync(void) { }
 	void	setGfx(bool gfx);
 	void	setMix(bool mix);
 	void	setPage(bool page);
@@ -41,6 +42,8 @@ public:
 
 	void	write(uint16_t addr, uint8_t d8);
 	uint8_t read(uint16_t addr) { return 0xaa; }
+	void	saveState(StateWriter &w) { }
+	void	loadState(StateReader &r) { }
 };
 
 #endif //  __APPLEVIDEOSTUB_H__
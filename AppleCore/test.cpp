@@ -1,19 +1,261 @@
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <new>
 
 #include "AppleVideoStub.h"
+#include "Apple2Render.h"
 #include "Apple2.h"
+#include "AudioRing.h"
+#include "WavWriter.h"
+#include "Movie.h"
+#include "SaveState.h"
+#include "Apple2Disk2.h"
 
+#define AUDIO_RATE	48000
+
+// Replay a movie as fast as it goes and check its frame hashes.  The
+// hashes cover the renderer's state, so this uses the real one.
+static int
+playMovie(const char *filename)
+{
+	Apple2Render video;
+	Apple2 apple(&video);
+	Movie movie("APL2", APPLE_FRAME_CLOCKS);
+
+	movie.setSaveFunc([&] (StateWriter &w) { apple.saveState(w); });
+	movie.setHashFunc([&] { return apple.stateHash(); });
+	movie.setLoadFunc([&] (StateReader &r) {
+		return apple.loadState(r);
+	});
+	movie.setInputFunc([&] (const InputEvent &in) {
+		apple.input(in.type, in.a, in.b);
+	});
+
+	if (!movie.load(filename) || !movie.play()) {
+		fprintf(stderr, "%s: can't play movie\n", filename);
+		return 1;
+	}
+
+	clock_t t = clock();
+	while (movie.isPlaying()) {
+		int n = movie.until(APPLE_FRAME_CLOCKS);
+		for (int i = n; i > 0; )
+			if (apple.cycle())
+				i--;
+		movie.ran(n);
+	}
+	double secs = (double)(clock() - t) / CLOCKS_PER_SEC;
+
+	printf("%s: %u frames checked, %u mismatches", filename,
+	       movie.getChecked(), movie.getMismatches());
+	if (movie.getMismatches() > 0)
+		printf(" (first at clock %llu)",
+		       (unsigned long long)movie.getFirstMismatch());
+	if (secs > 0.0)
+		printf(", %.1fx real time",
+		       movie.getLength() / (APPLE_CLOCK_RATE * secs));
+	printf("\n");
+
+	return movie.getMismatches() > 0 ? 1 : 0;
+}
+
+// Run n frames, counting clocks the CPU stopped for as well.
+static void
+runFrames(Apple2 &apple, int frames)
+{
+	for (int i = frames * APPLE_FRAME_CLOCKS; i > 0; i--)
+		apple.cycle();
+}
+
+// Load a state of a into b and check the two then run the same.
+static int
+copyState(Apple2 &a, Apple2 &b, int frames, const char *what)
+{
+	StateWriter w;
+
+	a.saveState(w);
+	StateReader r(w.getData(), w.getSize());
+	if (!b.loadState(r)) {
+		printf("%s: state didn't load\n", what);
+		return 1;
+	}
+
+	for (int i = 0; i <= frames; i++) {
+		if (a.stateHash() != b.stateHash()) {
+			printf("%s: differs %d frames after loading\n",
+			       what, i);
+			return 1;
+		}
+		runFrames(a, 1);
+		runFrames(b, 1);
+	}
+
+	return 0;
+}
+
+// Save states and load them into a second machine, once while booting
+// and once while fast disk holds the CPU, and check they run the same.
+static int
+roundTrip(void)
+{
+	static const uint8_t rwts[] = {
+		0x84, 0x48, 0x85, 0x49, 0xa0, 0x02, 0x8c, 0xf8, 0x06,
+		0xa0, 0x04, 0x8c, 0xf8, 0x04, 0xa0, 0x01, 0xb1, 0x48
+	};
+	static const uint8_t prog[] = {
+		0xa0, 0x20,		// LDY #$20
+		0xa9, 0x03,		// LDA #$03
+		0x20, 0x00, 0xbd,	// JSR $BD00
+		0x4c, 0x07, 0x03	// JMP *
+	};
+	static const uint8_t iob[] = {
+		1, 0x60, 1, 0, 17, 0, 0, 0, 0x00, 0x20, 0, 0, 1, 0
+	};
+	AppleVideoStub va, vb;
+	Apple2 a(&va), b(&vb);
+	int fails = 0;
+
+	a.reset();
+	b.reset();
+	runFrames(a, 30);
+	fails += copyState(a, b, 30, "boot");
+
+	// Past clearing memory, at the BASIC prompt.
+	runFrames(a, 60);
+
+	// Read track 17 sector 0 through a stand-in for DOS's RWTS.
+	std::vector<uint8_t> disk(DISK2_N_TRACKS * DISK2_TRACK_BYTES);
+	for (size_t i = 0; i < disk.size(); i++)
+		disk[i] = i * 7;
+	ImageRef image = Image::copy(disk.data(), disk.size());
+	for (Apple2 *m : { &a, &b }) {
+		m->getDisk()->setImage(image, DISK2_DOS);
+		m->setFastDisk(true);
+	}
+	a.writeRam(0xbd00, rwts, sizeof(rwts));
+	a.writeRam(0x0300, prog, sizeof(prog));
+	a.writeRam(0x0320, iob, sizeof(iob));
+	a.getCpu()->setPc(0x0300);
+	for (int i = 0; i < 100; i++)
+		a.cycle();
+	fails += copyState(a, b, 30, "fast disk");
+
+	uint8_t buf[256];
+	b.readRam(0x2000, buf, sizeof(buf));
+	if (memcmp(buf, &disk[17 * DISK2_TRACK_BYTES], sizeof(buf)) != 0) {
+		printf("fast disk: sector not read\n");
+		fails++;
+	}
+
+	printf("save/load round trip: %s\n", fails ? "FAILED" : "ok");
+
+	return fails ? 1 : 0;
+}
+
+// A machine and its renderer built in memory full of junk, so that
+// anything the constructors or reset leave uninitialized shows up in
+// the hash.
+struct JunkApple {
+	void		*vmem;
+	void		*mmem;
+	Apple2Render	*video;
+	Apple2		*apple;
+
+	JunkApple(uint8_t junk)
+	{
+		vmem = ::operator new(sizeof(Apple2Render));
+		mmem = ::operator new(sizeof(Apple2));
+		memset(vmem, junk, sizeof(Apple2Render));
+		memset(mmem, junk, sizeof(Apple2));
+		video = new (vmem) Apple2Render;
+		apple = new (mmem) Apple2(video);
+	}
+	~JunkApple()
+	{
+		apple->~Apple2();
+		video->~Apple2Render();
+		::operator delete(mmem);
+		::operator delete(vmem);
+	}
+};
+
+// Check two fresh machines hash the same from reset and every frame
+// after for frames.
+static int
+checkFresh(int frames)
+{
+	JunkApple a(0x00), b(0xa5);
+
+	a.apple->reset();
+	b.apple->reset();
+
+	for (int f = 0; f <= frames; f++) {
+		if (a.apple->stateHash() != b.apple->stateHash()) {
+			printf("fresh machines differ at frame %d\n", f);
+			return 1;
+		}
+		runFrames(*a.apple, 1);
+		runFrames(*b.apple, 1);
+	}
+
+	printf("fresh machines the same for %d frames\n", frames);
+
+	return 0;
+}
+
+// Usage: apple [file.wav [seconds]]
+//        apple -p movie
+//        apple -s
+//        apple -d frames
+//
+// With a file name, run for a while (default 10 seconds) recording the
+// speaker to a .wav file.  With -p, replay a movie and check it.  With
+// -s, check machines loaded from save states run the same.  With -d,
+// check two fresh machines run the same.
 int
 main(int argc, char *argv[])
 {
+	if (argc > 2 && strcmp(argv[1], "-p") == 0)
+		return playMovie(argv[2]);
+	if (argc > 1 && strcmp(argv[1], "-s") == 0)
+		return roundTrip();
+	if (argc > 2 && strcmp(argv[1], "-d") == 0)
+		return checkFresh(atoi(argv[2]));
+
 	AppleVideoStub video;
 	Apple2 apple(&video);
+	AudioRing ring(AUDIO_RATE, AUDIO_RATE);
+	WavWriter wav;
+	int16_t buf[1024];
+	long seconds = 10;
+
+	if (argc > 1) {
+		if (!wav.open(argv[1], AUDIO_RATE))
+			return 1;
+		if (argc > 2)
+			seconds = atol(argv[2]);
+		apple.setAudioRing(&ring);
+	}
 
 	apple.reset();
 	apple.cycle();
 	video.reset();
 
-	for (;;) {
+	for (long clk = 0; !wav.isOpen() ||
+		     clk < seconds * APPLE_CLOCK_RATE; clk++) {
 		apple.cycle();
+
+		if ((clk & 0xffff) == 0 || clk == seconds * APPLE_CLOCK_RATE - 1) {
+			int n;
+			while ((n = ring.read(buf, 1024)) > 0)
+				wav.write(buf, n);
+		}
 	}
+
+	wav.close();
+
+	return 0;
 }
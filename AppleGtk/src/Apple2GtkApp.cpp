@@ -29,11 +29,14 @@
 #include "Apple2GtkApp.h"
 
 #include <cstdio>
+#include <strings.h>
 
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "Apple2.h"
+#include "Media.h"
 
 #include "Apple2GtkAppWin.h"
 
@@ -46,21 +49,94 @@
 
 extern uint8_t applerom[];
 
+#define AUDIO_RATE	48000
+#define AUDIO_RING_SIZE	16384	// samples, about 1/3 second
+
 Apple2GtkApp::Apple2GtkApp()
 	: Gtk::Application("net.skibo.apple2"),
 	  apple(nullptr),
-	  debugger(apple.getCpu())
+	  emu(apple.getCpu(), APPLE_CLOCK_RATE, APPLE_FRAME_CLOCKS),
+	  movie("APL2", APPLE_FRAME_CLOCKS),
+	  runahead(APPLE_FRAME_CLOCKS),
+	  debugger(apple.getCpu()),
+	  audioRing(AUDIO_RING_SIZE, AUDIO_RATE)
 {
 	DPRINTF(1, "Apple2GtkApp::%s:\n", __func__);
 
+	apple.setAudioRing(&audioRing);
+
+	// Slices stop at movie frames and inputs and at run-ahead frames.
+	// A false cycle ran no clock.
+	emu.setSliceFunc([&] (int n) {
+		while (n > 0) {
+			int m = runahead.until(movie.until(n));
+			for (int i = 0; i < m; i++)
+				if (!apple.cycle()) {
+					movie.ran(i);
+					runahead.ran(i);
+					return false;
+				}
+			movie.ran(m);
+			runahead.ran(m);
+			n -= m;
+		}
+		return true;
+	});
+	emu.setStopCallback([&] { this->onStopped(); });
+	emu.setNotifyCallback([&] { emuNotify.emit(); });
+	emuNotify.connect(sigc::mem_fun(emu, &EmuThread::runGui));
+
+	movie.setSaveFunc([&] (StateWriter &w) { apple.saveState(w); });
+	movie.setHashFunc([&] { return apple.stateHash(); });
+	movie.setLoadFunc([&] (StateReader &r) {
+		return apple.loadState(r);
+	});
+	movie.setInputFunc([&] (const InputEvent &in) {
+		apple.input(in.type, in.a, in.b);
+	});
+	movie.setDoneCallback([&] {
+		emu.postGui([&] { this->onMovieDone(); });
+	});
+	apple.setInputCallback([&] (int type, int a, int b) {
+		movie.input(type, a, b);
+	});
+
+	// Frames run ahead are muted and only the last is shown.  The disk
+	// image isn't part of a state, and breakpoints would be hit in the
+	// future, so don't run ahead while either could happen.
+	runahead.setSaveFunc([&] (StateWriter &w) { apple.saveState(w); });
+	runahead.setLoadFunc([&] (StateReader &r) {
+		return apple.loadState(r);
+	});
+	runahead.setRunFunc([&] (int n) {
+		while (n > 0)
+			if (apple.cycle())
+				n--;
+	});
+	runahead.setModeFunc([&] (int mode) {
+		audioRing.setMute(mode == RUNAHEAD_HIDDEN ||
+				  mode == RUNAHEAD_SHOWN);
+		disp->setHold(mode == RUNAHEAD_REAL ||
+			      mode == RUNAHEAD_HIDDEN);
+	});
+	runahead.setSafeFunc([&] {
+		Cpu6502 *cpu = apple.getCpu();
+
+		return !apple.getDisk()->isMotorOn() &&
+			cpu->getNumBreaks() == 0 && !cpu->isStepping();
+	});
+
+	// Disk access runs flat out, if asked to, with the display taking
+	// only the frames it can show.
+	emu.setBusyFunc([&] { return apple.getDisk()->isMotorOn(); });
+	emu.setTurboCallback([&] (bool flag) { disp->setTurbo(flag); });
+
 	appwindow = nullptr;
-	diskdata = nullptr;
 	debuggerActive = false;
 }
 
 Apple2GtkApp::~Apple2GtkApp()
 {
-	delete [] diskdata;
 }
 
 Glib::RefPtr<Apple2GtkApp>
@@ -91,6 +167,8 @@ Apple2GtkApp::doFileChooser(enum e_fileType type, bool dosave)
 		filter = Gtk::FileFilter::create();
 		filter->set_name("Dsk and Nib files");
 		filter->add_pattern("*.dsk");
+		filter->add_pattern("*.do");
+		filter->add_pattern("*.po");
 		filter->add_pattern("*.nib");
 		chooser.add_filter(filter);
 		break;
@@ -100,6 +178,12 @@ Apple2GtkApp::doFileChooser(enum e_fileType type, bool dosave)
 		filter->add_pattern("*.bin");
 		chooser.add_filter(filter);
 		break;
+	case fileTypeMovie:
+		filter = Gtk::FileFilter::create();
+		filter->set_name("Movie files");
+		filter->add_pattern("*.e6mv");
+		chooser.add_filter(filter);
+		break;
 	}
 
 	filter = Gtk::FileFilter::create();
@@ -123,7 +207,7 @@ Apple2GtkApp::create_appwindow()
 {
 	DPRINTF(1, "Apple2GtkApp::%s:\n", __func__);
 
-	auto appwindow = Apple2GtkAppWin::create(&apple);
+	auto appwindow = Apple2GtkAppWin::create(&apple, &emu);
 
 	add_window(*appwindow);
 
@@ -147,6 +231,7 @@ Apple2GtkApp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 	DPRINTF(1, "Apple2GtkApp::%s:\n", __func__);
 
 	builder->get_widget("pause_button", pauseButton);
+	builder->get_widget("label_speed", labelSpeed);
 	pauseButton->signal_toggled().connect(sigc::mem_fun(*this,
 				&Apple2GtkApp::onPauseToggle));
 
@@ -178,6 +263,17 @@ Apple2GtkApp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 	checkmenu->signal_toggled().connect(sigc::bind(sigc::mem_fun(*this,
 				&Apple2GtkApp::onMenuColorToggle), checkmenu));
 
+	builder->get_widget("menu_fastdisk", checkmenu);
+	checkmenu->signal_toggled().connect(sigc::bind(sigc::mem_fun(*this,
+				&Apple2GtkApp::onMenuFastDiskToggle),
+				checkmenu));
+
+	builder->get_widget("menu_auto_turbo", checkmenu);
+	checkmenu->signal_toggled().connect(sigc::bind(sigc::mem_fun(*this,
+				&Apple2GtkApp::onMenuAutoTurboToggle),
+				checkmenu));
+	emu.setAutoTurbo(checkmenu->get_active());
+
 	builder->get_widget("menu_load_disk", menu);
 	menu->signal_activate().connect(sigc::mem_fun(*this,
 				&Apple2GtkApp::onMenuLoadDisk));
@@ -198,6 +294,29 @@ Apple2GtkApp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 	menu->signal_activate().connect(sigc::mem_fun(*this,
 				&Apple2GtkApp::onMenuLoadRom));
 
+	checkmenu = nullptr;
+	builder->get_widget("menu_capture", checkmenu);
+	checkmenu->signal_toggled().connect(sigc::bind(sigc::mem_fun(*this,
+				&Apple2GtkApp::onMenuCapture),
+						       checkmenu));
+
+	builder->get_widget("menu_movie_record", checkmenu);
+	checkmenu->signal_toggled().connect(sigc::bind(sigc::mem_fun(*this,
+				&Apple2GtkApp::onMenuMovieRecord),
+						       checkmenu));
+
+	builder->get_widget("menu_movie_play", menu);
+	menu->signal_activate().connect(sigc::mem_fun(*this,
+				&Apple2GtkApp::onMenuMoviePlay));
+
+	for (int i = 0; i <= 2; i++) {
+		std::string name = "menu_runahead_" + std::to_string(i);
+		builder->get_widget(name, checkmenu);
+		checkmenu->signal_activate().connect(sigc::bind(sigc::mem_fun(
+				*this, &Apple2GtkApp::onMenuRunAhead),
+							checkmenu, i));
+	}
+
 	builder->get_widget("menu_quit", menu);
 	menu->signal_activate().connect(sigc::mem_fun(*this,
 				&Apple2GtkApp::onMenuQuit));
@@ -212,6 +331,7 @@ Apple2GtkApp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 				&Apple2GtkApp::onMenuAbout), about));
 
 	disp = appwindow->getDisp();
+	disp->setCapture(&capture);
 }
 
 void
@@ -237,14 +357,22 @@ Apple2GtkApp::on_activate()
 	turbo = false;
 	apple.reset();
 	appleRun(true);
-	appwindow->dispFlashing(true);
+	emu.post([=] { appwindow->dispFlashing(true); });
 
 	connectSignals(appwindow->getBuilder());
 	debugger.connectSignals(appwindow->getBuilder());
 
-	apple.getDisk()->setDiskCallback([&] (bool motor, int track)
-		{ this->diskCallback(motor, track); });
+	// Disk II calls back on the emulation thread.
+	apple.getDisk()->setDiskCallback([&] (bool motor, int track) {
+		if (!runahead.isAhead())
+			emu.postGui([=] { this->diskCallback(motor, track); });
+	});
 	debugger.setDebugCallback([&] (int typ) {this->debugCallback(typ);});
+
+	Glib::signal_timeout().connect(sigc::mem_fun(*this,
+				&Apple2GtkApp::onTimeout), 10);
+	Glib::signal_timeout().connect(sigc::mem_fun(*this,
+				&Apple2GtkApp::onStatus), 1000);
 }
 
 void
@@ -252,6 +380,7 @@ Apple2GtkApp::on_hide_window(Gtk::Window *win)
 {
 	DPRINTF(1, "Apple2GtkApp::%s:\n", __func__);
 
+	appleRun(false);
 	delete win;
 	appwindow = nullptr;
 }
@@ -264,22 +393,26 @@ Apple2GtkApp::debugCallback(int typ)
 	switch (typ) {
 	case CALLBACK_STOP:
 		appleRun(false);
-		appwindow->dispFlashing(false);
+		emu.post([=] { appwindow->dispFlashing(false); });
 		pauseButton->set_active(true);
 		debugger.setState(debuggerActive, running);
 		break;
 
 	case CALLBACK_STEP:
-		apple.getCpu()->stepCpu();
-		if (!running) {
-			while (apple.cycle())
-				;
+		if (running) {
+			// Thread stops after one instruction; see onStopped().
+			emu.post([&] { apple.getCpu()->stepCpu(); });
+			break;
 		}
+		apple.getCpu()->stepCpu();
+		while (apple.cycle())
+			;
+		disp->flush();
 		break;
 
 	case CALLBACK_CONT:
 		appleRun(true);
-		appwindow->dispFlashing(true);
+		emu.post([=] { appwindow->dispFlashing(true); });
 		pauseButton->set_active(false);
 		debugger.setState(debuggerActive, running);
 		break;
@@ -294,7 +427,7 @@ Apple2GtkApp::onPauseToggle(void)
 	DPRINTF(1, "Apple2GtkApp::%s: state=%d\n", __func__, state);
 
 	appleRun(!state);
-	appwindow->dispFlashing(!state);
+	emu.post([=] { appwindow->dispFlashing(!state); });
 }
 
 void
@@ -312,7 +445,7 @@ Apple2GtkApp::onResetButton(Gtk::Button *button)
 {
 	DPRINTF(1, "Apple2GtkApp::%s:\n", __func__);
 
-	apple.reset();
+	emu.post([&] { apple.reset(); });
 }
 
 void
@@ -320,7 +453,7 @@ Apple2GtkApp::onMenuReset(void)
 {
 	DPRINTF(1, "Apple2GtkApp::%s:\n", __func__);
 
-	apple.reset();
+	emu.post([&] { apple.reset(); });
 }
 
 void
@@ -328,7 +461,7 @@ Apple2GtkApp::onMenuRestart(void)
 {
 	DPRINTF(1, "Apple2GtkApp::%s:\n", __func__);
 
-	apple.restart();
+	emu.post([&] { apple.restart(); });
 }
 
 void
@@ -338,7 +471,27 @@ Apple2GtkApp::onMenuColorToggle(Gtk::CheckMenuItem *checkmenu)
 
 	DPRINTF(1, "Apple2GtkApp::%s: state=%d\n", __func__, state);
 
-	disp->setColor(state);
+	emu.post([=] { disp->setColor(state); });
+}
+
+void
+Apple2GtkApp::onMenuFastDiskToggle(Gtk::CheckMenuItem *checkmenu)
+{
+	bool state = checkmenu->get_active();
+
+	DPRINTF(1, "Apple2GtkApp::%s: state=%d\n", __func__, state);
+
+	emu.post([=] { apple.setFastDisk(state); });
+}
+
+void
+Apple2GtkApp::onMenuAutoTurboToggle(Gtk::CheckMenuItem *checkmenu)
+{
+	bool state = checkmenu->get_active();
+
+	DPRINTF(1, "Apple2GtkApp::%s: state=%d\n", __func__, state);
+
+	emu.setAutoTurbo(state);
 }
 
 void
@@ -362,124 +515,6 @@ Apple2GtkApp::onMenuAbout(Gtk::AboutDialog *about)
 	about->set_visible(false);
 }
 
-void
-Apple2GtkApp::convertDskToNib(void)
-{
-	DPRINTF(1, "Apple2GtkApp::%s:\n", __func__);
-
-#define DISK2_TRACK_SIZE	6656
-#define DISK2_N_TRACKS		35
-#define DISK2_N_SECS		16
-
-	const uint8_t sixTwo[] = {
-		0x96, 0x97, 0x9a, 0x9b, 0x9d, 0x9e, 0x9f, 0xa6,
-		0xa7, 0xab, 0xac, 0xad, 0xae, 0xaf, 0xb2, 0xb3,
-		0xb4, 0xb5, 0xb6, 0xb7, 0xb9, 0xba, 0xbb, 0xbc,
-		0xbd, 0xbe, 0xbf, 0xcb, 0xcd, 0xce, 0xcf, 0xd3,
-		0xd6, 0xd7, 0xd9, 0xda, 0xdb, 0xdc, 0xdd, 0xde,
-		0xdf, 0xe5, 0xe6, 0xe7, 0xe9, 0xea, 0xeb, 0xec,
-		0xed, 0xee, 0xef, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6,
-		0xf7, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
-	};
-	const uint8_t secSkew[] = {
-		0, 7, 14, 6, 13, 5, 12, 4, 11, 3, 10, 2, 9, 1, 8, 15
-	};
-	int i;
-	uint8_t *nibbytes = new uint8_t[DISK2_N_TRACKS * DISK2_TRACK_SIZE];
-	int offs;
-
-	for (int track = 0; track < DISK2_N_TRACKS; track++) {
-		offs = track * DISK2_TRACK_SIZE;
-		for (int sec = 0; sec < DISK2_N_SECS; sec++) {
-
-			// Sync bytes
-			for (i = 0; i < 20; i++)
-				nibbytes[offs++] = 0xff;
-
-			// Addr field prologue
-			nibbytes[offs++] = 0xd5;
-			nibbytes[offs++] = 0xaa;
-			nibbytes[offs++] = 0x96;
-
-			// Volume, track, sec, checksum
-			nibbytes[offs++] = 0xaa | (254 >> 1);
-			nibbytes[offs++] = 0xaa | 254;
-			nibbytes[offs++] = 0xaa | (track >> 1);
-			nibbytes[offs++] = 0xaa | track;
-			nibbytes[offs++] = 0xaa | (sec >> 1);
-			nibbytes[offs++] = 0xaa | sec;
-			nibbytes[offs++] = 0xaa | ((254 ^ track ^ sec) >> 1);
-			nibbytes[offs++] = 0xaa | (254 ^ track ^ sec);
-
-			// Addr field epilogue.
-			nibbytes[offs++] = 0xde;
-			nibbytes[offs++] = 0xaa;
-			nibbytes[offs++] = 0xeb;
-
-			// Sync bytes
-			for (int i = 0; i < 20; i++)
-				nibbytes[offs++] = 0xff;
-
-			// Data field prologue
-			nibbytes[offs++] = 0xd5;
-			nibbytes[offs++] = 0xaa;
-			nibbytes[offs++] = 0xad;
-
-			// Start by prenibbilizing
-			uint8_t prenib[342];
-			int doffs = secSkew[sec] * 256 + track * 4096;
-			for (i = 0; i < 256; i++) {
-				uint8_t d8 = diskdata[doffs + i];
-
-				prenib[i] = (d8 >> 2);
-
-				if (i < 86)
-					prenib[256 + 85 - i] =
-						((d8 & 0x02) >> 1) |
-						((d8 & 0x01) << 1);
-				else if (i < 172)
-					prenib[256 + 171 - i] |=
-						(((d8 & 0x02) << 1) |
-						 ((d8 & 0x01) << 3));
-				else
-					prenib[256 + 257 - i] |=
-						(((d8 & 0x02) << 3) |
-						 ((d8 & 0x01) << 5));
-
-				if (i < 2)
-					prenib[257 - i] |=
-						(((d8 & 0x02) << 3) |
-						 ((d8 & 0x01) << 5));
-			}
-
-			// Encode nibbilized data.
-			uint8_t prev = 0;
-			for (i = 0; i < 86; i++) {
-				nibbytes[offs++] =
-					sixTwo[prev ^ prenib[256 + 85 - i]];
-				prev = prenib[256 + 85 - i];
-			}
-			for (i = 0; i < 256; i++) {
-				nibbytes[offs++] = sixTwo[prev ^ prenib[i]];
-				prev = prenib[i];
-			}
-			nibbytes[offs++] = sixTwo[prev];
-
-			// Data field epilogue
-			nibbytes[offs++] = 0xde;
-			nibbytes[offs++] = 0xaa;
-			nibbytes[offs++] = 0xeb;
-		}
-
-		while (offs < (track + 1) * DISK2_TRACK_SIZE)
-			nibbytes[offs++] = 0xff;
-	}
-
-	delete [] diskdata;
-	diskdata = nibbytes;
-	disklen = DISK2_N_TRACKS * DISK2_TRACK_SIZE;
-}
-
 void
 Apple2GtkApp::onMenuLoadDisk(void)
 {
@@ -494,36 +529,44 @@ Apple2GtkApp::onMenuLoadDisk(void)
 	DPRINTF(1, "Apple2GtkApp::%s: filename=%s\n", __func__,
 		filename.c_str());
 
-	std::ifstream file(filename, std::ios::in | std::ios::binary |
-			   std::ios::ate);
-	if (file.is_open()) {
-		int len = file.tellg();
-
-		DPRINTF(1, "Apple2GtkApp::%s: loading file len %d\n", __func__,
-			len);
-
-		if (diskdata)
-			delete [] diskdata;
-		diskdata = new uint8_t[len];
-		disklen = len;
-
-		file.seekg(0, std::ios::beg);
-		file.read((char *)diskdata, len);
-		file.close();
-
-		if (disklen == 143360)
-			convertDskToNib();
+	std::string error;
+	ImageRef image = Media::open(filename, MEDIA_UNKNOWN, error);
+	int type = MEDIA_UNKNOWN;
+	if (image)
+		type = Media::typeOf(filename, image->getSize());
+	if (image && type != MEDIA_DSK && type != MEDIA_NIB) {
+		error = "not an Apple disk";
+		image = nullptr;
+	}
+	if (image) {
+		DPRINTF(1, "Apple2GtkApp::%s: loading file len %zu\n",
+			__func__, image->getSize());
+
+		// Sector images are nibblized by the disk controller a
+		// track at a time, in ProDOS order if the name says so.
+		int format = DISK2_NIB;
+		if (type == MEDIA_DSK) {
+			size_t dot = filename.find_last_of(".");
+			if (dot != std::string::npos &&
+			    strcasecmp(filename.c_str() + dot, ".po") == 0)
+				format = DISK2_PRODOS;
+			else
+				format = DISK2_DOS;
+		}
 
-		apple.getDisk()->setNib(diskdata);
-
-		DPRINTF(1, "Apple2GtkApp::%s: NIB file len=%d\n", __func__,
-			len);
+		// The disk controller reads the image on the emulation
+		// thread so hold it still while swapping.
+		bool wasRunning = emu.isRunning();
+		emu.run(false);
+		apple.getDisk()->setImage(image, format);
+		emu.run(wasRunning);
 
 		std::string basenm = filename;
 		if (basenm.find_last_of("/") != std::string::npos)
 			basenm = basenm.substr(basenm.find_last_of("/") + 1);
 		entryDisk1->get_buffer()->set_text(basenm);
-	}
+	} else
+		fprintf(stderr, "%s: %s\n", filename.c_str(), error.c_str());
 }
 
 void
@@ -532,7 +575,8 @@ Apple2GtkApp::onMenuSaveDisk(void)
 	DPRINTF(1, "Apple2GtkApp::%s:\n", __func__);
 
 	// No Disk!  XXX: error dialog?
-	if (!diskdata)
+	Apple2Disk2 *disk = apple.getDisk();
+	if (!disk->haveImage())
 		return;
 
 	std::string filename = doFileChooser(fileTypeDsk, true);
@@ -547,7 +591,12 @@ Apple2GtkApp::onMenuSaveDisk(void)
 	std::ofstream file(filename, std::ios::out | std::ios::binary |
 			   std::ios::trunc);
 	if (file.is_open()) {
-		file.write((char *)diskdata, disklen);
+		// Don't save a track half written.  Written tracks of a
+		// sector image are decoded back to sectors here.
+		bool wasRunning = emu.isRunning();
+		emu.run(false);
+		file.write((const char *)disk->getData(), disk->getSize());
+		emu.run(wasRunning);
 		file.close();
 	} // XXX: else do error dialog
 }
@@ -557,11 +606,11 @@ Apple2GtkApp::onMenuUnloadDisk(void)
 {
 	DPRINTF(1, "Apple2GtkApp::%s:\n", __func__);
 
-	if (diskdata)
-		delete [] diskdata;
-	diskdata = nullptr;
+	bool wasRunning = emu.isRunning();
+	emu.run(false);
 
-	apple.getDisk()->setNib(nullptr);
+	apple.getDisk()->setImage(nullptr);
+	emu.run(wasRunning);
 
 	entryDisk1->get_buffer()->set_text("none");
 }
@@ -579,26 +628,22 @@ Apple2GtkApp::onMenuBload(void)
 	DPRINTF(1, "Apple2GtkApp::%s: filename=%s\n", __func__,
 		filename.c_str());
 
-	std::ifstream file(filename, std::ios::in | std::ios::binary |
-			   std::ios::ate);
-	if (file.is_open()) {
-		int len = file.tellg();
+	std::string error;
+	ImageRef image = Media::open(filename, MEDIA_PRG, error);
+	if (image) {
+		int len = image->getSize();
 
 		DPRINTF(1, "Apple2GtkApp::%s: loading file len %d\n", __func__,
 			len);
 
-		uint8_t *binfile = new uint8_t[len];
-
-		file.seekg(0, std::ios::beg);
-		file.read((char *)binfile, len);
-		file.close();
-
+		const uint8_t *binfile = image->getData();
 		uint16_t addr = binfile[0] + (uint16_t)binfile[1] * 256;
 
-		apple.writeRam(addr, &binfile[2], len - 2);
-
-		delete [] binfile;
-	}
+		emu.post([=] {
+			apple.writeRam(addr, image->getData() + 2, len - 2);
+		});
+	} else
+		fprintf(stderr, "%s: %s\n", filename.c_str(), error.c_str());
 }
 
 void
@@ -614,24 +659,137 @@ Apple2GtkApp::onMenuLoadRom(void)
 	DPRINTF(1, "Apple2GtkApp::%s: filename=%s\n", __func__,
 		filename.c_str());
 
-	std::ifstream file(filename, std::ios::in | std::ios::binary |
-			   std::ios::ate);
-	if (file.is_open()) {
-		int len = file.tellg();
+	// A known ROM goes where it belongs, anything else at the top of
+	// memory.
+	std::string error;
+	ImageRef image = Media::open(filename, MEDIA_ROM, error);
+	const KnownRom *known = image ? Media::identify(image) : nullptr;
+	int len = image ? image->getSize() : 0;
+	if (image && known && known->machine != MEDIA_APPLE) {
+		error = std::string("not an Apple ROM: ") + known->name;
+		image = nullptr;
+	} else if (image && len > 0x3000) {
+		error = "ROM is larger than 12K";
+		image = nullptr;
+	}
+	if (image) {
+		uint16_t addr = known ? known->addr : 0x10000 - len;
 
-		DPRINTF(1, "Apple2GtkApp::%s: loading file len %d\n", __func__,
-			len);
+		DPRINTF(1, "Apple2GtkApp::%s: loading file len %d at 0x%x\n",
+			__func__, len, addr);
 
-		uint8_t *binfile = new uint8_t[len];
+		emu.post([=] { apple.setRom(addr, image, 0, len); });
+	} else
+		fprintf(stderr, "%s: %s\n", filename.c_str(), error.c_str());
+}
 
-		file.seekg(0, std::ios::beg);
-		file.read((char *)binfile, len);
-		file.close();
+void
+Apple2GtkApp::onMenuCapture(Gtk::CheckMenuItem *checkmenu)
+{
+	bool active = checkmenu->get_active();
+	DPRINTF(1, "Apple2GtkApp::%s: active=%d\n", __func__, active);
 
-		apple.setRom(0xf800, binfile, len);
+	if (active == capture.isOpen())
+		return;
 
-		delete [] binfile;
+	// Frames are fed to capture on the emulation thread.
+	bool wasRunning = emu.isRunning();
+	emu.run(false);
+	drainAudio();
+
+	if (!active) {
+		capture.close();
+		printf("Capture: %u frames, %u dropped, %u samples dropped\n",
+		       capture.getFrames(), capture.getDropped(),
+		       capture.getDroppedSamples());
+		emu.run(wasRunning);
+		return;
 	}
+
+	// Capture appends .y4m and .wav to the name.
+	std::string filename = doFileChooser(fileTypeBinary, true);
+	if (filename.size() > 4 &&
+	    filename.compare(filename.size() - 4, 4, ".y4m") == 0)
+		filename.resize(filename.size() - 4);
+
+	if (filename == "" ||
+	    !capture.open(filename.c_str(), disp->getFrameBuffer(),
+			  APPLE_CLOCK_RATE, APPLE_FRAME_CLOCKS,
+			  audioRing.getRate()))
+		checkmenu->set_active(false);
+
+	emu.run(wasRunning);
+}
+
+// Recording starts from the machine as it is.  Movies don't hold the
+// ROM or disk images, so play them back with the same ones in.
+void
+Apple2GtkApp::onMenuMovieRecord(Gtk::CheckMenuItem *checkmenu)
+{
+	bool active = checkmenu->get_active();
+	DPRINTF(1, "Apple2GtkApp::%s: active=%d\n", __func__, active);
+
+	if (active == movie.isRecording())
+		return;
+
+	bool wasRunning = emu.isRunning();
+	emu.run(false);
+
+	if (active)
+		movie.record();
+	else {
+		movie.stop();
+		std::string filename = doFileChooser(fileTypeMovie, true);
+		if (filename != "" && !movie.save(filename.c_str()))
+			fprintf(stderr, "Can't save movie %s\n",
+				filename.c_str());
+	}
+
+	emu.run(wasRunning);
+}
+
+void
+Apple2GtkApp::onMenuMoviePlay(void)
+{
+	DPRINTF(1, "Apple2GtkApp::%s:\n", __func__);
+
+	std::string filename = doFileChooser(fileTypeMovie, false);
+
+	// Empty string means Cancel.
+	if (filename == "")
+		return;
+
+	bool wasRunning = emu.isRunning();
+	emu.run(false);
+
+	if (!movie.load(filename.c_str()) || !movie.play())
+		fprintf(stderr, "Can't play movie %s\n", filename.c_str());
+	else
+		disp->flush();
+
+	emu.run(wasRunning);
+}
+
+void
+Apple2GtkApp::onMenuRunAhead(Gtk::CheckMenuItem *checkmenu, int frames)
+{
+	if (!checkmenu->get_active())
+		return;
+
+	DPRINTF(1, "Apple2GtkApp::%s: frames=%d\n", __func__, frames);
+
+	emu.post([=] { runahead.setFrames(frames); });
+}
+
+// Playback reached the end of the movie.
+void
+Apple2GtkApp::onMovieDone(void)
+{
+	printf("Movie: %u frames checked, %u mismatches\n",
+	       movie.getChecked(), movie.getMismatches());
+	if (movie.getMismatches() > 0)
+		printf("Movie: first mismatch at clock %llu\n",
+		       (unsigned long long)movie.getFirstMismatch());
 }
 
 void
@@ -643,48 +801,66 @@ Apple2GtkApp::diskCallback(bool motor, int track)
 	spinnerDisk1->property_active().set_value(motor);
 }
 
-// Timer call-back function.
+// Empty the audio ring, saving samples if capturing.  There is no
+// sound device output yet so samples are dropped otherwise.
+void
+Apple2GtkApp::drainAudio(void)
+{
+	int16_t buf[1024];
+	int n;
+
+	while ((n = audioRing.read(buf, 1024)) > 0)
+		capture.audio(buf, n);
+}
+
+// Timer call-back function.  Emulation runs on its own thread; this
+// just keeps audio moving.
 bool
 Apple2GtkApp::onTimeout(void)
 {
-	if (running) {
-		int cycles = 10000; // 10ms
-
-		while (cycles-- > 0) {
-			if (!apple.cycle()) {
-				// Stopped due to breakpoint or other
-				running = false;
-				pauseButton->set_active(true);
-				debugger.setState(debuggerActive, running);
-				return false;
-			}
-		}
+	drainAudio();
 
-		return true;
-	}
-
-	return false;
+	return true;
 }
 
+// Once a second, show emulated speed and how well pacing is going.
 bool
-Apple2GtkApp::onIdle(void)
-{
-	if (running && turbo) {
-		int cycles = 10000; // 10ms
-		while (cycles-- > 0) {
-			if (!apple.cycle()) {
-				// Stopped due to breakpoint or other
-				running = false;
-				pauseButton->set_active(true);
-				debugger.setState(debuggerActive, running);
-				return false;
-			}
-		}
+Apple2GtkApp::onStatus(void)
+{
+	const Pacer *pacer = emu.getPacer();
+	char buf[128];
+	int n = 0;
+
+	buf[0] = '\0';
+	if (running)
+		n = snprintf(buf, sizeof(buf),
+			     "%.3f MHz  %.2fx  %u late  %u dropped",
+			     pacer->getClockHz() / 1.0e6, pacer->getSpeed(),
+			     pacer->getOverruns(), pacer->getDropped());
+
+	// What running ahead costs, as a share of a real frame's time.
+	if (running && runahead.getFrames() > 0)
+		snprintf(buf + n, sizeof(buf) - n,
+			 "  ahead %d  +%.2f ms (%.0f%%)",
+			 runahead.getFrames(), runahead.getCost() / 1000.0,
+			 runahead.getCost() * 1.0e-4 * APPLE_CLOCK_RATE /
+			 APPLE_FRAME_CLOCKS);
+	labelSpeed->set_text(buf);
+
+	return true;
+}
 
-		return true;
-	}
+// Emulation thread stopped on a breakpoint or after a single step.
+void
+Apple2GtkApp::onStopped(void)
+{
+	DPRINTF(1, "Apple2GtkApp::%s:\n", __func__);
 
-	return false;
+	running = false;
+	appwindow->dispFlashing(false);
+	pauseButton->set_active(true);
+	debugger.setState(debuggerActive, running);
+	drainAudio();
 }
 
 // Start or stop Apple.
@@ -694,14 +870,7 @@ Apple2GtkApp::appleRun(bool flag)
 	if (running == flag)
 		return;
 
-	if (flag) {
-		Glib::signal_timeout().connect(sigc::mem_fun(*this,
-				&Apple2GtkApp::onTimeout), 10);
-
-		if (turbo)
-			Glib::signal_idle().connect(sigc::mem_fun(*this,
-					&Apple2GtkApp::onIdle));
-	}
+	emu.run(flag);
 
 	running = flag;
 }
@@ -712,9 +881,7 @@ Apple2GtkApp::appleTurbo(bool flag)
 	if (turbo == flag)
 		return;
 
-	if (running && flag)
-		Glib::signal_idle().connect(sigc::mem_fun(*this,
-				&Apple2GtkApp::onIdle));
+	emu.setTurbo(flag);
 
 	turbo = flag;
 }
@@ -722,6 +889,9 @@ Apple2GtkApp::appleTurbo(bool flag)
 void
 Apple2GtkApp::onMenuQuit(void)
 {
+	appleRun(false);
+	capture.close();
+
 	auto windows = get_windows();
 	for (auto window : windows)
 		window->hide();
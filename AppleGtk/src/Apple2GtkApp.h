@@ -28,20 +28,32 @@
 
 #include "Apple2.h"
 #include "Cpu6502GtkDebug.h"
+#include "AudioRing.h"
+#include "Capture.h"
+#include "EmuThread.h"
+#include "Movie.h"
+#include "RunAhead.h"
 
 class Apple2GtkAppWin;
 class Apple2GtkDisp;
 
-enum e_fileType { fileTypeDsk, fileTypeBinary };
+enum e_fileType { fileTypeDsk, fileTypeBinary, fileTypeMovie };
 
 class Apple2GtkApp : public Gtk::Application {
 private:
 	Apple2GtkAppWin *appwindow;
 	Apple2		apple;
+	EmuThread	emu;
+	Movie		movie;
+	RunAhead	runahead;
+	Glib::Dispatcher emuNotify;
 	Cpu6502GtkDebug	debugger;
 	Apple2GtkDisp	*disp;
+	AudioRing	audioRing;
+	Capture		capture;
 
 	Gtk::ToggleButton *pauseButton;
+	Gtk::Label	*labelSpeed;
 	Gtk::Entry	*entryDisk1;
 	Gtk::Spinner	*spinnerDisk1;
 
@@ -49,13 +61,13 @@ private:
 
 	bool		running;
 	bool		turbo;
-	uint8_t		*diskdata;
-	int		disklen;
 
 	void		connectSignals(Glib::RefPtr <Gtk::Builder> builder);
 	std::string	doFileChooser(enum e_fileType type, bool dosave);
 	bool		onTimeout(void);
-	bool		onIdle(void);
+	bool		onStatus(void);
+	void		onStopped(void);
+	void		drainAudio(void);
 	void		appleRun(bool flag);
 	void		appleTurbo(bool flag);
 	void		onPauseToggle(void);
@@ -64,15 +76,22 @@ private:
 	void		onMenuReset(void);
 	void		onMenuRestart(void);
 	void		onMenuColorToggle(Gtk::CheckMenuItem *checkmenu);
+	void		onMenuFastDiskToggle(Gtk::CheckMenuItem *checkmenu);
+	void		onMenuAutoTurboToggle(Gtk::CheckMenuItem *checkmenu);
 	void		onMenuDebugToggle(Gtk::CheckMenuItem *checkmenu);
 	void		onMenuAbout(Gtk::AboutDialog *about);
 	void		debugCallback(int typ);
-	void		convertDskToNib(void);
 	void		onMenuLoadDisk(void);
 	void		onMenuSaveDisk(void);
 	void		onMenuUnloadDisk(void);
 	void		onMenuBload(void);
 	void		onMenuLoadRom(void);
+	void		onMenuCapture(Gtk::CheckMenuItem *checkmenu);
+	void		onMenuMovieRecord(Gtk::CheckMenuItem *checkmenu);
+	void		onMenuMoviePlay(void);
+	void		onMovieDone(void);
+	void		onMenuRunAhead(Gtk::CheckMenuItem *checkmenu,
+				       int frames);
 	void		onMenuQuit(void);
 
 	void		diskCallback(bool motor, int track);
@@ -53,7 +53,7 @@ Apple2GtkAppWin::Apple2GtkAppWin(BaseObjectType *cobject,
 
 // Class function
 Apple2GtkAppWin *
-Apple2GtkAppWin::create(Apple2 *apple)
+Apple2GtkAppWin::create(Apple2 *apple, EmuThread *emu)
 {
 	DPRINTF(1, "Apple2GtkAppWin::%s:\n", __func__);
 
@@ -71,7 +71,7 @@ Apple2GtkAppWin::create(Apple2 *apple)
 	apple->setVideo(window->disp);
 
 	Apple2GtkInput *inp = nullptr;
-	builder->get_widget_derived("apple_input", inp, apple);
+	builder->get_widget_derived("apple_input", inp, apple, emu);
 	inp->connectSignals(builder);
 
 	return window;
@@ -30,6 +30,7 @@
 
 #include "Apple2GtkDisp.h"
 class Apple2;
+class EmuThread;
 
 class Apple2GtkAppWin : public Gtk::ApplicationWindow
 {
@@ -44,7 +45,7 @@ public:
 	~Apple2GtkAppWin();
 	Glib::RefPtr<Gtk::Builder> getBuilder() { return this->builder; }
 
-	static Apple2GtkAppWin *create(Apple2 *apple);
+	static Apple2GtkAppWin *create(Apple2 *apple, EmuThread *emu);
 
 	Apple2GtkDisp *getDisp(void)
 	{ return disp; }
@@ -28,59 +28,45 @@
 #ifndef __APPLE2GTKDISP_H__
 #define __APPLE2GTKDISP_H__
 
-#include "Apple2Video.h"
+#include "Apple2Render.h"
+#include "Capture.h"
+#include "FrameSwap.h"
 
-#define APPLE_VIDMEM_SIZE	0x6000
-
-class Apple2GtkDisp : public Gtk::DrawingArea, public Apple2Video {
+// Presents frames Apple2Render draws on the emulation thread.  The
+// renderer's side runs on that thread; everything else is GUI thread.
+class Apple2GtkDisp : public Gtk::DrawingArea, public Apple2Render {
 private:
 	float		disp_scale;
 	float		disp_left;
 	float		disp_top;
 
-	bool		flashing;
-	bool		color;
-	bool		flash_on;
-
-	uint8_t		vidmem[APPLE_VIDMEM_SIZE];
-	bool		gfx_en;
-	bool		hires_en;
-	bool		mix_en;
-	bool		page_en;
-
-
-	Glib::RefPtr<Gdk::Pixbuf> pixbuf;
-	u_char		*pb_data;
-	int		pb_stride;
-	int		pb_n_channels;
-
-	void	updateChar(int col, int row, uint8_t d8);
-	void	updateLores(int col, int row, uint8_t d8);
-	void	updateHires(int col, int y, uint8_t d8l, uint8_t d8,
-			    uint8_t d8r);
-	void	updateAll(void);
+	Glib::RefPtr<Gdk::Pixbuf> pixbufs[FS_NBUFS];
+	FrameSwap	*swap;
+	Capture		*capture;
+	bool		hold;
 
 	bool	onConfigure(GdkEventConfigure *event);
 	bool	onDraw(const ::Cairo::RefPtr<::Cairo::Context> &cr);
-	bool	onFlashTimeout(void);
+	bool	onTick(const Glib::RefPtr<Gdk::FrameClock> &clock);
+	void	onFrame(FrameBuffer *frame);
 public:
 	Apple2GtkDisp(BaseObjectType *cobject,
 		       const Glib::RefPtr<Gtk::Builder> &refBuilder);
+	~Apple2GtkDisp();
 
+	void	setCapture(Capture *_capture)
+	{ this->capture = _capture; }
 	void	connectSignals(Glib::RefPtr <Gtk::Builder> builder);
-	void	setFlashing(bool flag);
-	void	setColor(bool flag);
 
-	// Apple2Video interface
-	void	reset(void);
-	void	cycle(void) { }
-	void	setGfx(bool gfx);
-	void	setHires(bool hires);
-	void	setMix(bool mix);
-	void	setPage(bool page);
-
-	void	write(uint16_t addr, uint8_t d8);
-	uint8_t read(uint16_t addr);
+	// Emulation thread, or GUI thread while emulation is stopped.
+	void	flush(void)
+	{ swap->publish(); }
+	void	setTurbo(bool flag)
+	{ swap->setTurbo(flag); }
+	// Finished frames are neither shown nor captured while held.
+	void	setHold(bool flag)
+	{ this->hold = flag; }
+	void	setColor(bool flag);
 };
 
 #endif // __APPLE2GTKDISP_H__
@@ -29,6 +29,7 @@
 #include "Apple2GtkInput.h"
 
 #include "Apple2.h"
+#include "EmuThread.h"
 
 #ifdef DEBUGIN
 #  include <cstdio>
@@ -40,9 +41,10 @@
 
 Apple2GtkInput::Apple2GtkInput(BaseObjectType *cobject,
 			       const Glib::RefPtr<Gtk::Builder> &refBuilder,
-			       Apple2 *_apple)
+			       Apple2 *_apple, EmuThread *_emu)
 	: Gtk::Image(cobject),
-	apple(_apple)
+	apple(_apple),
+	emu(_emu)
 {
 	DPRINTF(1, "Apple2GtkInput::constructor:\n");
 }
@@ -100,7 +102,9 @@ Apple2GtkInput::onKeyPressEvent(GdkEventKey *event)
 		applekey = 0x80 | keyval;
 	else if (keyval >= GDK_KEY_KP_4 && keyval <= GDK_KEY_KP_6) {
 		// Keypad 4-6 are game buttons
-		apple->setButton(keyval - GDK_KEY_KP_4, true);
+		emu->post([=] {
+			apple->setButton(keyval - GDK_KEY_KP_4, true);
+		});
 	} else
 		// map special keys and ignore all others
 		switch (keyval) {
@@ -122,7 +126,7 @@ Apple2GtkInput::onKeyPressEvent(GdkEventKey *event)
 		}
 
 	if (applekey)
-		apple->setkey(applekey);
+		emu->post([=] { apple->setkey(applekey); });
 
 	return true;
 }
@@ -136,7 +140,9 @@ Apple2GtkInput::onKeyReleaseEvent(GdkEventKey *event)
 
 	// Keypad 4-6 are game buttons
 	if (keyval >= GDK_KEY_KP_4 && keyval <= GDK_KEY_KP_6)
-		apple->setButton(keyval - GDK_KEY_KP_4, false);
+		emu->post([=] {
+			apple->setButton(keyval - GDK_KEY_KP_4, false);
+		});
 
 	return true;
 }
@@ -149,5 +155,5 @@ Apple2GtkInput::onPaddleChange(Glib::RefPtr<Gtk::Adjustment> &adj, int paddle)
 	DPRINTF(1, "Apple2GtkInput::%s: paddle=%d adjust=%f\n", __func__,
 		paddle, val);
 
-	apple->setPaddle(paddle, val);
+	emu->post([=] { apple->setPaddle(paddle, val); });
 }
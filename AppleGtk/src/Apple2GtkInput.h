@@ -27,10 +27,12 @@
 #define __APPLE2GTKINPUT_H__
 
 class Apple2;
+class EmuThread;
 
 class Apple2GtkInput : public Gtk::Image {
 private:
 	Apple2 *apple;
+	EmuThread *emu;
 	Glib::RefPtr<Gtk::Adjustment> paddle[2];
 	bool	onKeyPressEvent(GdkEventKey *event);
 	bool	onKeyReleaseEvent(GdkEventKey *event);
@@ -38,7 +40,7 @@ private:
 public:
 	Apple2GtkInput(BaseObjectType *cobject,
 		       const Glib::RefPtr<Gtk::Builder> &refBuilder,
-		       Apple2 *_apple);
+		       Apple2 *_apple, EmuThread *_emu);
 	void	connectSignals(Glib::RefPtr <Gtk::Builder> builder);
 };
 
@@ -29,12 +29,14 @@
 
 #include "Atari2600.h"
 #include "Atari2600Hw.h"
+#include "SaveState.h"
 
 unsigned int cycles;
 
 Atari2600::Atari2600(Atari2600Video *_video)
 	: cpu(&atarihw),
 	  atarihw(this),
+	  cpudiv3(0),
 	  rdy(true)
 {
 	if (_video)
@@ -54,6 +56,39 @@ Atari2600::reset(void)
 	cpu.reset();
 	cpudiv3 = 0;
 	rdy = true;
+	report(ATARI_INPUT_RESET, 0, 0);
+}
+
+// Apply an input event reported earlier by the input callback.
+void
+Atari2600::input(int type, int a, int b)
+{
+	switch (type) {
+	case ATARI_INPUT_DIFF_LEFT:
+		setDiffLeft(a != 0);
+		break;
+	case ATARI_INPUT_DIFF_RIGHT:
+		setDiffRight(a != 0);
+		break;
+	case ATARI_INPUT_SELECT:
+		setSelect(a != 0);
+		break;
+	case ATARI_INPUT_START:
+		setStart(a != 0);
+		break;
+	case ATARI_INPUT_JOY_LEFT:
+		setJoyLeft(a, b);
+		break;
+	case ATARI_INPUT_JOY_RIGHT:
+		setJoyRight(a, b);
+		break;
+	case ATARI_INPUT_PADDLE:
+		setPaddle(a, b);
+		break;
+	case ATARI_INPUT_RESET:
+		reset();
+		break;
+	}
 }
 
 bool
@@ -76,5 +111,58 @@ Atari2600::cycle(void)
 		cycles++;
 	}
 
+	// Bring the TIA up to date for the debugger.
+	if (!retv)
+		atarihw.catchUp();
+
 	return retv;
 }
+
+// Save the whole machine between cycles.  The writer's buffer is reused
+// so this doesn't allocate once it has grown.
+void
+Atari2600::saveState(StateWriter &w)
+{
+	w.begin("2600");
+	cpu.saveState(w);
+
+	w.beginChunk("2600");
+	w.putInt(cpudiv3);
+	w.putBool(rdy);
+	w.endChunk();
+
+	atarihw.saveState(w);
+}
+
+// Returns false if the state is not for this machine and version, or is
+// damaged.  A damaged state can leave the machine partly loaded.
+bool
+Atari2600::loadState(StateReader &r)
+{
+	if (!r.begin("2600"))
+		return false;
+	cpu.loadState(r);
+
+	if (r.openChunk("2600")) {
+		cpudiv3 = r.getInt();
+		rdy = r.getBool();
+		r.endChunk();
+	}
+
+	atarihw.loadState(r);
+
+	return r.isOk();
+}
+
+// A hash of the whole machine, equal whenever the state is.  RAM is
+// hashed as it is written, so only the CPU and chips are hashed here.
+uint64_t
+Atari2600::stateHash(void)
+{
+	hashw.begin("2600");
+	cpu.saveState(hashw);
+	hashw.putInt(cpudiv3);
+	hashw.putBool(rdy);
+
+	return atarihw.stateHash(hashw);
+}
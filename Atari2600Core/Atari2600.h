@@ -28,9 +28,15 @@
 #ifndef __ATARI2600_H__
 #define __ATARI2600_H__
 
+#include <functional>
+
 #include "Cpu6502.h"
 #include "Atari2600Hw.h"
 #include "Atari2600Video.h"
+#include "SaveState.h"
+
+#define ATARI_CLOCK_RATE	3579545	// color clocks per second
+#define ATARI_FRAME_CLOCKS	(228 * 262) // color clocks per NTSC frame
 
 // bit fields for setJoyLeft()/setJoyRight()
 #define JOY_UP		1
@@ -45,26 +51,51 @@
 #define PADDLE_RIGHT_A	3
 #define PADDLE_VAL_MAX	100
 
+// Input events, as reported to the input callback and replayed by
+// input().
+#define ATARI_INPUT_DIFF_LEFT	0	// a=flag
+#define ATARI_INPUT_DIFF_RIGHT	1	// a=flag
+#define ATARI_INPUT_SELECT	2	// a=flag
+#define ATARI_INPUT_START	3	// a=flag
+#define ATARI_INPUT_JOY_LEFT	4	// a=set b=reset
+#define ATARI_INPUT_JOY_RIGHT	5	// a=set b=reset
+#define ATARI_INPUT_PADDLE	6	// a=paddle b=val
+#define ATARI_INPUT_RESET	7
+
 class Atari2600 {
 private:
 	Cpu6502		cpu;
 	Atari2600Hw	atarihw;
+	StateWriter	hashw;
 	int		cpudiv3;
 	bool		rdy;
+
+	std::function<void (int, int, int)> input_cb;
+	void		report(int type, int a, int b)
+	{
+		if (input_cb)
+			input_cb(type, a, b);
+	}
 public:
 	Atari2600(Atari2600Video *_video = 0);
 
 	void		reset(void);
 	bool		cycle(void);
+	void		catchUp(void)
+	{ atarihw.catchUp(); }
 
 	void		setVideo(Atari2600Video *_video)
 	{ atarihw.setVideo(_video); }
+	void		setAudioRing(AudioRing *_ring)
+	{ atarihw.setAudioRing(_ring); }
 
 	void		readRam(uint16_t addr, uint8_t *data, int length)
 	{ atarihw.readRam(addr, data, length); }
 	void		writeRam(uint16_t addr, const uint8_t *data,
 			int length)
 	{ atarihw.writeRam(addr, data, length); }
+	void		setRom(ImageRef image)
+	{ atarihw.setRom(image); }
 	void		setRom(const uint8_t *data, int length)
 	{ atarihw.setRom(data, length); }
 	void		setRdy(bool _rdy)
@@ -73,22 +104,57 @@ public:
 	{ return this->atarihw.getCycleCounter(); }
 
 	void		setDiffLeft(bool _val)
-	{ atarihw.setDiffLeft(_val); }
+	{
+		atarihw.setDiffLeft(_val);
+		report(ATARI_INPUT_DIFF_LEFT, _val, 0);
+	}
 	void		setDiffRight(bool _val)
-	{ atarihw.setDiffRight(_val); }
+	{
+		atarihw.setDiffRight(_val);
+		report(ATARI_INPUT_DIFF_RIGHT, _val, 0);
+	}
 	void		setSelect(bool _val)
-	{ atarihw.setSelect(_val); }
+	{
+		atarihw.setSelect(_val);
+		report(ATARI_INPUT_SELECT, _val, 0);
+	}
 	void		setStart(bool _val)
-	{ atarihw.setStart(_val); }
+	{
+		atarihw.setStart(_val);
+		report(ATARI_INPUT_START, _val, 0);
+	}
 	void		setJoyLeft(uint8_t _set, uint8_t _reset)
-	{ atarihw.setJoyLeft(_set, _reset); }
+	{
+		atarihw.setJoyLeft(_set, _reset);
+		report(ATARI_INPUT_JOY_LEFT, _set, _reset);
+	}
 	void		setJoyRight(uint8_t _set, uint8_t _reset)
-	{ atarihw.setJoyRight(_set, _reset); }
+	{
+		atarihw.setJoyRight(_set, _reset);
+		report(ATARI_INPUT_JOY_RIGHT, _set, _reset);
+	}
 	void		setPaddle(int p, int val)
-	{ atarihw.setPaddle(p, val); }
+	{
+		atarihw.setPaddle(p, val);
+		report(ATARI_INPUT_PADDLE, p, val);
+	}
+	void		input(int type, int a, int b);
+	void		setInputCallback(std::function<void (int, int, int)>
+					 _cb)
+	{ this->input_cb = _cb; }
 
 	Cpu6502		*getCpu(void)
 	{ return &cpu; }
+	DirtyPages	*getDirtyPages(void)
+	{ return atarihw.getDirtyPages(); }
+
+	void		saveState(StateWriter &w);
+	bool		loadState(StateReader &r);
+	uint64_t	stateHash(void);
+	// Cartridge loaded, for telling apart states that need different
+	// ones.
+	uint64_t	romHash(void) const
+	{ return atarihw.romHash(); }
 };
 
 #endif // __ATARI2600_H__
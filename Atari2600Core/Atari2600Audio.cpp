@@ -0,0 +1,305 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Atari2600Audio.cpp
+//
+// Sound generation follows the TIA's divider and polynomial counter
+// logic: each channel's divider (AUDF+1, times 3 for AUDC 12-15) clocks
+// a 5-bit poly or divide-by-31 gate which in turn clocks a pure tone,
+// a 4-bit poly, a 5-bit poly or a 9-bit poly.
+
+#include <stdint.h>
+
+#include "Atari2600Audio.h"
+#include "AudioRing.h"
+#include "SaveState.h"
+
+#ifdef DEBUGAUDIO
+extern unsigned int cycles;
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGAUDIO) printf("[%d] " f, cycles, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+#define COLOR_CLOCK	3579545		// Hz
+#define AUDIO_DIV	114		// color clocks per audio clock
+
+#define AUDC_MASK	0x0f
+#define AUDF_MASK	0x1f
+#define AUDV_MASK	0x0f
+#define    AUDC_SET1	0x00		// output is just volume
+#define    AUDC_SET1B	0x0b
+#define    AUDC_POLY9	0x08
+#define    AUDC_DIV3	0x0c		// both bits set: divide by 3
+
+#define POLY4_SIZE	15
+#define POLY5_SIZE	31
+#define POLY9_SIZE	511
+
+#define SAMPLE_SCALE	1024		// sum of volumes (0-30) to 16 bits
+
+// Polynomial counter output patterns shared by all channels.
+static uint8_t bit4[POLY4_SIZE];
+static uint8_t bit5[POLY5_SIZE];
+static uint8_t bit9[POLY9_SIZE];
+static uint8_t div31[POLY5_SIZE];
+static bool tables_built;
+
+// Run a linear feedback shift register of n bits with feedback from
+// bits 0 and tap and record its output.
+static void
+buildPoly(uint8_t *bits, int n, int tap)
+{
+	int size = (1 << n) - 1;
+	int reg = size;
+
+	for (int i = 0; i < size; i++) {
+		bits[i] = reg & 1;
+		reg = (reg >> 1) | (((reg ^ (reg >> tap)) & 1) << (n - 1));
+	}
+}
+
+static void
+buildTables(void)
+{
+	buildPoly(bit4, 4, 1);		// x^4 + x^3 + 1
+	buildPoly(bit5, 5, 2);		// x^5 + x^3 + 1
+	buildPoly(bit9, 9, 4);		// x^9 + x^5 + 1
+
+	// Divide by 31 has two uneven halves.
+	div31[0] = 1;
+	div31[18] = 1;
+
+	tables_built = true;
+}
+
+Atari2600Audio::Atari2600Audio()
+{
+	DPRINTF(1, "Atari2600Audio::%s:\n", __func__);
+
+	if (!tables_built)
+		buildTables();
+
+	ring = nullptr;
+
+	reset();
+}
+
+void
+Atari2600Audio::reset(void)
+{
+	DPRINTF(1, "Atari2600Audio::%s:\n", __func__);
+
+	for (int chan = 0; chan < 2; chan++) {
+		audc[chan] = 0;
+		audf[chan] = 0;
+		audv[chan] = 0;
+		div_max[chan] = 0;
+		div_cnt[chan] = 0;
+		p4[chan] = 0;
+		p5[chan] = 0;
+		p9[chan] = 0;
+		outvol[chan] = 0;
+	}
+
+	clk = 0;
+	phase = 0;
+	prev = 0;
+	nblock = 0;
+}
+
+// Recompute channel divider after a register write.
+void
+Atari2600Audio::update(int chan)
+{
+	int n;
+
+	if (audc[chan] == AUDC_SET1 || audc[chan] == AUDC_SET1B) {
+		n = 0;
+		outvol[chan] = audv[chan];
+	} else {
+		n = audf[chan] + 1;
+		if ((audc[chan] & AUDC_DIV3) == AUDC_DIV3)
+			n *= 3;
+	}
+
+	if (n != div_max[chan]) {
+		div_max[chan] = n;
+		if (div_cnt[chan] == 0 || n == 0)
+			div_cnt[chan] = n;
+	}
+}
+
+void
+Atari2600Audio::setAudc(int chan, uint8_t d8)
+{
+	DPRINTF(2, "Atari2600Audio::%s: chan=%d d8=0x%02x\n", __func__,
+		chan, d8);
+
+	audc[chan] = d8 & AUDC_MASK;
+	update(chan);
+}
+
+void
+Atari2600Audio::setAudf(int chan, uint8_t d8)
+{
+	DPRINTF(2, "Atari2600Audio::%s: chan=%d d8=0x%02x\n", __func__,
+		chan, d8);
+
+	audf[chan] = d8 & AUDF_MASK;
+	update(chan);
+}
+
+void
+Atari2600Audio::setAudv(int chan, uint8_t d8)
+{
+	DPRINTF(2, "Atari2600Audio::%s: chan=%d d8=0x%02x\n", __func__,
+		chan, d8);
+
+	audv[chan] = d8 & AUDV_MASK;
+	update(chan);
+}
+
+// One audio clock: step both channels and resample their sum.
+void
+Atari2600Audio::tick(void)
+{
+	for (int chan = 0; chan < 2; chan++) {
+		if (div_cnt[chan] > 1) {
+			div_cnt[chan]--;
+			continue;
+		} else if (div_cnt[chan] == 0)
+			continue;
+
+		div_cnt[chan] = div_max[chan];
+
+		uint8_t c = audc[chan];
+
+		if (++p5[chan] == POLY5_SIZE)
+			p5[chan] = 0;
+
+		// Is the 5-bit poly or divide by 31 letting this clock by?
+		if ((c & 0x02) != 0 && !((c & 0x01) != 0 ? bit5[p5[chan]] :
+					  div31[p5[chan]]))
+			continue;
+
+		if ((c & 0x04) != 0) {
+			// Pure tones.
+			outvol[chan] = outvol[chan] ? 0 : audv[chan];
+		} else if (c == AUDC_POLY9) {
+			if (++p9[chan] == POLY9_SIZE)
+				p9[chan] = 0;
+			outvol[chan] = bit9[p9[chan]] ? audv[chan] : 0;
+		} else if ((c & 0x08) != 0) {
+			outvol[chan] = bit5[p5[chan]] ? audv[chan] : 0;
+		} else {
+			if (++p4[chan] == POLY4_SIZE)
+				p4[chan] = 0;
+			outvol[chan] = bit4[p4[chan]] ? audv[chan] : 0;
+		}
+	}
+
+	int16_t cur = (outvol[0] + outvol[1]) * SAMPLE_SCALE;
+
+	// Linear interpolation between audio clock samples.  Positions are
+	// in units of 1 / (AUDIO_DIV * ATARI_AUDIO_RATE) audio clock so the
+	// rate ratio is exact.
+	while (phase < AUDIO_DIV * ATARI_AUDIO_RATE) {
+		block[nblock++] = prev + (int64_t)(cur - prev) * phase /
+			(AUDIO_DIV * ATARI_AUDIO_RATE);
+		if (nblock == ATARI_AUDIO_BLOCK)
+			flush();
+		phase += COLOR_CLOCK;
+	}
+	phase -= AUDIO_DIV * ATARI_AUDIO_RATE;
+	prev = cur;
+}
+
+// Run n color clocks worth of audio.
+void
+Atari2600Audio::clock(int n)
+{
+	clk += n;
+	while (clk >= AUDIO_DIV) {
+		clk -= AUDIO_DIV;
+		tick();
+	}
+}
+
+// Hand any samples generated so far to the ring.
+void
+Atari2600Audio::flush(void)
+{
+	if (ring && nblock > 0)
+		ring->write(block, nblock);
+	nblock = 0;
+}
+
+// Channel registers, dividers and resampler position.  Samples not yet
+// handed to the ring are output, not state.
+void
+Atari2600Audio::saveState(StateWriter &w)
+{
+	w.beginChunk("AUD ");
+	for (int chan = 0; chan < 2; chan++) {
+		w.put8(audc[chan]);
+		w.put8(audf[chan]);
+		w.put8(audv[chan]);
+		w.putInt(div_max[chan]);
+		w.putInt(div_cnt[chan]);
+		w.putInt(p4[chan]);
+		w.putInt(p5[chan]);
+		w.putInt(p9[chan]);
+		w.put8(outvol[chan]);
+	}
+	w.putInt(clk);
+	w.put32(phase);
+	w.put16(prev);
+	w.endChunk();
+}
+
+void
+Atari2600Audio::loadState(StateReader &r)
+{
+	if (!r.openChunk("AUD "))
+		return;
+	for (int chan = 0; chan < 2; chan++) {
+		audc[chan] = r.get8();
+		audf[chan] = r.get8();
+		audv[chan] = r.get8();
+		div_max[chan] = r.getInt();
+		div_cnt[chan] = r.getInt();
+		p4[chan] = r.getInt();
+		p5[chan] = r.getInt();
+		p9[chan] = r.getInt();
+		outvol[chan] = r.get8();
+	}
+	clk = r.getInt();
+	phase = r.get32();
+	prev = (int16_t)r.get16();
+	r.endChunk();
+}
@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+#ifndef __ATARI2600AUDIO_H__
+#define __ATARI2600AUDIO_H__
+
+#include <stdint.h>
+
+class AudioRing;
+class StateWriter;
+class StateReader;
+
+#define ATARI_AUDIO_RATE	48000	// output sample rate
+#define ATARI_AUDIO_BLOCK	256	// samples per block written to ring
+
+// The two TIA sound channels.  The TIA hands over color clocks in batches
+// whenever it catches up and we run the 31.4 kHz audio clock from those,
+// resampling to ATARI_AUDIO_RATE.
+class Atari2600Audio {
+private:
+	AudioRing *ring;
+
+	uint8_t	audc[2];	// audio control
+	uint8_t	audf[2];	// audio frequency
+	uint8_t	audv[2];	// audio volume
+
+	int	div_max[2];	// frequency divider
+	int	div_cnt[2];
+	int	p4[2];		// positions in polynomial patterns
+	int	p5[2];
+	int	p9[2];
+	uint8_t	outvol[2];
+
+	int	clk;		// color clocks toward next audio clock
+	uint32_t phase;		// resampler position between audio samples
+	int16_t	prev;		// previous audio clock sample
+	int16_t	block[ATARI_AUDIO_BLOCK];
+	int	nblock;
+
+	void	update(int chan);
+	void	tick(void);
+public:
+	Atari2600Audio();
+
+	void	reset(void);
+	void	clock(int n);
+	void	flush(void);
+
+	void	setAudc(int chan, uint8_t d8);
+	void	setAudf(int chan, uint8_t d8);
+	void	setAudv(int chan, uint8_t d8);
+	void	saveState(StateWriter &w);
+	void	loadState(StateReader &r);
+
+	void	setRing(AudioRing *_ring)
+	{ this->ring = _ring; }
+};
+
+#endif // __ATARI2600AUDIO_H__
@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Atari2600Frame.cpp
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Atari2600Frame.h"
+#include "SaveState.h"
+#include "StateHash.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <immintrin.h>
+#  define HAVE_AVX2_GATHER
+#endif
+
+void
+Atari2600Frame::reset(void)
+{
+	memset(pixels, 0, sizeof(pixels));
+
+	uint64_t h = lineHash(pixels[0]);
+	for (int i = 0; i < ATARI_FRAME_LINES; i++)
+		hashes[i] = h;
+
+	vline = 0;
+	nlines = 0;
+}
+
+uint64_t
+Atari2600Frame::lineHash(const uint8_t *line)
+{
+	return hashWords(line, ATARI_NATIVE_WIDTH);
+}
+
+// Called by the TIA at the end of each scanline.
+void
+Atari2600Frame::addLine(const uint8_t colu[])
+{
+	if (vline < ATARI_FRAME_LINES) {
+		memcpy(pixels[vline], colu, ATARI_NATIVE_WIDTH);
+		hashes[vline] = lineHash(pixels[vline]);
+	}
+	vline++;
+}
+
+// Called on the leading edge of VSYNC.  Lines the previous frame drew
+// past the bottom of this one are blanked.
+void
+Atari2600Frame::vsync(void)
+{
+	int y = vline < ATARI_FRAME_LINES ? vline : ATARI_FRAME_LINES;
+
+	if (y < nlines) {
+		memset(pixels[y], 0, (nlines - y) * ATARI_NATIVE_WIDTH);
+
+		uint64_t h = lineHash(pixels[y]);
+		for (int i = y; i < nlines; i++)
+			hashes[i] = h;
+	}
+
+	nlines = y;
+	vline = 0;
+}
+
+// Only the lines drawn so far this frame.  Saving at a frame boundary
+// stores almost nothing.
+void
+Atari2600Frame::saveState(StateWriter &w)
+{
+	int y = vline < ATARI_FRAME_LINES ? vline : ATARI_FRAME_LINES;
+
+	w.beginChunk("FRAM");
+	w.putInt(vline);
+	w.putInt(nlines);
+	w.putRam(pixels[0], y * ATARI_NATIVE_WIDTH);
+	w.endChunk();
+}
+
+// Lines below the ones restored are blanked.  They would be drawn over,
+// or blanked by vsync(), before the frame is seen.
+void
+Atari2600Frame::loadState(StateReader &r)
+{
+	if (!r.openChunk("FRAM"))
+		return;
+	vline = r.getInt();
+	nlines = r.getInt();
+	if (vline < 0 || nlines < 0 || nlines > ATARI_FRAME_LINES) {
+		r.fail();
+		reset();
+		return;
+	}
+	int y = vline < ATARI_FRAME_LINES ? vline : ATARI_FRAME_LINES;
+	r.getRam(pixels[0], y * ATARI_NATIVE_WIDTH);
+	r.endChunk();
+
+	for (int i = 0; i < y; i++)
+		hashes[i] = lineHash(pixels[i]);
+	memset(pixels[y], 0, (ATARI_FRAME_LINES - y) * ATARI_NATIVE_WIDTH);
+	uint64_t h = lineHash(pixels[y]);
+	for (int i = y; i < ATARI_FRAME_LINES; i++)
+		hashes[i] = h;
+}
+
+#ifdef HAVE_AVX2_GATHER
+__attribute__((target("avx2")))
+static void
+toRgbaAvx2(const uint8_t colu[], uint32_t *dst, const uint32_t palette[],
+	   int n)
+{
+	int i;
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		__m128i c8 = _mm_loadl_epi64((const __m128i *)&colu[i]);
+		__m256i idx = _mm256_srli_epi32(_mm256_cvtepu8_epi32(c8), 1);
+		__m256i rgba = _mm256_i32gather_epi32((const int *)palette,
+						      idx, 4);
+		_mm256_storeu_si256((__m256i *)&dst[i], rgba);
+	}
+	for (; i < n; i++)
+		dst[i] = palette[colu[i] >> 1];
+}
+#endif
+
+// Convert a line of COLU values to 32-bit pixels using a 128 entry
+// palette.  Uses an AVX2 gather when the host has one.
+void
+Atari2600Frame::toRgba(const uint8_t colu[], uint32_t *dst,
+		       const uint32_t palette[], int n)
+{
+#ifdef HAVE_AVX2_GATHER
+	static const bool have_avx2 = __builtin_cpu_supports("avx2");
+
+	if (have_avx2) {
+		toRgbaAvx2(colu, dst, palette, n);
+		return;
+	}
+#endif
+	for (int i = 0; i < n; i++)
+		dst[i] = palette[colu[i] >> 1];
+}
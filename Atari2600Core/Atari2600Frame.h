@@ -0,0 +1,76 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Atari2600Frame.h
+//
+//	Core-owned frame buffer.  The TIA stores each scanline as COLU
+//	values (the palette index is COLU >> 1) and a hash of every line
+//	so consumers only need to convert lines that changed.
+//
+
+#ifndef __ATARI2600FRAME_H__
+#define __ATARI2600FRAME_H__
+
+#include <stdint.h>
+
+#include "Atari2600Video.h"
+
+#define ATARI_FRAME_LINES	320	// enough for PAL plus some slop
+#define ATARI_PALETTE_SIZE	128
+
+class StateWriter;
+class StateReader;
+
+class Atari2600Frame {
+private:
+	// Extra row at the bottom absorbs lines past ATARI_FRAME_LINES.
+	uint8_t		pixels[ATARI_FRAME_LINES + 1][ATARI_NATIVE_WIDTH];
+	uint64_t	hashes[ATARI_FRAME_LINES];
+	int		vline;
+	int		nlines;
+
+	static uint64_t	lineHash(const uint8_t *line);
+public:
+	Atari2600Frame() { reset(); }
+
+	void		reset(void);
+	void		addLine(const uint8_t colu[]);
+	void		vsync(void);
+	void		saveState(StateWriter &w);
+	void		loadState(StateReader &r);
+
+	// Consumer interface.
+	int		getLines(void) const
+	{ return nlines; }
+	const uint8_t	*getLine(int y) const
+	{ return pixels[y]; }
+	uint64_t	getLineHash(int y) const
+	{ return hashes[y]; }
+
+	static void	toRgba(const uint8_t colu[], uint32_t *dst,
+			       const uint32_t palette[], int n);
+};
+
+#endif // __ATARI2600FRAME_H__
@@ -30,6 +30,7 @@
 #include "Atari2600.h"
 #include "Atari2600Hw.h"
 #include "Atari2600Video.h"
+#include "SaveState.h"
 
 #ifdef DEBUGIO
 extern unsigned int cycles;
@@ -108,21 +109,49 @@ Atari2600Hw::writeRam(uint16_t addr, const uint8_t *data, int len)
 	DPRINTF(4, "Atari2600Hw::%s:addr=0x%04x len=%d\n", __func__,
 		addr, len);
 
-	for (int i = 0; i < len; i++)
-		ram[(addr & RAM_MASK) + i] = data[i];
+	for (int i = 0; i < len; i++) {
+		int a = (addr & RAM_MASK) + i;
+		ramhash.write(a, ram[a], data[i]);
+		ram[a] = data[i];
+	}
+	dirty.mark(0);
 }
 
+// Use a copy of data as the cartridge.
 void
 Atari2600Hw::setRom(const uint8_t *data, int len)
 {
+	setRom(Image::copy(data, len));
+}
+
+// Use a cartridge image, shared if it is 4K or 8K.  Other sizes get a
+// copy of their own filled out to one of those, with a 2K cartridge
+// showing up twice as it does on the real thing.
+void
+Atari2600Hw::setRom(ImageRef image)
+{
+	int len = image->getSize();
+
 	DPRINTF(4, "Atari2600Hw::%s: len=%d\n", __func__, len);
 
+	if (len <= 0)
+		return;
 	if (len > ROM_MAX_SIZE)
 		len = ROM_MAX_SIZE;
 
-	for (int i = 0; i < len; i++)
-		rom[i] = data[i];
+	if (len != BANK_SIZE && len != ROM_MAX_SIZE) {
+		const uint8_t *data = image->getData();
+		int size = len > BANK_SIZE ? ROM_MAX_SIZE : BANK_SIZE;
+		std::vector<uint8_t> buf(size, 0);
+
+		for (int i = 0; i < size; i++)
+			if (size % len == 0 || i < len)
+				buf[i] = data[i % len];
+		image = Image::adopt(std::move(buf));
+	}
 
+	cart = image;
+	rom = cart->getData();
 	romsz = len;
 	bank = false;
 }
@@ -208,8 +237,11 @@ Atari2600Hw::write(uint16_t addr, uint8_t d8)
 			bank = false;
 	}
 	// A12=0, A7=1, A9=0: RAM
-	else if ((addr & 0x280) == 0x80)
+	else if ((addr & 0x280) == 0x80) {
+		ramhash.write(addr & RAM_MASK, ram[addr & RAM_MASK], d8);
 		ram[addr & RAM_MASK] = d8;
+		dirty.mark(addr & RAM_MASK);
+	}
 	// A12=0, A7=1, A9=1: RIOT
 	else if ((addr & 0x280) == 0x280)
 		riot.write(addr & RIOT_MASK, d8);
@@ -217,3 +249,59 @@ Atari2600Hw::write(uint16_t addr, uint8_t d8)
 	else
 		tia.write(addr & TIA_MASK, d8);
 }
+
+// RAM, bank and paddles, then the chips and video.  The cartridge is
+// loaded media and not saved.
+void
+Atari2600Hw::saveState(StateWriter &w)
+{
+	w.beginChunk("HW  ");
+	w.putBytes(ram, RAM_SIZE);
+	w.putBool(bank);
+	for (int i = 0; i < NUMPADDLES; i++)
+		w.putInt(paddle_val[i]);
+	w.putInt(paddle_ctr);
+	w.endChunk();
+
+	tia.saveState(w);
+	riot.saveState(w);
+	if (video)
+		video->saveState(w);
+}
+
+void
+Atari2600Hw::loadState(StateReader &r)
+{
+	if (!r.openChunk("HW  "))
+		return;
+	r.getBytes(ram, RAM_SIZE);
+	bank = r.getBool();
+	for (int i = 0; i < NUMPADDLES; i++)
+		paddle_val[i] = r.getInt();
+	paddle_ctr = r.getInt();
+	r.endChunk();
+	dirty.markAll();
+	ramhash.rehash(ram, RAM_SIZE);
+
+	tia.loadState(r);
+	riot.loadState(r);
+	if (video)
+		video->loadState(r);
+}
+
+// The RAM hash kept up on writes, and a hash of the rest of the state
+// added on to w.
+uint64_t
+Atari2600Hw::stateHash(StateWriter &w)
+{
+	w.putBool(bank);
+	for (int i = 0; i < NUMPADDLES; i++)
+		w.putInt(paddle_val[i]);
+	w.putInt(paddle_ctr);
+	tia.saveState(w);
+	riot.saveState(w);
+	if (video)
+		video->saveState(w);
+
+	return ramhash.get() ^ hashBytes(w.getData(), w.getSize());
+}
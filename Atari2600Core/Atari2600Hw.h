@@ -29,12 +29,17 @@
 #define __ATARI2600HW_H__
 
 #include "MemSpace.h"
+#include "DirtyPages.h"
+#include "StateHash.h"
+#include "Image.h"
 
 #include "Atari2600TIA.h"
 #include "Mos6532Riot.h"
 
 class Atari2600;
 class Atari2600Video;
+class StateWriter;
+class StateReader;
 
 #define RAM_SIZE	128
 #define ROM_MAX_SIZE	8192
@@ -48,17 +53,30 @@ private:
 	Atari2600TIA	tia;
 	Mos6532Riot	riot;
 	uint8_t		ram[RAM_SIZE];
-	uint8_t		rom[ROM_MAX_SIZE];
+	ImageRef	cart;		// shared
+	const uint8_t	*rom;
 	int		romsz;
 	bool		bank;
 	int 		paddle_val[NUMPADDLES];
 	int 		paddle_ctr;
+	DirtyPages	dirty;		// all of RAM is page 0
+	RamHash		ramhash;
 public:
 	Atari2600Hw(Atari2600 *_atari) :
 		video(0),
 		tia(_atari),
-		romsz(0)
-	{ }
+		romsz(0),
+		bank(false),
+		paddle_ctr(0)
+	{
+		static const uint8_t blank[ROM_MAX_SIZE] = { 0 };
+
+		rom = blank;
+		memset(ram, 0, sizeof(ram));
+		ramhash.rehash(ram, RAM_SIZE);
+		for (int i = 0; i < NUMPADDLES; i++)
+			paddle_val[i] = 0;
+	}
 
 	uint8_t	read(uint16_t addr);
 	void	write(uint16_t addr, uint8_t d8);
@@ -66,15 +84,20 @@ public:
 	void	reset(void);
 	void	cycle(void);
 	void	cycle3(void);
+	void	catchUp(void)
+	{ tia.catchUp(); }
 
 	void	writeRam(uint16_t addr, const uint8_t *data, int len);
 	void	readRam(uint16_t addr, uint8_t *data, int len);
 	void	setRom(const uint8_t *data, int len);
+	void	setRom(ImageRef image);
 	void	setVideo(Atari2600Video *_video)
 	{
 		this->video = _video;
 		tia.setVideo(_video);
 	}
+	void	setAudioRing(AudioRing *_ring)
+	{ tia.setAudioRing(_ring); }
 
 	void	setDiffLeft(bool _val)
 	{ riot.setPortB(_val ? 0x40 : 0, 0x40); }
@@ -87,6 +110,13 @@ public:
 	void	setJoyLeft(uint8_t _set, uint8_t _reset);
 	void	setJoyRight(uint8_t _set, uint8_t _reset);
 	void	setPaddle(int p, int val);
+	DirtyPages *getDirtyPages(void)
+	{ return &dirty; }
+	void	saveState(StateWriter &w);
+	void	loadState(StateReader &r);
+	uint64_t stateHash(StateWriter &w);
+	uint64_t romHash(void) const
+	{ return hashBytes(rom, romsz); }
 	int	*getCycleCounter(void)
 	{ return this->tia.getCycleCounter(); }
 };
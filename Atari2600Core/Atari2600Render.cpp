@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Atari2600Render.cpp
+
+#include <stdint.h>
+
+#include "Atari2600Render.h"
+#include "SaveState.h"
+
+#ifdef DEBUGVID
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGVID) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+extern const uint8_t colortab[];
+
+Atari2600Render::Atari2600Render()
+	: fb(ATARI_NATIVE_WIDTH, ATARI_VID_HEIGHT)
+{
+	DPRINTF(1, "Atari2600Render::%s:\n", __func__);
+
+	for (int i = 0; i < ATARI_PALETTE_SIZE; i++)
+		fb.setPalette(i, colortab[i * 3], colortab[i * 3 + 1],
+			      colortab[i * 3 + 2]);
+
+	reset();
+}
+
+void
+Atari2600Render::reset(void)
+{
+	DPRINTF(1, "Atari2600Render::%s:\n", __func__);
+
+	lines_since_vsync = 0;
+	last_vheight = 999;
+
+	clearFrame();
+}
+
+// Blank the frame and forget line hashes so every line is redrawn
+// on the next frame.
+void
+Atari2600Render::clearFrame(void)
+{
+	DPRINTF(4, "Atari2600Render::%s:\n", __func__);
+
+	redraw();
+	if (fb.isActive())
+		fb.fill(0);
+}
+
+// Forget what was drawn, e.g. after the buffer changes.
+void
+Atari2600Render::redraw(void)
+{
+	for (int y = 0; y < ATARI_VID_HEIGHT; y++)
+		line_hash[y] = 0;
+}
+
+// Convert lines of the TIA frame that changed since they were last
+// drawn.
+void
+Atari2600Render::vsync(const Atari2600Frame *frame)
+{
+	DPRINTF(5, "Atari2600Render::%s: lines=%d\n", __func__,
+		frame->getLines());
+
+	last_vheight = frame->getLines();
+	lines_since_vsync = 0;
+
+	if (!fb.isActive())
+		return;
+
+	for (int y = 0; y < ATARI_VID_HEIGHT; y++) {
+		uint64_t h = frame->getLineHash(ATARI_VID_VBLANK + y);
+
+		if (h == line_hash[y])
+			continue;
+
+		const uint8_t *colu = frame->getLine(ATARI_VID_VBLANK + y);
+		uint8_t *row = fb.getRow(y);
+
+		if (fb.getFormat() == FB_RGBA)
+			Atari2600Frame::toRgba(colu, (uint32_t *)row,
+					       fb.getPalette(),
+					       ATARI_NATIVE_WIDTH);
+		else
+			for (int x = 0; x < ATARI_NATIVE_WIDTH; x++)
+				row[x] = colu[x] >> 1;
+
+		line_hash[y] = h;
+		fb.markDirty(y, y);
+	}
+
+	fb.frameComplete();
+}
+
+void
+Atari2600Render::hsync(void)
+{
+	if (++lines_since_vsync == 600) {
+		// No vsync in roughly 38ms
+		DPRINTF(4, "Atari2600Render::%s: missing vsync.\n", __func__);
+		last_vheight = 999;
+		if (fb.isActive()) {
+			clearFrame();
+			fb.frameComplete();
+		}
+	}
+}
+
+// Just the vsync watchdog.  The picture is redrawn from the TIA's frame
+// on the next vsync.
+void
+Atari2600Render::saveState(StateWriter &w)
+{
+	w.beginChunk("TVID");
+	w.putInt(lines_since_vsync);
+	w.putInt(last_vheight);
+	w.endChunk();
+}
+
+void
+Atari2600Render::loadState(StateReader &r)
+{
+	if (!r.findChunk("TVID"))
+		return;
+	lines_since_vsync = r.getInt();
+	last_vheight = r.getInt();
+	r.endChunk();
+}
@@ -0,0 +1,68 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Atari2600Render.h
+//
+//	Copies the visible part of the TIA's frame into a core FrameBuffer.
+//	Palette indices are COLU >> 1.
+//
+
+#ifndef __ATARI2600RENDER_H__
+#define __ATARI2600RENDER_H__
+
+#include "Atari2600Video.h"
+#include "Atari2600Frame.h"
+#include "FrameBuffer.h"
+
+#define ATARI_VID_HEIGHT	212	// larger than 192 native height
+#define ATARI_VID_VBLANK	30	// skip lines, including sync pulse
+
+class Atari2600Render : public Atari2600Video {
+protected:
+	FrameBuffer	fb;
+
+	uint64_t	line_hash[ATARI_VID_HEIGHT];
+	unsigned int	lines_since_vsync;
+	int		last_vheight;
+
+	void		clearFrame(void);
+public:
+	Atari2600Render();
+
+	void		redraw(void);
+	FrameBuffer	*getFrameBuffer(void)
+	{ return &this->fb; }
+	int		getVHeight(void)	// 999 if no vsync
+	{ return this->last_vheight; }
+
+	// Atari2600Video interface
+	void		vsync(const Atari2600Frame *frame);
+	void		hsync(void);
+	void		reset(void);
+	void		saveState(StateWriter &w);
+	void		loadState(StateReader &r);
+};
+
+#endif // __ATARI2600RENDER_H__
@@ -26,10 +26,12 @@
 // Atari2600TIA.cpp
 
 #include <stdint.h>
+#include <string.h>
 
 #include "Atari2600.h"
 #include "Atari2600TIA.h"
 #include "Atari2600Video.h"
+#include "SaveState.h"
 
 #ifdef DEBUGIO
 extern unsigned int cycles;
@@ -145,8 +147,152 @@ extern unsigned int cycles;
 #define INPT5	0x0d
 #define    INPT_D	0x80
 
+// Collision latch bits.  Each pair is read at D7 and D6 of CXM0P-CXPPMM.
+#define CX_M0P0	(1 << 0)
+#define CX_M0P1	(1 << 1)
+#define CX_M1P1	(1 << 2)
+#define CX_M1P0	(1 << 3)
+#define CX_P0BL	(1 << 4)
+#define CX_P0PF	(1 << 5)
+#define CX_P1BL	(1 << 6)
+#define CX_P1PF	(1 << 7)
+#define CX_M0BL	(1 << 8)
+#define CX_M0PF	(1 << 9)
+#define CX_M1BL	(1 << 10)
+#define CX_M1PF	(1 << 11)
+#define CX_BLPF	(1 << 13)
+#define CX_M0M1	(1 << 14)
+#define CX_P0P1	(1 << 15)
+
 #define TIA_RA_MASK 0x0f
 
+// Object bits used to index the color and collision tables.
+#define OBJ_P0	(1 << 0)
+#define OBJ_M0	(1 << 1)
+#define OBJ_P1	(1 << 2)
+#define OBJ_M1	(1 << 3)
+#define OBJ_BL	(1 << 4)
+#define OBJ_PF	(1 << 5)
+#define OBJ_NUM	64
+
+// Where a player or missile is in its drawing, used by doSpan().
+#define SPAN_NONE	0	// counters in some odd state
+#define SPAN_IDLE	1	// not drawing anything
+#define SPAN_SYNC	2	// drawing as copy_pos[] predicts
+
+// Starting counter values of player and missile copies for each NUSIZ.
+static const int ncopies[8] = { 1, 2, 2, 3, 2, 1, 3, 1 };
+static const int copy_pos[8][3] = {
+	{ 0 }, { 0, 16 }, { 0, 32 }, { 0, 16, 32 },
+	{ 0, 64 }, { 0 }, { 0, 32, 64 }, { 0 }
+};
+
+// Lookup tables shared by all TIAs, built once by buildTables().  Masks
+// have one bit for each horizontal position counter value.
+#define MASK_BYTES	20
+#define MASK_BIT(m, h)	(((m)[(h) >> 3] >> ((h) & 7)) & 1)
+#define PLAYER_CNTS	34
+static uint8_t player_bit[8][2][PLAYER_CNTS];	// GRP bit by counter
+static uint8_t player_mask[8][2][256][MASK_BYTES]; // NUSIZ, REFP, GRP
+static uint8_t missile_mask[8][4][MASK_BYTES];	// NUSIZ copies and size
+static uint8_t start_mask[8][MASK_BYTES];	// where copies start
+static uint16_t cx_table[OBJ_NUM];		// collisions by objects
+static bool tables_built;
+
+// Return the last player counter value that draws a pixel.
+static int
+playerLen(uint8_t nusiz)
+{
+	switch (nusiz & NUSIZ_P_MASK) {
+	case 5:
+		return 17;	// double-wide
+	case 7:
+		return 33;	// quad-wide
+	default:
+		return 8;
+	}
+}
+
+// Return pixel of player graphics for a player counter value.
+static inline bool
+playerPix(int cnt, uint8_t grp, uint8_t nusiz, bool ref)
+{
+	return (grp & player_bit[nusiz & NUSIZ_P_MASK][ref][cnt]) != 0;
+}
+
+static void
+buildTables(void)
+{
+	for (int c = 0; c < 8; c++) {
+		int len = playerLen(c);
+
+		// Which GRP bit each player counter value draws.  The first
+		// clock of a wide player has no pixel.
+		for (int ref = 0; ref < 2; ref++)
+			for (int cnt = 0; cnt < PLAYER_CNTS; cnt++) {
+				int n;
+
+				if (c == 5)
+					n = (cnt - 2) >> 1;
+				else if (c == 7)
+					n = (cnt - 2) >> 2;
+				else
+					n = cnt - 1;
+
+				player_bit[c][ref][cnt] =
+					n < 0 || cnt > len ? 0 :
+					1 << (ref ? n : 7 - n);
+			}
+
+		for (int i = 0; i < ncopies[c]; i++) {
+			int s = copy_pos[c][i];
+
+			start_mask[c][s >> 3] |= 1 << (s & 7);
+
+			for (int ref = 0; ref < 2; ref++)
+				for (int grp = 0; grp < 256; grp++)
+					for (int d = 1; d <= len; d++) {
+						int h = (s + d) % 160;
+						uint8_t *m =
+						    player_mask[c][ref][grp];
+
+						if (!playerPix(d, grp, c, ref))
+							continue;
+						m[h >> 3] |= 1 << (h & 7);
+					}
+
+			for (int sz = 0; sz < 4; sz++)
+				for (int d = 0; d < (1 << sz); d++) {
+					int h = (s + d) % 160;
+
+					missile_mask[c][sz][h >> 3] |=
+						1 << (h & 7);
+				}
+		}
+	}
+
+	for (int objs = 0; objs < OBJ_NUM; objs++) {
+		bool p0 = (objs & OBJ_P0) != 0;
+		bool m0 = (objs & OBJ_M0) != 0;
+		bool p1 = (objs & OBJ_P1) != 0;
+		bool m1 = (objs & OBJ_M1) != 0;
+		bool bl = (objs & OBJ_BL) != 0;
+		bool pf = (objs & OBJ_PF) != 0;
+
+		cx_table[objs] =
+			(m0 && p1 ? CX_M0P1 : 0) | (m0 && p0 ? CX_M0P0 : 0) |
+			(m1 && p0 ? CX_M1P0 : 0) | (m1 && p1 ? CX_M1P1 : 0) |
+			(p0 && pf ? CX_P0PF : 0) | (p0 && bl ? CX_P0BL : 0) |
+			(p1 && pf ? CX_P1PF : 0) | (p1 && bl ? CX_P1BL : 0) |
+			(m0 && pf ? CX_M0PF : 0) | (m0 && bl ? CX_M0BL : 0) |
+			(m1 && pf ? CX_M1PF : 0) | (m1 && bl ? CX_M1BL : 0) |
+			(bl && pf ? CX_BLPF : 0) | (p0 && p1 ? CX_P0P1 : 0) |
+			(m0 && m1 ? CX_M0M1 : 0);
+	}
+
+	tables_built = true;
+}
+
 Atari2600TIA::Atari2600TIA(Atari2600 *_atari)
 {
 	DPRINTF(1, "Atari2600TIA::%s:\n", __func__);
@@ -154,6 +300,11 @@ Atari2600TIA::Atari2600TIA(Atari2600 *_atari)
 	this->atari = _atari;
 
 	inpts = 0x3f;
+
+	if (!tables_built)
+		buildTables();
+
+	reset();
 }
 
 uint8_t
@@ -163,30 +314,18 @@ Atari2600TIA::read(uint16_t addr)
 
 	uint8_t d8 = 0xff;
 
+	catchUp();
+
 	switch (addr & TIA_RA_MASK) {
 	case CXM0P:
-		d8 = (cx_m0p1 ? 0x80 : 0) | (cx_m0p0 ? 0x40 : 0);
-		break;
 	case CXM1P:
-		d8 = (cx_m1p0 ? 0x80 : 0) | (cx_m1p1 ? 0x40 : 0);
-		break;
 	case CXP0FB:
-		d8 = (cx_p0pf ? 0x80 : 0) | (cx_p0bl ? 0x40 : 0);
-		break;
 	case CXP1FB:
-		d8 = (cx_p1pf ? 0x80 : 0) | (cx_p1bl ? 0x40 : 0);
-		break;
 	case CXM0FB:
-		d8 = (cx_m0pf ? 0x80 : 0) | (cx_m0bl ? 0x40 : 0);
-		break;
 	case CXM1FB:
-		d8 = (cx_m1pf ? 0x80 : 0) | (cx_m1bl ? 0x40 : 0);
-		break;
 	case CXBLPF:
-		d8 = (cx_blpf ? 0x80 : 0);
-		break;
 	case CXPPMM:
-		d8 = (cx_p0p1 ? 0x80 : 0) | (cx_m0m1 ? 0x40 : 0);
+		d8 = ((collisions >> (2 * (addr & TIA_RA_MASK))) & 3) << 6;
 		break;
 
 	case INPT0:
@@ -225,10 +364,15 @@ Atari2600TIA::write(uint16_t addr, uint8_t d8)
 	DPRINTF(2, "Atari2600TIA::%s: addr=0x%04x d8=0x%02x\n", __func__,
 		addr, d8);
 
+	catchUp();
+
 	switch (addr) {
 	case VSYNC:	// vertical sync set-clear
-		if ((d8 & VSYNC_ON) != 0 && !vsync)
-			video->vsync();
+		if ((d8 & VSYNC_ON) != 0 && !vsync) {
+			frame.vsync();
+			video->vsync(&frame);
+			audio.flush();
+		}
 		vsync = (d8 & VSYNC_ON) != 0;
 		break;
 	case VBLANK:	// vertical blank set-clear
@@ -252,18 +396,23 @@ Atari2600TIA::write(uint16_t addr, uint8_t d8)
 		break;
 	case COLUP0:	// color-lum player 0
 		colup0 = d8 & COLU_MASK;
+		colortab_dirty = true;
 		break;
 	case COLUP1:	// color-lum player 1
 		colup1 = d8 & COLU_MASK;
+		colortab_dirty = true;
 		break;
 	case COLUPF:	// color-lum playfield
 		colupf = d8 & COLU_MASK;
+		colortab_dirty = true;
 		break;
 	case COLUBK:	// color-lum background
 		colubk = d8 & COLU_MASK;
+		colortab_dirty = true;
 		break;
 	case CTRLPF:	// control playfield, ball size
 		ctrlpf = d8 & CTRLPF_MASK;
+		colortab_dirty = true;
 		break;
 	case REFP0:	// reflect player 0
 		refp0 = (d8 & REFP_ON) != 0;
@@ -296,16 +445,22 @@ Atari2600TIA::write(uint16_t addr, uint8_t d8)
 		resbl_del = 5;
 		break;
 	case AUDC0:	// audio control 0
+		audio.setAudc(0, d8);
 		break;
 	case AUDC1:	// audio control 1
+		audio.setAudc(1, d8);
 		break;
 	case AUDF0:	// audio frequency 0
+		audio.setAudf(0, d8);
 		break;
 	case AUDF1:	// audio frequency 1
+		audio.setAudf(1, d8);
 		break;
 	case AUDV0:	// audio volume 0
+		audio.setAudv(0, d8);
 		break;
 	case AUDV1:	// audio volume 1
+		audio.setAudv(1, d8);
 		break;
 	case GRP0:	// graphics player 0
 		grp0_new = d8;
@@ -366,26 +521,14 @@ Atari2600TIA::write(uint16_t addr, uint8_t d8)
 		hmbl = 8;
 		break;
 	case CXCLR:	// clear collission latches
-		cx_m0p1 = false;
-		cx_m0p0 = false;
-		cx_m1p0 = false;
-		cx_m1p1 = false;
-		cx_p0pf = false;
-		cx_p0bl = false;
-		cx_p1pf = false;
-		cx_p1bl = false;
-		cx_m0pf = false;
-		cx_m0bl = false;
-		cx_m1pf = false;
-		cx_m1bl = false;
-		cx_blpf = false;
-		cx_p0p1 = false;
-		cx_m0m1 = false;
+		collisions = 0;
 		break;
 	default:
 		DPRINTF(1, "Atari2600TIA::%s: unknown write addr 0x%02x\n",
 			__func__, addr);
 	}
+
+	setOwedMax();
 }
 
 // XXX: Actually, there isn't a TIA reset.
@@ -396,9 +539,16 @@ Atari2600TIA::reset(void)
 
 	inpts_l = 0x30;
 
+	frame.reset();
+	audio.reset();
+
 	hcounter = 0;
 	hblank = true;
 
+	owed = 0;
+	owed_max = ATARI_SCAN_WIDTH;
+	colortab_dirty = true;
+
 	vsync = false;
 	vblank_reg = 0;
 	wsync = false;
@@ -437,6 +587,8 @@ Atari2600TIA::reset(void)
 	resbl_del = 0;
 	resm0_del = 0;
 	resm1_del = 0;
+	resp0_del = 0;
+	resp1_del = 0;
 
 	blec = false;
 	p0ec = false;
@@ -450,15 +602,18 @@ Atari2600TIA::reset(void)
 	pf0_sr = 0;
 	pf1_sr = 0;
 	pf2_sr = 0;
+	bitpf = false;
 
 	bitbl = false;
 	bitbl_cnt = 0;
 	hzpc_bl = 0;
 
 	bitp0 = false;
+	bitp0_cnt = 0;
 	hzpc_p0 = 0;
 
 	bitp1 = false;
+	bitp1_cnt = 0;
 	hzpc_p1 = 0;
 
 	bitm0 = false;
@@ -469,21 +624,9 @@ Atari2600TIA::reset(void)
 	bitm1_cnt = 0;
 	hzpc_m1 = 0;
 
-	cx_m0p1 = false;
-	cx_m0p0 = false;
-	cx_m1p0 = false;
-	cx_m1p1 = false;
-	cx_p0pf = false;
-	cx_p0bl = false;
-	cx_p1pf = false;
-	cx_p1bl = false;
-	cx_m0pf = false;
-	cx_m0bl = false;
-	cx_m1pf = false;
-	cx_m1bl = false;
-	cx_blpf = false;
-	cx_p0p1 = false;
-	cx_m0m1 = false;
+	collisions = 0;
+
+	memset(scanline, 0, ATARI_NATIVE_WIDTH);
 }
 
 void
@@ -503,6 +646,15 @@ Atari2600TIA::dumpDI03(void)
 	return ((vblank_reg & VBLANK_DI03) != 0);
 }
 
+// Return which objects are drawing a pixel right now.
+uint8_t
+Atari2600TIA::objBits(void)
+{
+	return (bitp0 ? OBJ_P0 : 0) | (bitm0 ? OBJ_M0 : 0) |
+		(bitp1 ? OBJ_P1 : 0) | (bitm1 ? OBJ_M1 : 0) |
+		(bitbl ? OBJ_BL : 0) | (bitpf ? OBJ_PF : 0);
+}
+
 // Detect collisions.
 void
 Atari2600TIA::doCollisions(void)
@@ -510,36 +662,7 @@ Atari2600TIA::doCollisions(void)
 	if ((vblank_reg & VBLANK_ON) != 0)
 		return;
 
-	if (bitm0 && bitp1)
-		cx_m0p1 = true;
-	if (bitm0 && bitp0)
-		cx_m0p0 = true;
-	if (bitm1 && bitp0)
-		cx_m1p0 = true;
-	if (bitm1 && bitp1)
-		cx_m1p1 = true;
-	if (bitp0 && bitpf)
-		cx_p0pf = true;
-	if (bitp0 && bitbl)
-		cx_p0bl = true;
-	if (bitp1 && bitpf)
-		cx_p1pf = true;
-	if (bitp1 && bitbl)
-		cx_p1bl = true;
-	if (bitm0 && bitpf)
-		cx_m0pf = true;
-	if (bitm0 && bitbl)
-		cx_m0bl = true;
-	if (bitm1 && bitpf)
-		cx_m1pf = true;
-	if (bitm1 && bitbl)
-		cx_m1bl = true;
-	if (bitbl && bitpf)
-		cx_blpf = true;
-	if (bitp0 && bitp1)
-		cx_p0p1 = true;
-	if (bitm0 && bitm1)
-		cx_m0m1 = true;
+	collisions |= cx_table[objBits()];
 }
 
 // Handle Playfield logic.
@@ -619,21 +742,21 @@ Atari2600TIA::doBall(void)
 // counter value.  This is used by missiles and players.
 bool
 Atari2600TIA::startPlayer(uint8_t ctr, uint8_t nusiz)
+{
+	return MASK_BIT(start_mask[nusiz & NUSIZ_P_MASK], ctr) != 0;
+}
+
+// Return clocks since the most recent copy started at counter value h.
+static int
+copyDist(int h, uint8_t nusiz)
 {
 	nusiz &= NUSIZ_P_MASK;
 
-	switch (ctr) {
-	case 0:
-		return true;
-	case 16:
-		return nusiz == 1 || nusiz == 3;
-	case 32:
-		return nusiz == 2 || nusiz == 3 || nusiz == 6;
-	case 64:
-		return nusiz == 4 || nusiz == 6;
-	default:
-		return false;
-	}
+	for (int i = ncopies[nusiz] - 1; i > 0; i--)
+		if (h >= copy_pos[nusiz][i])
+			return h - copy_pos[nusiz][i];
+
+	return h;
 }
 
 void
@@ -702,38 +825,12 @@ Atari2600TIA::doMissiles(void)
 bool
 Atari2600TIA::playerBit(uint8_t &cnt, uint8_t grp, uint8_t nusiz, bool ref)
 {
-	int n;
-
-	nusiz &= NUSIZ_P_MASK;
-
-	switch (nusiz) {
-	case 5:
-		// double-wide
-		if (cnt > 17) {
-			cnt = 0;
-			return false;
-		}
-		n = ref ? ((cnt - 2) >> 1) : (7 - ((cnt - 2) >> 1));
-		break;
-	case 7:
-		// quad-wide
-		if (cnt > 33) {
-			cnt = 0;
-			return false;
-		}
-		n = ref ? ((cnt - 2) >> 2) : (7 - ((cnt - 2) >> 2));
-		break;
-	default:
-		if (cnt > 8) {
-			cnt = 0;
-			return false;
-		}
-		n = ref ? (cnt - 1) : (8 - cnt);
+	if (cnt > playerLen(nusiz)) {
+		cnt = 0;
+		return false;
 	}
 
-	cnt++;
-
-	return ((grp >> n) & 1) != 0;
+	return playerPix(cnt++, grp, nusiz, ref);
 }
 
 // Handle players and player counters.
@@ -864,42 +961,16 @@ Atari2600TIA::doPixel(int x)
 		return;
 	}
 
-	////////////////////////////////////////////////////
-	// Pixel priority logic.
-	////////////////////////////////////////////////////
-	uint8_t pixel = colubk;
-	if (bitpf || bitbl) {
-		if ((ctrlpf & CTRLPF_SC) != 0)
-			pixel = (x >= ATARI_NATIVE_WIDTH / 2) ?
-				colup1 : colup0;
-		else
-			pixel = colupf;
-	}
-	if (bitp1 || bitm1)
-		pixel = colup1;
-	if (bitp0 || bitm0)
-		pixel = colup0;
-	if ((ctrlpf & CTRLPF_PFP) != 0 && (bitpf || bitbl))
-		pixel = colupf;
+	if (colortab_dirty)
+		buildColorTab();
 
-	scanline[x] = pixel;
+	scanline[x] = colortab[x >= ATARI_NATIVE_WIDTH / 2][objBits()];
 }
 
+// Finish a color clock: advance the horizontal counter and HMOVE logic.
 void
-Atari2600TIA::cycle(void)
+Atari2600TIA::endClock(void)
 {
-	DPRINTF(4, "Atari2600TIA::%s:\n", __func__);
-
-	doPlayfield();
-	doBall();
-	doMissiles();
-	doPlayers();
-
-	doCollisions();
-
-	if (hcounter >= ATARI_SCAN_HBLANK)
-		doPixel(hcounter - ATARI_SCAN_HBLANK);
-
 	// Start new horizontal line.
 	hcounter++;
 	if ((!longblank && hcounter == ATARI_SCAN_HBLANK) ||
@@ -910,8 +981,11 @@ Atari2600TIA::cycle(void)
 		hblank = true;
 		longblank = false;
 
-		if ((vblank_reg & VBLANK_ON) == 0)
-			video->setScanline(scanline);
+		// A line with VBLANK on at its end is blank all the way
+		// across, even if it was set partway through.
+		if ((vblank_reg & VBLANK_ON) != 0)
+			memset(scanline, 0, ATARI_NATIVE_WIDTH);
+		frame.addLine(scanline);
 		video->hsync();
 	} else if (wsync && hcounter == ATARI_SCAN_RDY) {
 		atari->setRdy(true);
@@ -921,3 +995,543 @@ Atari2600TIA::cycle(void)
 	if (hmov_ctr > 0)
 		doHmove();
 }
+
+// Run one color clock of every object.
+void
+Atari2600TIA::tick(void)
+{
+	DPRINTF(4, "Atari2600TIA::%s:\n", __func__);
+
+	doPlayfield();
+	doBall();
+	doMissiles();
+	doPlayers();
+
+	doCollisions();
+
+	if (hcounter >= ATARI_SCAN_HBLANK)
+		doPixel(hcounter - ATARI_SCAN_HBLANK);
+
+	endClock();
+}
+
+// Run one color clock of horizontal blank when no object can move.
+// Only the playfield shifts but collisions still latch.
+void
+Atari2600TIA::tickBlank(void)
+{
+	doPlayfield();
+	doCollisions();
+
+	if (hcounter >= ATARI_SCAN_HBLANK)
+		scanline[hcounter - ATARI_SCAN_HBLANK] = 0;
+
+	endClock();
+}
+
+// Set playfield shift registers to what they hold just before color
+// clock hc of a visible line.
+void
+Atari2600TIA::pfSetShiftRegs(int hc)
+{
+	bool right = hc > ATARI_SCAN_CENTER;
+	int q = (hc - (right ? ATARI_SCAN_CENTER : ATARI_SCAN_HBLANK)) >> 2;
+
+	if (right && (ctrlpf & CTRLPF_REF) != 0) {
+		pf2_sr = q < 8 ? 0x80 >> q : 0;
+		pf1_sr = q >= 8 && q < 16 ? 1 << (q - 8) : 0;
+		pf0_sr = q >= 16 ? 0x80 >> (q - 16) : 0;
+	} else {
+		pf0_sr = q < 4 ? 0x10 << q : 0;
+		pf1_sr = q >= 4 && q < 12 ? 0x80 >> (q - 4) : 0;
+		pf2_sr = q >= 12 && q < 20 ? 1 << (q - 12) : 0;
+	}
+}
+
+// Return true if playfield shift registers are where pfSetShiftRegs()
+// would put them.  They are reloaded at the start of each half.
+bool
+Atari2600TIA::pfSync(void)
+{
+	if (hcounter == ATARI_SCAN_HBLANK || hcounter == ATARI_SCAN_CENTER)
+		return true;
+
+	uint8_t sr0 = pf0_sr;
+	uint8_t sr1 = pf1_sr;
+	uint8_t sr2 = pf2_sr;
+
+	pfSetShiftRegs(hcounter);
+
+	bool sync = sr0 == pf0_sr && sr1 == pf1_sr && sr2 == pf2_sr;
+
+	pf0_sr = sr0;
+	pf1_sr = sr1;
+	pf2_sr = sr2;
+
+	return sync;
+}
+
+// Build the pixel color for each combination of objects in each half
+// of the screen.  This is the pixel priority logic.
+void
+Atari2600TIA::buildColorTab(void)
+{
+	for (int half = 0; half < 2; half++)
+		for (int objs = 0; objs < OBJ_NUM; objs++) {
+			bool pfbl = (objs & (OBJ_PF | OBJ_BL)) != 0;
+			uint8_t pixel = colubk;
+
+			if (pfbl) {
+				if ((ctrlpf & CTRLPF_SC) != 0)
+					pixel = half ? colup1 : colup0;
+				else
+					pixel = colupf;
+			}
+			if ((objs & (OBJ_P1 | OBJ_M1)) != 0)
+				pixel = colup1;
+			if ((objs & (OBJ_P0 | OBJ_M0)) != 0)
+				pixel = colup0;
+			if ((ctrlpf & CTRLPF_PFP) != 0 && pfbl)
+				pixel = colupf;
+
+			colortab[half][objs] = pixel;
+		}
+
+	colortab_dirty = false;
+}
+
+// Classify a player's drawing state at counter value h.
+static int
+playerState(int h, uint8_t cnt, bool bit, uint8_t nusiz)
+{
+	int d = copyDist(h, nusiz);
+
+	if (cnt == 0)
+		return bit ? SPAN_NONE : SPAN_IDLE;
+
+	return cnt == (d <= playerLen(nusiz) ? d + 1 : 0) ?
+		SPAN_SYNC : SPAN_NONE;
+}
+
+// Mark objs[] on each of the next n clocks on which an object with
+// the given mask draws.  h is its counter before the first clock.  An
+// idle object only draws copies that start within the span.  Returns
+// false if an idle object is still idle at the end.
+static bool
+spanMask(uint8_t *objs, int n, int state, int h, const uint8_t *mask,
+	 uint8_t nusiz, uint8_t obj)
+{
+	int c = nusiz & NUSIZ_P_MASK;
+	int first = 0;
+
+	if (state == SPAN_IDLE) {
+		first = n;
+		for (int i = 0; i < ncopies[c]; i++) {
+			int t = copy_pos[c][i] - (h + 1);
+			if (t < 0)
+				t += 160;
+			if (t < first)
+				first = t;
+		}
+		if (first == n)
+			return false;
+	}
+
+	// Counter value h + 1 is drawn on the first clock.
+	for (int k = 0; k < MASK_BYTES; k++)
+		for (uint8_t m = mask[k]; m != 0; m &= m - 1) {
+			int t = k * 8 + __builtin_ctz(m) - (h + 1);
+			if (t < 0)
+				t += 160;
+			if (t >= first && t < n)
+				objs[t] |= obj;
+		}
+
+	return true;
+}
+
+// Draw a player into objs[] for n clocks and leave its counters where
+// n calls to doPlayers() would.
+static void
+spanPlayer(uint8_t *objs, int n, int state, uint8_t &h, uint8_t &cnt,
+	   bool &bit, uint8_t grp, uint8_t nusiz, bool ref, uint8_t obj)
+{
+	int len = playerLen(nusiz);
+	bool drawing = spanMask(objs, n, state, h,
+				player_mask[nusiz & NUSIZ_P_MASK][ref][grp],
+				nusiz, obj);
+
+	h = (h + n) % 160;
+	if (!drawing)
+		return;
+
+	int d = copyDist(h, nusiz);
+
+	cnt = d <= len ? d + 1 : 0;
+	bit = d >= 1 && d <= len && playerPix(d, grp, nusiz, ref);
+}
+
+// Classify a missile's or ball's drawing state at counter value h.
+static int
+missileState(int h, uint8_t cnt, bool bit, uint8_t nusiz, int size,
+	     bool en)
+{
+	int d = copyDist(h, nusiz);
+
+	if (cnt == 0 && !bit)
+		return SPAN_IDLE;
+
+	return cnt == (d < size ? d + 1 : 0) && bit == en ?
+		SPAN_SYNC : SPAN_NONE;
+}
+
+// Draw a missile or the ball into objs[] for n clocks.  The ball draws
+// like a single missile copy.
+static void
+spanMissile(uint8_t *objs, int n, int state, uint8_t &h, uint8_t &cnt,
+	    bool &bit, uint8_t nusiz, int sz, bool en, uint8_t obj)
+{
+	static const uint8_t no_mask[MASK_BYTES] = { 0 };
+	int size = 1 << sz;
+	bool drawing = spanMask(objs, n, state, h,
+				en ? missile_mask[nusiz & NUSIZ_P_MASK][sz] :
+				no_mask, nusiz, obj);
+
+	h = (h + n) % 160;
+	if (!drawing)
+		return;
+
+	int d = copyDist(h, nusiz);
+
+	cnt = d < size ? d + 1 : 0;
+	bit = d < size && en;
+}
+
+// Render up to n color clocks of the visible part of a line at once.
+// This only works while no object is being reset or moved, so the
+// counters of every object step together with the beam.  Returns the
+// number of clocks done, which may be zero.
+int
+Atari2600TIA::doSpan(int n)
+{
+	if (resbl_del != 0 || resm0_del != 0 || resm1_del != 0 ||
+	    resp0_del != 0 || resp1_del != 0 || resmp0 || resmp1 || !pfSync())
+		return 0;
+
+	bool enbl = vdelbl ? enabl_old : enabl_new;
+	uint8_t grp0 = vdelp0 ? grp0_old : grp0_new;
+	uint8_t grp1 = vdelp1 ? grp1_old : grp1_new;
+
+	int p0s = playerState(hzpc_p0, bitp0_cnt, bitp0, nusiz0);
+	int p1s = playerState(hzpc_p1, bitp1_cnt, bitp1, nusiz1);
+	int m0s = missileState(hzpc_m0, bitm0_cnt, bitm0, nusiz0,
+			       NUSIZ_MSZ(nusiz0), enam0);
+	int m1s = missileState(hzpc_m1, bitm1_cnt, bitm1, nusiz1,
+			       NUSIZ_MSZ(nusiz1), enam1);
+	int bls = missileState(hzpc_bl, bitbl_cnt, bitbl, 0,
+			       CTRLPF_BSZ(ctrlpf), enbl);
+	if (p0s == SPAN_NONE || p1s == SPAN_NONE || m0s == SPAN_NONE ||
+	    m1s == SPAN_NONE || bls == SPAN_NONE)
+		return 0;
+
+	int x0 = hcounter - ATARI_SCAN_HBLANK;
+	uint8_t objs[ATARI_NATIVE_WIDTH];
+
+	// Playfield, one bit per four color clocks.
+	bool ref = (ctrlpf & CTRLPF_REF) != 0;
+	for (int t = 0; t < n; t++) {
+		int q = (x0 + t) >> 2;
+
+		if (q >= 20)
+			q = ref ? 39 - q : q - 20;
+		if (q < 4)
+			bitpf = (pf0 & (0x10 << q)) != 0;
+		else if (q < 12)
+			bitpf = (pf1 & (0x80 >> (q - 4))) != 0;
+		else
+			bitpf = (pf2 & (1 << (q - 12))) != 0;
+
+		objs[t] = bitpf ? OBJ_PF : 0;
+	}
+	pfSetShiftRegs(hcounter + n);
+
+	spanPlayer(objs, n, p0s, hzpc_p0, bitp0_cnt, bitp0, grp0,
+		   nusiz0, refp0, OBJ_P0);
+	spanPlayer(objs, n, p1s, hzpc_p1, bitp1_cnt, bitp1, grp1,
+		   nusiz1, refp1, OBJ_P1);
+	spanMissile(objs, n, m0s, hzpc_m0, bitm0_cnt, bitm0, nusiz0,
+		    (nusiz0 & NUSIZ_M_MASK) >> NUSIZ_M_SHFT, enam0, OBJ_M0);
+	spanMissile(objs, n, m1s, hzpc_m1, bitm1_cnt, bitm1, nusiz1,
+		    (nusiz1 & NUSIZ_M_MASK) >> NUSIZ_M_SHFT, enam1, OBJ_M1);
+	spanMissile(objs, n, bls, hzpc_bl, bitbl_cnt, bitbl, 0,
+		    (ctrlpf & CTRLPF_BSZ_MASK) >> CTRLPF_BSZ_SHFT, enbl,
+		    OBJ_BL);
+
+	if ((vblank_reg & VBLANK_ON) != 0)
+		memset(&scanline[x0], 0, n);
+	else {
+		uint16_t cx = 0;
+
+		if (colortab_dirty)
+			buildColorTab();
+
+		for (int t = 0; t < n; t++) {
+			int half = x0 + t >= ATARI_NATIVE_WIDTH / 2;
+
+			scanline[x0 + t] = colortab[half][objs[t]];
+			cx |= cx_table[objs[t]];
+		}
+
+		collisions |= cx;
+	}
+
+	for (int t = 0; t < n - 1; t++)
+		if (hmov_ctr > 0)
+			doHmove();
+	hcounter += n - 1;
+	endClock();
+
+	return n;
+}
+
+// Work out how many clocks we can put off rendering: up to the end of
+// the line, or until the CPU has to be released from WSYNC.
+void
+Atari2600TIA::setOwedMax(void)
+{
+	if (wsync) {
+		owed_max = ATARI_SCAN_RDY - hcounter;
+		if (owed_max <= 0)
+			owed_max += ATARI_SCAN_WIDTH;
+	} else
+		owed_max = ATARI_SCAN_WIDTH - hcounter;
+}
+
+// Render all the color clocks counted by cycle() since the last catch-up.
+void
+Atari2600TIA::catchUp(void)
+{
+	audio.clock(owed);
+
+	while (owed > 0) {
+		if (!hblank) {
+			int n = owed;
+			if (n > ATARI_SCAN_WIDTH - hcounter)
+				n = ATARI_SCAN_WIDTH - hcounter;
+			n = doSpan(n);
+			if (n > 0) {
+				owed -= n;
+				continue;
+			}
+		} else if (hmov_ctr == 0 && !blec && !m0ec && !m1ec &&
+			   !p0ec && !p1ec && resbl_del == 0 &&
+			   resm0_del == 0 && resm1_del == 0 &&
+			   resp0_del == 0 && resp1_del == 0) {
+			tickBlank();
+			owed--;
+			continue;
+		}
+
+		tick();
+		owed--;
+	}
+
+	setOwedMax();
+}
+
+// Registers and object counters as they are, including color clocks
+// owed but not yet rendered.  The partly drawn frame and audio have
+// their own chunks.
+void
+Atari2600TIA::saveState(StateWriter &w)
+{
+	w.beginChunk("TIA ");
+	w.putInt(hcounter);
+	w.putBool(hblank);
+
+	w.putInt(owed);
+	w.putInt(owed_max);
+
+	w.putBool(vsync);
+	w.put8(vblank_reg);
+	w.putBool(wsync);
+	w.put8(nusiz0);
+	w.put8(nusiz1);
+	w.put8(colup0);
+	w.put8(colup1);
+	w.put8(colupf);
+	w.put8(colubk);
+	w.put8(ctrlpf);
+	w.putBool(refp0);
+	w.putBool(refp1);
+	w.put8(pf0);
+	w.put8(pf1);
+	w.put8(pf2);
+	w.put8(grp0_new);
+	w.put8(grp0_old);
+	w.put8(grp1_new);
+	w.put8(grp1_old);
+	w.putBool(enam0);
+	w.putBool(enam1);
+	w.putBool(enabl_new);
+	w.putBool(enabl_old);
+	w.put8(hmp0);
+	w.put8(hmp1);
+	w.put8(hmm0);
+	w.put8(hmm1);
+	w.put8(hmbl);
+	w.putBool(vdelp0);
+	w.putBool(vdelp1);
+	w.putBool(vdelbl);
+	w.putBool(resmp0);
+	w.putBool(resmp1);
+
+	w.put8(resbl_del);
+	w.put8(resm0_del);
+	w.put8(resm1_del);
+	w.put8(resp0_del);
+	w.put8(resp1_del);
+
+	w.putBool(blec);
+	w.putBool(p0ec);
+	w.putBool(p1ec);
+	w.putBool(m0ec);
+	w.putBool(m1ec);
+
+	w.putBool(longblank);
+	w.put8(hmov_ctr);
+
+	w.putBool(bitpf);
+	w.put8(pf0_sr);
+	w.put8(pf1_sr);
+	w.put8(pf2_sr);
+
+	w.put8(hzpc_bl);
+	w.putBool(bitbl);
+	w.put8(bitbl_cnt);
+
+	w.putBool(bitm0);
+	w.put8(bitm0_cnt);
+	w.put8(hzpc_m0);
+	w.putBool(bitm1);
+	w.put8(bitm1_cnt);
+	w.put8(hzpc_m1);
+
+	w.putBool(bitp0);
+	w.put8(bitp0_cnt);
+	w.put8(hzpc_p0);
+	w.putBool(bitp1);
+	w.put8(bitp1_cnt);
+	w.put8(hzpc_p1);
+
+	w.put8(inpts);
+	w.put8(inpts_l);
+
+	w.put16(collisions);
+	w.putBytes(scanline, ATARI_NATIVE_WIDTH);
+	w.endChunk();
+
+	frame.saveState(w);
+	audio.saveState(w);
+}
+
+void
+Atari2600TIA::loadState(StateReader &r)
+{
+	if (!r.openChunk("TIA "))
+		return;
+	hcounter = r.getInt();
+	hblank = r.getBool();
+
+	owed = r.getInt();
+	owed_max = r.getInt();
+
+	vsync = r.getBool();
+	vblank_reg = r.get8();
+	wsync = r.getBool();
+	nusiz0 = r.get8();
+	nusiz1 = r.get8();
+	colup0 = r.get8();
+	colup1 = r.get8();
+	colupf = r.get8();
+	colubk = r.get8();
+	ctrlpf = r.get8();
+	refp0 = r.getBool();
+	refp1 = r.getBool();
+	pf0 = r.get8();
+	pf1 = r.get8();
+	pf2 = r.get8();
+	grp0_new = r.get8();
+	grp0_old = r.get8();
+	grp1_new = r.get8();
+	grp1_old = r.get8();
+	enam0 = r.getBool();
+	enam1 = r.getBool();
+	enabl_new = r.getBool();
+	enabl_old = r.getBool();
+	hmp0 = r.get8();
+	hmp1 = r.get8();
+	hmm0 = r.get8();
+	hmm1 = r.get8();
+	hmbl = r.get8();
+	vdelp0 = r.getBool();
+	vdelp1 = r.getBool();
+	vdelbl = r.getBool();
+	resmp0 = r.getBool();
+	resmp1 = r.getBool();
+
+	resbl_del = r.get8();
+	resm0_del = r.get8();
+	resm1_del = r.get8();
+	resp0_del = r.get8();
+	resp1_del = r.get8();
+
+	blec = r.getBool();
+	p0ec = r.getBool();
+	p1ec = r.getBool();
+	m0ec = r.getBool();
+	m1ec = r.getBool();
+
+	longblank = r.getBool();
+	hmov_ctr = (int8_t)r.get8();
+
+	bitpf = r.getBool();
+	pf0_sr = r.get8();
+	pf1_sr = r.get8();
+	pf2_sr = r.get8();
+
+	hzpc_bl = r.get8();
+	bitbl = r.getBool();
+	bitbl_cnt = r.get8();
+
+	bitm0 = r.getBool();
+	bitm0_cnt = r.get8();
+	hzpc_m0 = r.get8();
+	bitm1 = r.getBool();
+	bitm1_cnt = r.get8();
+	hzpc_m1 = r.get8();
+
+	bitp0 = r.getBool();
+	bitp0_cnt = r.get8();
+	hzpc_p0 = r.get8();
+	bitp1 = r.getBool();
+	bitp1_cnt = r.get8();
+	hzpc_p1 = r.get8();
+
+	inpts = r.get8();
+	inpts_l = r.get8();
+
+	collisions = r.get16();
+	r.getBytes(scanline, ATARI_NATIVE_WIDTH);
+	r.endChunk();
+
+	if (hcounter < 0 || hcounter >= ATARI_SCAN_WIDTH || owed < 0 ||
+	    owed >= owed_max) {
+		r.fail();
+		return;
+	}
+	colortab_dirty = true;
+
+	frame.loadState(r);
+	audio.loadState(r);
+}
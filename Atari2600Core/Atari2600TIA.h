@@ -28,9 +28,13 @@
 
 #include "MemSpace.h"
 #include "Atari2600Video.h"
+#include "Atari2600Frame.h"
+#include "Atari2600Audio.h"
 
 class Atari2600Video;
 class Atari2600;
+class StateWriter;
+class StateReader;
 
 class Atari2600TIA : public MemSpace {
 private:
@@ -40,7 +44,12 @@ private:
 	int	hcounter;
 	bool	hblank;
 
+	int	owed;		// color clocks not yet rendered
+	int	owed_max;	// clocks until we must catch up
+
 	uint8_t	scanline[ATARI_NATIVE_WIDTH];
+	Atari2600Frame frame;
+	Atari2600Audio audio;
 
 	// Registers storage
 	bool	vsync;
@@ -121,22 +130,10 @@ private:
 	uint8_t	inpts;		// five inputs
 	uint8_t inpts_l;	// latch for I4,I5
 
-	// Collision latches
-	bool	cx_m0p1;
-	bool	cx_m0p0;
-	bool	cx_m1p0;
-	bool	cx_m1p1;
-	bool	cx_p0pf;
-	bool	cx_p0bl;
-	bool	cx_p1pf;
-	bool	cx_p1bl;
-	bool	cx_m0pf;
-	bool	cx_m0bl;
-	bool	cx_m1pf;
-	bool	cx_m1bl;
-	bool	cx_blpf;
-	bool	cx_p0p1;
-	bool	cx_m0m1;
+	uint16_t collisions;	// collision latches
+
+	uint8_t	colortab[2][64]; // pixel color by object bits, per half
+	bool	colortab_dirty;
 
 	void	doPlayfield(void);
 	void	doBall(void);
@@ -144,9 +141,18 @@ private:
 	void	doMissiles(void);
 	bool	playerBit(uint8_t &cnt, uint8_t grp, uint8_t nusiz, bool ref);
 	void	doPlayers(void);
+	uint8_t	objBits(void);
 	void	doCollisions(void);
 	void    doHmove(void);
 	void	doPixel(int);
+	void	endClock(void);
+	void	tick(void);
+	void	tickBlank(void);
+	bool	pfSync(void);
+	void	pfSetShiftRegs(int hc);
+	void	buildColorTab(void);
+	int	doSpan(int n);
+	void	setOwedMax(void);
 public:
 	Atari2600TIA(Atari2600 *_atari);
 
@@ -154,14 +160,28 @@ public:
 	void	write(uint16_t addr, uint8_t d8);
 
 	void	reset(void);
-	void	cycle(void);
+	void	catchUp(void);
+
+	// Color clocks are only counted here and rendered in batches
+	// by catchUp() when something needs to see the TIA's state.
+	void	cycle(void)
+	{
+		if (++owed >= owed_max)
+			catchUp();
+	}
 
 	void	setVideo(Atari2600Video *_video)
 	{ this->video = _video; }
+	void	setAudioRing(AudioRing *_ring)
+	{ audio.setRing(_ring); }
 	void	setInput(uint8_t _set, uint8_t _reset);
+	void	saveState(StateWriter &w);
+	void	loadState(StateReader &r);
 	bool	dumpDI03(void);
 	int	*getCycleCounter(void)
 	{ return &this->hcounter; }
+	const Atari2600Frame *getFrame(void)
+	{ return &this->frame; }
 };
 
 #endif // __ATARI2600TIA_H__
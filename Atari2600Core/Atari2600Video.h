@@ -39,12 +39,17 @@
 #define COLU_COL_MASK	(0xfu << COLU_COL_SHFT)
 #define COLU_MASK	(COLU_COL_MASK | COLU_LUM_MASK)
 
+class Atari2600Frame;
+class StateWriter;
+class StateReader;
+
 class Atari2600Video {
 public:
-	virtual void	setScanline(uint8_t colu[]) = 0;
-	virtual void	vsync(void) = 0;
+	virtual void	vsync(const Atari2600Frame *frame) = 0;
 	virtual void	hsync(void) = 0;
 	virtual void	reset(void) = 0;
+	virtual void	saveState(StateWriter &w) = 0;
+	virtual void	loadState(StateReader &r) = 0;
 };
 
 #endif // __ATARI2600VIDEO_H__
@@ -28,6 +28,8 @@
 #include <stdint.h>
 
 #include "Atari2600VideoStub.h"
+#include "Atari2600Frame.h"
+#include "SaveState.h"
 
 #ifdef DEBUGVID
 #  include <cstdio>
@@ -38,7 +40,27 @@
 #endif
 
 void
-Atari2600VideoStub::setScanline(uint8_t colu[])
+Atari2600VideoStub::vsync(const Atari2600Frame *frame)
 {
-	DPRINTF(4, "Atari2600VideoStub::%s: y=%d\n", __func__, vline);
+	DPRINTF(4, "Atari2600VideoStub::%s: lines=%d\n", __func__,
+		frame->getLines());
+
+	vline = 0;
+}
+
+void
+Atari2600VideoStub::saveState(StateWriter &w)
+{
+	w.beginChunk("TVID");
+	w.putInt(vline);
+	w.endChunk();
+}
+
+void
+Atari2600VideoStub::loadState(StateReader &r)
+{
+	if (!r.findChunk("TVID"))
+		return;
+	vline = r.getInt();
+	r.endChunk();
 }
@@ -34,10 +34,11 @@ class Atari2600VideoStub : public Atari2600Video {
 private:
 	int	vline;
 public:
-	void	setScanline(uint8_t colu[]);
-	void	vsync(void) { vline = 0; }
+	void	vsync(const Atari2600Frame *frame);
 	void	hsync(void) { vline++; }
 	void	reset(void) { vline = 0; }
+	void	saveState(StateWriter &w);
+	void	loadState(StateReader &r);
 };
 
 #endif //  __ATARI2600VIDEOSTUB_H__
@@ -28,6 +28,7 @@
 #include <stdint.h>
 
 #include "Mos6532Riot.h"
+#include "SaveState.h"
 
 #ifdef DEBUGIO
 extern unsigned int cycles;
@@ -58,6 +59,8 @@ Mos6532Riot::Mos6532Riot(void)
 
 	porta_in = 0xff;
 	portb_in = 0xff;
+
+	reset();
 }
 
 uint8_t
@@ -177,13 +180,16 @@ Mos6532Riot::reset(void)
 {
 	DPRINTF(1, "Mos6532Riot::%s:\n", __func__);
 
+	porta_out = 0;
 	ddra = 0;
+	portb_out = 0;
 	ddrb = 0;
 	intim = 0;
 	instat = 0;
 
 	timcnt = 0;
 	timintvl = 1024;
+	timcmpr = 0;
 	pa7_edge = 0;
 }
 
@@ -198,3 +204,42 @@ Mos6532Riot::cycle(void)
 			instat |= INSTAT_TIM;
 	}
 }
+
+void
+Mos6532Riot::saveState(StateWriter &w)
+{
+	w.beginChunk("RIOT");
+	w.put8(porta_in);
+	w.put8(porta_out);
+	w.put8(ddra);
+	w.put8(portb_in);
+	w.put8(portb_out);
+	w.put8(ddrb);
+	w.put8(intim);
+	w.put8(instat);
+	w.put16(timcnt);
+	w.put16(timintvl);
+	w.put16(timcmpr);
+	w.put8(pa7_edge);
+	w.endChunk();
+}
+
+void
+Mos6532Riot::loadState(StateReader &r)
+{
+	if (!r.openChunk("RIOT"))
+		return;
+	porta_in = r.get8();
+	porta_out = r.get8();
+	ddra = r.get8();
+	portb_in = r.get8();
+	portb_out = r.get8();
+	ddrb = r.get8();
+	intim = r.get8();
+	instat = r.get8();
+	timcnt = r.get16();
+	timintvl = r.get16();
+	timcmpr = r.get16();
+	pa7_edge = r.get8();
+	r.endChunk();
+}
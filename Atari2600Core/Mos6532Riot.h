@@ -28,6 +28,9 @@
 
 #include "MemSpace.h"
 
+class StateWriter;
+class StateReader;
+
 class Mos6532Riot : public MemSpace {
 private:
 	uint8_t	porta_in;
@@ -49,6 +52,8 @@ public:
 
 	void	setPortA(uint8_t _set, uint8_t _reset);
 	void	setPortB(uint8_t _set, uint8_t _reset);
+	void	saveState(StateWriter &w);
+	void	loadState(StateReader &r);
 
 	// MemSpace interface
 	uint8_t	read(uint16_t addr);
@@ -1,17 +1,387 @@
 #include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <new>
 
 #include "Atari2600VideoStub.h"
+#include "Atari2600Render.h"
 #include "Atari2600.h"
+#include "Movie.h"
+#include "Rollback.h"
+#include "Netplay.h"
+#include "Spawn.h"
+#include "Media.h"
+#include "BootCache.h"
 
 extern const uint8_t testrom[];
 
+// Map a cartridge file, or use the built-in test ROM without one.
+static bool
+loadRom(Atari2600 &atari, const char *romfile)
+{
+	static ImageRef rom = Image::wrap(testrom, 0x1000);
+	ImageRef image = rom;
+
+	if (romfile) {
+		std::string error;
+		image = Media::open(romfile, MEDIA_CART, error);
+		if (!image) {
+			fprintf(stderr, "%s: %s\n", romfile, error.c_str());
+			return false;
+		}
+	}
+	atari.setRom(image);
+	return true;
+}
+
+// Replay a movie as fast as it goes and check its frame hashes.  The
+// hashes cover the renderer's state, so this uses the real one.  Movies
+// don't hold the cartridge, so it must be the one recorded with.
+static int
+playMovie(const char *filename, const char *romfile)
+{
+	Atari2600Render video;
+	Atari2600 atari(&video);
+	Movie movie("2600", ATARI_FRAME_CLOCKS);
+
+	if (!loadRom(atari, romfile))
+		return 1;
+
+	movie.setSaveFunc([&] (StateWriter &w) { atari.saveState(w); });
+	movie.setHashFunc([&] { return atari.stateHash(); });
+	movie.setLoadFunc([&] (StateReader &r) {
+		return atari.loadState(r);
+	});
+	movie.setInputFunc([&] (const InputEvent &in) {
+		atari.input(in.type, in.a, in.b);
+	});
+
+	if (!movie.load(filename) || !movie.play()) {
+		fprintf(stderr, "%s: can't play movie\n", filename);
+		return 1;
+	}
+
+	clock_t t = clock();
+	while (movie.isPlaying()) {
+		int n = movie.until(ATARI_FRAME_CLOCKS);
+		for (int i = n; i > 0; )
+			if (atari.cycle())
+				i--;
+		movie.ran(n);
+	}
+	double secs = (double)(clock() - t) / CLOCKS_PER_SEC;
+
+	printf("%s: %u frames checked, %u mismatches", filename,
+	       movie.getChecked(), movie.getMismatches());
+	if (movie.getMismatches() > 0)
+		printf(" (first at clock %llu)",
+		       (unsigned long long)movie.getFirstMismatch());
+	if (secs > 0.0)
+		printf(", %.1fx real time",
+		       movie.getLength() / (ATARI_CLOCK_RATE * secs));
+	printf("\n");
+
+	return movie.getMismatches() > 0 ? 1 : 0;
+}
+
+// Now and then, flip one of the joystick switches held in bits.
+// Returns false if none this time, or the bits to set and reset.
+static bool
+randomJoy(int &bits, int &set, int &reset)
+{
+	if (rand() % 8 != 0)
+		return false;
+
+	int b = 1 << (rand() % 5);
+	set = (bits & b) ? 0 : b;
+	reset = b & ~set;
+	bits ^= b;
+
+	return true;
+}
+
+#define NET_FRAMES	1800
+#define NET_TIMEOUT_MS	10000	// for the other side to start
+
+// Play the test cart against another copy of this over UDP, each side
+// wiggling its own joystick at random, and print a hash of the state
+// at the end.  Both sides must print the same one.  delay_ms and loss
+// are applied to outgoing packets to stand in for a poor network.
+static int
+netplay(int player, int port, const char *host, int peer_port,
+	int delay_ms, int loss)
+{
+	typedef std::chrono::steady_clock wall;
+	Atari2600Render video;
+	Atari2600 atari(&video);
+	Rollback rb(ATARI_FRAME_CLOCKS, player);
+	Netplay net(player);
+	const uint64_t end = (uint64_t)NET_FRAMES * ATARI_FRAME_CLOCKS;
+	const int joy = player ? ATARI_INPUT_JOY_RIGHT : ATARI_INPUT_JOY_LEFT;
+	int stalls = 0;
+
+	if (!net.open(port, host, peer_port)) {
+		fprintf(stderr, "can't open netplay to %s:%d\n", host,
+			peer_port);
+		return 1;
+	}
+	net.setDelay(delay_ms);
+	net.setLoss(loss);
+
+	atari.setRom(Image::wrap(testrom, 0x1000));
+	atari.reset();
+
+	rb.setSaveFunc([&] (StateWriter &w) { atari.saveState(w); });
+	rb.setLoadFunc([&] (StateReader &r) { return atari.loadState(r); });
+	rb.setRunFunc([&] (int n) {
+		while (n > 0)
+			if (atari.cycle())
+				n--;
+	});
+	rb.setInputFunc([&] (const InputEvent &in) {
+		atari.input(in.type, in.a, in.b);
+	});
+
+	// Both sides start from player 0's machine.
+	StateWriter w;
+	atari.saveState(w);
+	std::vector<uint8_t> state(w.getData(), w.getData() + w.getSize());
+	if (!net.exchangeState(state, NET_TIMEOUT_MS)) {
+		fprintf(stderr, "no answer from %s:%d\n", host, peer_port);
+		return 1;
+	}
+	if (!rb.start(state)) {
+		fprintf(stderr, "start state didn't load\n");
+		return 1;
+	}
+
+	srand(player + 1);
+	int bits = 0;
+	uint64_t last_sent = ~(uint64_t)0;
+	wall::time_point t0 = wall::now();
+	wall::time_point resend = t0;
+	for (;;) {
+		net.poll([&] (const InputEvent &in) { rb.remote(in); });
+		rb.setConfirmed(net.getConfirmed());
+		rb.sync();
+
+		if (rb.getClock() == end && net.getConfirmed() >= end)
+			break;
+
+		// Catch up to the wall clock a frame at a time.
+		uint64_t target = (uint64_t)(std::chrono::duration<double>(
+			wall::now() - t0).count() * 60.0) * ATARI_FRAME_CLOCKS;
+		if (target > end)
+			target = end;
+		while (rb.getClock() < target) {
+			int set, reset;
+			if (rb.getClock() % ATARI_FRAME_CLOCKS == 0 &&
+			    randomJoy(bits, set, reset))
+				net.queue(rb.local(joy, set, reset));
+			int n = rb.until(ATARI_FRAME_CLOCKS);
+			if (n == 0) {
+				stalls++;
+				break;
+			}
+			for (int i = n; i > 0; )
+				if (atari.cycle())
+					i--;
+			rb.ran(n);
+		}
+		// Send each frame, and keep resending while stalled.
+		if (rb.getClock() != last_sent || wall::now() > resend) {
+			net.send(rb.getLocalConfirmed());
+			last_sent = rb.getClock();
+			resend = wall::now() + std::chrono::milliseconds(16);
+		}
+		usleep(1000);
+	}
+
+	uint64_t h = atari.stateHash();
+	double secs = std::chrono::duration<double>(wall::now() - t0).count();
+
+	// Keep answering so the other side gets to the end too.
+	wall::time_point t1 = wall::now();
+	while (wall::now() - t1 < std::chrono::seconds(2)) {
+		net.poll([&] (const InputEvent &in) { rb.remote(in); });
+		net.send(rb.getLocalConfirmed());
+		usleep(5000);
+	}
+
+	printf("player %d: %d frames in %.1f s, state %016llx\n", player,
+	       NET_FRAMES, secs, (unsigned long long)h);
+	unsigned r = rb.getRollbacks();
+	printf("  %u rollbacks, depth avg %.1f max %d frames, "
+	       "resim %.3f ms/frame (%.0fx real time)\n", r,
+	       r ? (double)rb.getRedoFrames() / r : 0.0, rb.getMaxDepth(),
+	       rb.getRedoFrames() ?
+	       rb.getRedoNs() / 1e6 / rb.getRedoFrames() : 0.0,
+	       rb.getRedoNs() ? rb.getRedoFrames() * 1e9 / 60.0 /
+	       rb.getRedoNs() : 0.0);
+	printf("  %d stalls, packets %u sent %u received %u dropped\n",
+	       stalls, net.getSent(), net.getReceived(), net.getDropped());
+
+	return 0;
+}
+
+// Run the cart a second, then fork a branch for each of n random
+// joystick sequences, frames long, and count the different states they
+// end in.
+static int
+branchJoy(int n, int frames, const char *romfile)
+{
+	Atari2600Render video;
+	Atari2600 atari(&video);
+	Spawn spawn;
+	BootCache cache;
+	std::vector<uint64_t> hashes;
+
+	if (!loadRom(atari, romfile))
+		return 1;
+
+	// The game's first second, from a snapshot after the first run.
+	cache.setBootFunc([&] {
+		atari.reset();
+		for (int i = 60 * ATARI_FRAME_CLOCKS; i > 0; )
+			if (atari.cycle())
+				i--;
+	});
+	cache.setSaveFunc([&] (StateWriter &w) { atari.saveState(w); });
+	cache.setLoadFunc([&] (StateReader &r) {
+		return atari.loadState(r);
+	});
+	cache.boot("2600", 60, atari.romHash());
+
+	spawn.setBranchFunc([&] (int branch, std::vector<uint8_t> &result) {
+		int bits = 0, set, reset;
+
+		srand(branch + 1);
+		for (int f = 0; f < frames; f++) {
+			if (randomJoy(bits, set, reset))
+				atari.input(ATARI_INPUT_JOY_LEFT, set, reset);
+			for (int i = ATARI_FRAME_CLOCKS; i > 0; )
+				if (atari.cycle())
+					i--;
+		}
+
+		uint64_t h = atari.stateHash();
+		result.assign((uint8_t *)&h, (uint8_t *)&h + sizeof(h));
+	});
+	spawn.setResultFunc([&] (int branch,
+				 const std::vector<uint8_t> &result) {
+		uint64_t h;
+		if (result.size() == sizeof(h)) {
+			memcpy(&h, result.data(), sizeof(h));
+			hashes.push_back(h);
+		}
+	});
+
+	auto t0 = std::chrono::steady_clock::now();
+	spawn.run(0, n);
+	double secs = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - t0).count();
+
+	std::sort(hashes.begin(), hashes.end());
+	int distinct = std::unique(hashes.begin(), hashes.end()) -
+		hashes.begin();
+
+	printf("%u branches of %d frames, %d distinct end states, "
+	       "%u failed\n", spawn.getFinished(), frames, distinct,
+	       spawn.getFailed());
+	if (secs > 0.0)
+		printf("%.1f s, %.0f branches/s, %.1fx real time\n", secs,
+		       spawn.getFinished() / secs,
+		       spawn.getFinished() * frames / 60.0 / secs);
+
+	return spawn.getFailed() > 0 ? 1 : 0;
+}
+
+// A machine and its renderer built in memory full of junk, so that
+// anything the constructors or reset leave uninitialized shows up in
+// the hash.
+struct JunkAtari {
+	void		*vmem;
+	void		*amem;
+	Atari2600Render	*video;
+	Atari2600	*atari;
+
+	JunkAtari(uint8_t junk)
+	{
+		vmem = ::operator new(sizeof(Atari2600Render));
+		amem = ::operator new(sizeof(Atari2600));
+		memset(vmem, junk, sizeof(Atari2600Render));
+		memset(amem, junk, sizeof(Atari2600));
+		video = new (vmem) Atari2600Render;
+		atari = new (amem) Atari2600(video);
+	}
+	~JunkAtari()
+	{
+		atari->~Atari2600();
+		video->~Atari2600Render();
+		::operator delete(amem);
+		::operator delete(vmem);
+	}
+};
+
+// Check two fresh machines hash the same from reset and every frame
+// after for frames.
+static int
+checkFresh(int frames, const char *romfile)
+{
+	JunkAtari a(0x00), b(0xa5);
+
+	if (!loadRom(*a.atari, romfile) || !loadRom(*b.atari, romfile))
+		return 1;
+	a.atari->reset();
+	b.atari->reset();
+
+	for (int f = 0; f <= frames; f++) {
+		if (a.atari->stateHash() != b.atari->stateHash()) {
+			printf("fresh machines differ at frame %d\n", f);
+			return 1;
+		}
+		for (int i = ATARI_FRAME_CLOCKS; i > 0; )
+			if (a.atari->cycle())
+				i--;
+		for (int i = ATARI_FRAME_CLOCKS; i > 0; )
+			if (b.atari->cycle())
+				i--;
+	}
+
+	printf("fresh machines the same for %d frames\n", frames);
+
+	return 0;
+}
+
+// Usage: atari [-p movie [cart.bin]]
+//	  atari -b branches frames [cart.bin]
+//	  atari -d frames [cart.bin]
+//	  atari -n player port peerhost peerport [delay_ms [loss%]]
 int
 main(int argc, char *argv[])
 {
+	if (argc > 2 && strcmp(argv[1], "-p") == 0)
+		return playMovie(argv[2], argc > 3 ? argv[3] : nullptr);
+	if (argc > 3 && strcmp(argv[1], "-b") == 0)
+		return branchJoy(atoi(argv[2]), atoi(argv[3]),
+				 argc > 4 ? argv[4] : nullptr);
+	if (argc > 2 && strcmp(argv[1], "-d") == 0)
+		return checkFresh(atoi(argv[2]), argc > 3 ? argv[3] : nullptr);
+	if (argc > 5 && strcmp(argv[1], "-n") == 0)
+		return netplay(atoi(argv[2]) & 1, atoi(argv[3]), argv[4],
+			       atoi(argv[5]), argc > 6 ? atoi(argv[6]) : 0,
+			       argc > 7 ? atoi(argv[7]) : 0);
+
 	Atari2600VideoStub video;
 	Atari2600 atari(&video);
 
-	atari.setRom(testrom, 0x1000);
+	atari.setRom(Image::wrap(testrom, 0x1000));
 
 	atari.reset();
 	atari.cycle();
@@ -32,8 +32,10 @@
 
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "Atari2600.h"
+#include "Media.h"
 
 #include "Atari2600GtkAppWin.h"
 
@@ -47,13 +49,80 @@
 extern const uint8_t spaceinvaders[];
 #define SPACEINVADERSLEN 4096
 
+#define AUDIO_RING_SIZE	16384	// samples, about 1/3 second
+
 Atari2600GtkApp::Atari2600GtkApp()
 	: Gtk::Application("net.skibo.atarigtk"),
 	  atari(nullptr),
-	  debugger(atari.getCpu())
+	  emu(atari.getCpu(), ATARI_CLOCK_RATE, ATARI_FRAME_CLOCKS),
+	  movie("2600", ATARI_FRAME_CLOCKS),
+	  runahead(ATARI_FRAME_CLOCKS),
+	  debugger(atari.getCpu()),
+	  audioRing(AUDIO_RING_SIZE, ATARI_AUDIO_RATE)
 {
 	DPRINTF(1, "Atari2600GtkApp::%s:\n", __func__);
 
+	atari.setAudioRing(&audioRing);
+
+	// Slices stop at movie frames and inputs and at run-ahead frames.
+	// A false cycle ran no clock.
+	emu.setSliceFunc([&] (int n) {
+		while (n > 0) {
+			int m = runahead.until(movie.until(n));
+			for (int i = 0; i < m; i++)
+				if (!atari.cycle()) {
+					movie.ran(i);
+					runahead.ran(i);
+					return false;
+				}
+			movie.ran(m);
+			runahead.ran(m);
+			n -= m;
+		}
+		return true;
+	});
+	emu.setStopCallback([&] { this->onStopped(); });
+	emu.setNotifyCallback([&] { emuNotify.emit(); });
+	emuNotify.connect(sigc::mem_fun(emu, &EmuThread::runGui));
+
+	movie.setSaveFunc([&] (StateWriter &w) { atari.saveState(w); });
+	movie.setHashFunc([&] { return atari.stateHash(); });
+	movie.setLoadFunc([&] (StateReader &r) {
+		return atari.loadState(r);
+	});
+	movie.setInputFunc([&] (const InputEvent &in) {
+		atari.input(in.type, in.a, in.b);
+	});
+	movie.setDoneCallback([&] {
+		emu.postGui([&] { this->onMovieDone(); });
+	});
+	atari.setInputCallback([&] (int type, int a, int b) {
+		movie.input(type, a, b);
+	});
+
+	// Frames run ahead are muted and only the last is shown.  Not while
+	// debugging, or breakpoints would be hit in the future.
+	runahead.setSaveFunc([&] (StateWriter &w) { atari.saveState(w); });
+	runahead.setLoadFunc([&] (StateReader &r) {
+		return atari.loadState(r);
+	});
+	runahead.setRunFunc([&] (int n) {
+		while (n > 0)
+			if (atari.cycle())
+				n--;
+	});
+	runahead.setModeFunc([&] (int mode) {
+		audioRing.setMute(mode == RUNAHEAD_HIDDEN ||
+				  mode == RUNAHEAD_SHOWN);
+		disp->setHold(mode == RUNAHEAD_REAL ||
+			      mode == RUNAHEAD_HIDDEN);
+	});
+	runahead.setSafeFunc([&] {
+		Cpu6502 *cpu = atari.getCpu();
+
+		return cpu->getNumBreaks() == 0 && !cpu->isStepping();
+	});
+
 	appwindow = nullptr;
 	debuggerActive = false;
 	disp = nullptr;
@@ -86,6 +155,7 @@ Atari2600GtkApp::doFileChooser(bool dosave)
 	auto filter = Gtk::FileFilter::create();
 	filter->set_name("Binary files");
 	filter->add_pattern("*.bin");
+	filter->add_pattern("*.a26");
 	chooser.add_filter(filter);
 
 	filter = Gtk::FileFilter::create();
@@ -109,7 +179,7 @@ Atari2600GtkApp::create_appwindow()
 {
 	DPRINTF(1, "Atari2600GtkApp::%s:\n", __func__);
 
-	auto appwindow = Atari2600GtkAppWin::create(&atari);
+	auto appwindow = Atari2600GtkAppWin::create(&atari, &emu);
 
 	add_window(*appwindow);
 
@@ -134,6 +204,7 @@ Atari2600GtkApp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 
 	pauseButton = nullptr;
 	builder->get_widget("pause_button", pauseButton);
+	builder->get_widget("label_speed", labelSpeed);
 	pauseButton->signal_toggled().connect(sigc::mem_fun(*this,
 				&Atari2600GtkApp::onPauseToggle));
 
@@ -187,6 +258,35 @@ Atari2600GtkApp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 	menu->signal_activate().connect(sigc::mem_fun(*this,
 				&Atari2600GtkApp::onMenuLoadRom));
 
+	checkmenu = nullptr;
+	builder->get_widget("menu_record_audio", checkmenu);
+	checkmenu->signal_toggled().connect(sigc::bind(sigc::mem_fun(*this,
+				&Atari2600GtkApp::onMenuRecordAudio),
+						       checkmenu));
+
+	checkmenu = nullptr;
+	builder->get_widget("menu_capture", checkmenu);
+	checkmenu->signal_toggled().connect(sigc::bind(sigc::mem_fun(*this,
+				&Atari2600GtkApp::onMenuCapture),
+						       checkmenu));
+
+	builder->get_widget("menu_movie_record", checkmenu);
+	checkmenu->signal_toggled().connect(sigc::bind(sigc::mem_fun(*this,
+				&Atari2600GtkApp::onMenuMovieRecord),
+						       checkmenu));
+
+	builder->get_widget("menu_movie_play", menu);
+	menu->signal_activate().connect(sigc::mem_fun(*this,
+				&Atari2600GtkApp::onMenuMoviePlay));
+
+	for (int i = 0; i <= 2; i++) {
+		std::string name = "menu_runahead_" + std::to_string(i);
+		builder->get_widget(name, checkmenu);
+		checkmenu->signal_activate().connect(sigc::bind(sigc::mem_fun(
+				*this, &Atari2600GtkApp::onMenuRunAhead),
+							checkmenu, i));
+	}
+
 	menu = nullptr;
 	builder->get_widget("menu_quit", menu);
 	menu->signal_activate().connect(sigc::mem_fun(*this,
@@ -202,6 +302,7 @@ Atari2600GtkApp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 				&Atari2600GtkApp::onMenuAbout), about));
 
 	disp = appwindow->getDisp();
+	disp->setCapture(&capture);
 }
 
 void
@@ -230,10 +331,15 @@ Atari2600GtkApp::on_activate()
 	// Initialize Atari hardware
 	running = false;
 	turbo = false;
-	atari.setRom(spaceinvaders, SPACEINVADERSLEN);
+	atari.setRom(Image::wrap(spaceinvaders, SPACEINVADERSLEN));
 	atari.reset();
 	atariRun(true);
 
+	Glib::signal_timeout().connect(sigc::mem_fun(*this,
+				&Atari2600GtkApp::onTimeout), 10);
+	Glib::signal_timeout().connect(sigc::mem_fun(*this,
+				&Atari2600GtkApp::onStatus), 1000);
+
 }
 
 void
@@ -241,6 +347,7 @@ Atari2600GtkApp::on_hide_window(Gtk::Window *win)
 {
 	DPRINTF(1, "Atari2600GtkApp::%s:\n", __func__);
 
+	atariRun(false);
 	delete win;
 	appwindow = nullptr;
 }
@@ -258,11 +365,14 @@ Atari2600GtkApp::debugCallback(int typ)
 		break;
 
 	case CALLBACK_STEP:
-		atari.getCpu()->stepCpu();
-		if (!running) {
-			while (atari.cycle())
-				;
+		if (running) {
+			// Thread stops after one instruction; see onStopped().
+			emu.post([&] { atari.getCpu()->stepCpu(); });
+			break;
 		}
+		atari.getCpu()->stepCpu();
+		while (atari.cycle())
+			;
 		break;
 
 	case CALLBACK_CONT:
@@ -299,7 +409,7 @@ Atari2600GtkApp::onResetButton(Gtk::Button *button)
 {
 	DPRINTF(1, "Atari2600GtkApp::%s:\n", __func__);
 
-	atari.reset();
+	emu.post([&] { atari.reset(); });
 }
 
 void
@@ -307,7 +417,7 @@ Atari2600GtkApp::onMenuReset(void)
 {
 	DPRINTF(1, "Atari2600GtkApp::%s:\n", __func__);
 
-	atari.reset();
+	emu.post([&] { atari.reset(); });
 }
 
 void
@@ -345,43 +455,169 @@ Atari2600GtkApp::onMenuLoadRom(void)
 	DPRINTF(1, "Atari2600GtkApp::%s: filename=%s\n", __func__,
 		filename.c_str());
 
-	std::ifstream file(filename, std::ios::in | std::ios::binary |
-			   std::ios::ate);
-	if (file.is_open()) {
-		int len = file.tellg();
-
-		if (len > ROM_MAX_SIZE)
-			len = ROM_MAX_SIZE;
-
-		uint8_t *data = new uint8_t[len];
-		file.seekg(0, std::ios::beg);
-		file.read((char *)data, len);
-		file.close();
-
-		atari.setRom(data, len);
-		atari.reset();
+	std::string error;
+	ImageRef image = Media::open(filename, MEDIA_CART, error);
+	if (image) {
+		emu.post([=] {
+			atari.setRom(image);
+			atari.reset();
+		});
 
 		std::string romnm = filename;
 		if (romnm.find_last_of("/") != std::string::npos)
 			romnm = romnm.substr(romnm.find_last_of("/") + 1);
 		entryRom->get_buffer()->set_text(romnm);
+	} else
+		fprintf(stderr, "%s: %s\n", filename.c_str(), error.c_str());
+}
+
+void
+Atari2600GtkApp::onMenuRecordAudio(Gtk::CheckMenuItem *checkmenu)
+{
+	bool active = checkmenu->get_active();
+	DPRINTF(1, "Atari2600GtkApp::%s: active=%d\n", __func__, active);
+
+	if (active == wavWriter.isOpen())
+		return;
+
+	if (!active) {
+		drainAudio();
+		wavWriter.close();
+		return;
+	}
+
+	std::string filename = doFileChooser(true);
+
+	// Throw away whatever was generated before recording started.
+	audioRing.clear();
+
+	if (filename == "" ||
+	    !wavWriter.open(filename.c_str(), audioRing.getRate()))
+		checkmenu->set_active(false);
+}
+
+void
+Atari2600GtkApp::onMenuCapture(Gtk::CheckMenuItem *checkmenu)
+{
+	bool active = checkmenu->get_active();
+	DPRINTF(1, "Atari2600GtkApp::%s: active=%d\n", __func__, active);
+
+	if (active == capture.isOpen())
+		return;
+
+	// Frames are fed to capture on the emulation thread.
+	bool wasRunning = emu.isRunning();
+	emu.run(false);
+	drainAudio();
+
+	if (!active) {
+		capture.close();
+		printf("Capture: %u frames, %u dropped, %u samples dropped\n",
+		       capture.getFrames(), capture.getDropped(),
+		       capture.getDroppedSamples());
+		emu.run(wasRunning);
+		return;
+	}
+
+	// Capture appends .y4m and .wav to the name.
+	std::string filename = doFileChooser(true);
+	if (filename.size() > 4 &&
+	    filename.compare(filename.size() - 4, 4, ".y4m") == 0)
+		filename.resize(filename.size() - 4);
+
+	// Pixels are twice as wide as they are tall.
+	if (filename == "" ||
+	    !capture.open(filename.c_str(), disp->getFrameBuffer(),
+			  ATARI_CLOCK_RATE, ATARI_FRAME_CLOCKS,
+			  audioRing.getRate(), 2, 1))
+		checkmenu->set_active(false);
+
+	emu.run(wasRunning);
+}
+
+// Recording starts from the machine as it is.  Movies don't hold the
+// cartridge, so play them back with the same one in.
+void
+Atari2600GtkApp::onMenuMovieRecord(Gtk::CheckMenuItem *checkmenu)
+{
+	bool active = checkmenu->get_active();
+	DPRINTF(1, "Atari2600GtkApp::%s: active=%d\n", __func__, active);
+
+	if (active == movie.isRecording())
+		return;
 
-		delete [] data;
+	bool wasRunning = emu.isRunning();
+	emu.run(false);
+
+	if (active)
+		movie.record();
+	else {
+		movie.stop();
+		std::string filename = doFileChooser(true);
+		if (filename != "" && !movie.save(filename.c_str()))
+			fprintf(stderr, "Can't save movie %s\n",
+				filename.c_str());
 	}
+
+	emu.run(wasRunning);
+}
+
+void
+Atari2600GtkApp::onMenuMoviePlay(void)
+{
+	DPRINTF(1, "Atari2600GtkApp::%s:\n", __func__);
+
+	std::string filename = doFileChooser(false);
+
+	// Empty string means Cancel.
+	if (filename == "")
+		return;
+
+	bool wasRunning = emu.isRunning();
+	emu.run(false);
+
+	if (!movie.load(filename.c_str()) || !movie.play())
+		fprintf(stderr, "Can't play movie %s\n", filename.c_str());
+	else
+		disp->flush();
+
+	emu.run(wasRunning);
+}
+
+void
+Atari2600GtkApp::onMenuRunAhead(Gtk::CheckMenuItem *checkmenu, int frames)
+{
+	if (!checkmenu->get_active())
+		return;
+
+	DPRINTF(1, "Atari2600GtkApp::%s: frames=%d\n", __func__, frames);
+
+	emu.post([=] { runahead.setFrames(frames); });
+}
+
+// Playback reached the end of the movie.
+void
+Atari2600GtkApp::onMovieDone(void)
+{
+	printf("Movie: %u frames checked, %u mismatches\n",
+	       movie.getChecked(), movie.getMismatches());
+	if (movie.getMismatches() > 0)
+		printf("Movie: first mismatch at clock %llu\n",
+		       (unsigned long long)movie.getFirstMismatch());
 }
 
 void
 Atari2600GtkApp::onSelectButton(Gtk::Button *button, bool flag)
 {
 	DPRINTF(1, "Atari2600GtkApp::%s: flag=%d\n", __func__, flag);
-	atari.setSelect(flag);
+	emu.post([=] { atari.setSelect(flag); });
 }
 
 void
 Atari2600GtkApp::onStartButton(Gtk::Button *button, bool flag)
 {
 	DPRINTF(1, "Atari2600GtkApp::%s: flag=%d\n", __func__, flag);
-	atari.setStart(flag);
+	emu.post([=] { atari.setStart(flag); });
 }
 
 void
@@ -392,7 +628,7 @@ Atari2600GtkApp::onDiffLToggle(Gtk::ToggleButton *toggle)
 
 	toggle->set_label(active ? "L Expert" : "L Novice");
 
-	atari.setDiffLeft(active);
+	emu.post([=] { atari.setDiffLeft(active); });
 }
 
 void
@@ -403,52 +639,73 @@ Atari2600GtkApp::onDiffRToggle(Gtk::ToggleButton *toggle)
 
 	toggle->set_label(active ? "R Expert" : "R Novice");
 
-	atari.setDiffRight(active);
+	emu.post([=] { atari.setDiffRight(active); });
 }
 
 
-// Timer call-back function.
-bool
-Atari2600GtkApp::onTimeout(void)
+// Empty the audio ring, saving samples if recording or capturing.
+// There is no sound device output yet so samples are dropped otherwise.
+void
+Atari2600GtkApp::drainAudio(void)
 {
-	if (running) {
-		int cycles = 35800; // 10ms
-
-		while (cycles-- > 0) {
-			if (!atari.cycle()) {
-				// Stopped due to breakpoint or other
-				running = false;
-				pauseButton->set_active(true);
-				debugger.setState(debuggerActive, running);
-				return false;
-			}
-		}
+	int16_t buf[1024];
+	int n;
 
-		return true;
+	while ((n = audioRing.read(buf, 1024)) > 0) {
+		if (wavWriter.isOpen())
+			wavWriter.write(buf, n);
+		capture.audio(buf, n);
 	}
+}
 
-	return false;
+// Timer call-back function.  Emulation runs on its own thread; this
+// just keeps audio moving.
+bool
+Atari2600GtkApp::onTimeout(void)
+{
+	drainAudio();
+
+	return true;
 }
 
+// Once a second, show emulated speed and how well pacing is going.
 bool
-Atari2600GtkApp::onIdle(void)
-{
-	if (running && turbo) {
-		int cycles = 35800; // 10ms
-		while (cycles-- > 0) {
-			if (!atari.cycle()) {
-				// Stopped due to breakpoint or other
-				running = false;
-				pauseButton->set_active(true);
-				debugger.setState(debuggerActive, running);
-				return false;
-			}
-		}
+Atari2600GtkApp::onStatus(void)
+{
+	const Pacer *pacer = emu.getPacer();
+	char buf[128];
+	int n = 0;
+
+	// The CPU runs at a third of the color clock.
+	buf[0] = '\0';
+	if (running)
+		n = snprintf(buf, sizeof(buf),
+			     "%.3f MHz  %.2fx  %u late  %u dropped",
+			     pacer->getClockHz() / 3.0e6, pacer->getSpeed(),
+			     pacer->getOverruns(), pacer->getDropped());
+
+	// What running ahead costs, as a share of a real frame's time.
+	if (running && runahead.getFrames() > 0)
+		snprintf(buf + n, sizeof(buf) - n,
+			 "  ahead %d  +%.2f ms (%.0f%%)",
+			 runahead.getFrames(), runahead.getCost() / 1000.0,
+			 runahead.getCost() * 1.0e-4 * ATARI_CLOCK_RATE /
+			 ATARI_FRAME_CLOCKS);
+	labelSpeed->set_text(buf);
+
+	return true;
+}
 
-		return true;
-	}
+// Emulation thread stopped on a breakpoint or after a single step.
+void
+Atari2600GtkApp::onStopped(void)
+{
+	DPRINTF(1, "Atari2600GtkApp::%s:\n", __func__);
 
-	return false;
+	running = false;
+	pauseButton->set_active(true);
+	debugger.setState(debuggerActive, running);
+	drainAudio();
 }
 
 // Start or stop Atari.
@@ -458,14 +715,7 @@ Atari2600GtkApp::atariRun(bool flag)
 	if (running == flag)
 		return;
 
-	if (flag) {
-		Glib::signal_timeout().connect(sigc::mem_fun(*this,
-				&Atari2600GtkApp::onTimeout), 10);
-
-		if (turbo)
-			Glib::signal_idle().connect(sigc::mem_fun(*this,
-					&Atari2600GtkApp::onIdle));
-	}
+	emu.run(flag);
 
 	running = flag;
 }
@@ -476,9 +726,8 @@ Atari2600GtkApp::atariTurbo(bool flag)
 	if (turbo == flag)
 		return;
 
-	if (running && flag)
-		Glib::signal_idle().connect(sigc::mem_fun(*this,
-				&Atari2600GtkApp::onIdle));
+	emu.setTurbo(flag);
+	disp->setTurbo(flag);
 
 	turbo = flag;
 }
@@ -486,6 +735,10 @@ Atari2600GtkApp::atariTurbo(bool flag)
 void
 Atari2600GtkApp::onMenuQuit(void)
 {
+	atariRun(false);
+	wavWriter.close();
+	capture.close();
+
 	auto windows = get_windows();
 	for (auto window : windows)
 		window->hide();
@@ -28,6 +28,12 @@
 
 #include "Atari2600.h"
 #include "Cpu6502GtkDebug.h"
+#include "AudioRing.h"
+#include "WavWriter.h"
+#include "Capture.h"
+#include "EmuThread.h"
+#include "Movie.h"
+#include "RunAhead.h"
 
 class Atari2600GtkAppWin;
 class Atari2600GtkDisp;
@@ -36,10 +42,18 @@ class Atari2600GtkApp : public Gtk::Application {
 private:
 	Atari2600GtkAppWin *appwindow;
 	Atari2600	atari;
+	EmuThread	emu;
+	Movie		movie;
+	RunAhead	runahead;
+	Glib::Dispatcher emuNotify;
 	Cpu6502GtkDebug	debugger;
 	Atari2600GtkDisp *disp;
+	AudioRing	audioRing;
+	WavWriter	wavWriter;
+	Capture		capture;
 
 	Gtk::ToggleButton *pauseButton;
+	Gtk::Label	*labelSpeed;
 	Gtk::Entry	*entryRom;
 
 	bool		debuggerActive;
@@ -52,7 +66,9 @@ private:
 	void		connectSignals(Glib::RefPtr <Gtk::Builder> builder);
 	std::string	doFileChooser(bool dosave);
 	bool		onTimeout(void);
-	bool		onIdle(void);
+	bool		onStatus(void);
+	void		onStopped(void);
+	void		drainAudio(void);
 	void		atariRun(bool flag);
 	void		atariTurbo(bool flag);
 	void		onPauseToggle(void);
@@ -68,6 +84,13 @@ private:
 	void		onMenuAbout(Gtk::AboutDialog *about);
 	void		debugCallback(int typ);
 	void		onMenuLoadRom(void);
+	void		onMenuRecordAudio(Gtk::CheckMenuItem *checkmenu);
+	void		onMenuCapture(Gtk::CheckMenuItem *checkmenu);
+	void		onMenuMovieRecord(Gtk::CheckMenuItem *checkmenu);
+	void		onMenuMoviePlay(void);
+	void		onMovieDone(void);
+	void		onMenuRunAhead(Gtk::CheckMenuItem *checkmenu,
+				       int frames);
 	void		onMenuQuit(void);
 
 	void		diskCallback(bool motor, int track);
@@ -53,7 +53,7 @@ Atari2600GtkAppWin::Atari2600GtkAppWin(BaseObjectType *cobject,
 
 // Class function
 Atari2600GtkAppWin *
-Atari2600GtkAppWin::create(Atari2600 *atari)
+Atari2600GtkAppWin::create(Atari2600 *atari, EmuThread *emu)
 {
 	DPRINTF(1, "Atari2600GtkAppWin::%s:\n", __func__);
 
@@ -71,7 +71,7 @@ Atari2600GtkAppWin::create(Atari2600 *atari)
 	atari->setVideo(window->disp);
 
 	Atari2600GtkInput *inp = nullptr;
-	builder->get_widget_derived("atari_input", inp, atari);
+	builder->get_widget_derived("atari_input", inp, atari, emu);
 	inp->connectSignals(builder);
 
 	return window;
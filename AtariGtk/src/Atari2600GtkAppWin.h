@@ -30,6 +30,7 @@
 
 #include "Atari2600GtkDisp.h"
 class Atari2600;
+class EmuThread;
 
 class Atari2600GtkAppWin : public Gtk::ApplicationWindow
 {
@@ -44,7 +45,8 @@ public:
 	~Atari2600GtkAppWin();
 	Glib::RefPtr<Gtk::Builder> getBuilder() { return this->builder; }
 
-	static Atari2600GtkAppWin *create(Atari2600 *atari2600);
+	static Atari2600GtkAppWin *create(Atari2600 *atari2600,
+					   EmuThread *emu);
 
 	Atari2600GtkDisp *getDisp(void)
 	{ return disp; }
@@ -38,30 +38,41 @@
 #  define DPRINTF(l, arg...)
 #endif
 
-extern const uint8_t colortab[];
-
-#define ATARI_VID_HEIGHT	212	// larger than 192 native height
-#define ATARI_VID_VBLANK	30	// skip lines, including sync pulse
-
 Atari2600GtkDisp::Atari2600GtkDisp(BaseObjectType *cobject,
 			       const Glib::RefPtr<Gtk::Builder> &refBuilder)
 	: Gtk::DrawingArea(cobject)
 {
 	DPRINTF(1, "Atari2600GtkDisp::constructor:\n");
 
-	pixbuf = Gdk::Pixbuf::create(Gdk::Colorspace::COLORSPACE_RGB,
-				     false, 8, ATARI_NATIVE_WIDTH,
-				     ATARI_VID_HEIGHT);
-	pb_data = pixbuf->get_pixels();
-	pb_stride = pixbuf->get_rowstride();
-	pb_n_channels = pixbuf->get_n_channels();
+	// Four channels so a pixel is one 32-bit palette entry.
+	for (int i = 0; i < FS_NBUFS; i++)
+		pixbufs[i] = Gdk::Pixbuf::create(
+			Gdk::Colorspace::COLORSPACE_RGB, true, 8,
+			ATARI_NATIVE_WIDTH, ATARI_VID_HEIGHT);
 
-	DPRINTF(1, "Atari2600GtkDisp::constructor: stride=%d n_channels=%d\n",
-		pb_stride, pb_n_channels);
+	DPRINTF(1, "Atari2600GtkDisp::constructor: stride=%d\n",
+		pixbufs[0]->get_rowstride());
 
 	disp_scale = 1.0;
+	vstat_time = 0;
+	capture = nullptr;
+	hold = false;
+
+	swap = new FrameSwap(&fb, pixbufs[0]->get_pixels(),
+			     pixbufs[1]->get_pixels(),
+			     pixbufs[2]->get_pixels(),
+			     pixbufs[0]->get_rowstride(), FB_RGBA);
+	fb.setFrameCallback([&] (FrameBuffer *frame) {
+		this->onFrame(frame);
+	});
 
 	reset();
+	flush();
+}
+
+Atari2600GtkDisp::~Atari2600GtkDisp()
+{
+	delete swap;
 }
 
 void
@@ -72,6 +83,7 @@ Atari2600GtkDisp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 	signal_configure_event().connect(sigc::mem_fun(*this,
 				       &Atari2600GtkDisp::onConfigure));
 	signal_draw().connect(sigc::mem_fun(*this, &Atari2600GtkDisp::onDraw));
+	add_tick_callback(sigc::mem_fun(*this, &Atari2600GtkDisp::onTick));
 
 	vstatEntry = nullptr;
 	builder->get_widget("vlines_entry", vstatEntry);
@@ -95,7 +107,6 @@ Atari2600GtkDisp::onConfigure(GdkEventConfigure *event)
 	disp_top = ((float)height - disp_scale * ATARI_VID_HEIGHT) / 2.0;
 
 	queue_draw();
-	update_disp = false;
 
 	return true;
 }
@@ -112,116 +123,48 @@ Atari2600GtkDisp::onDraw(const ::Cairo::RefPtr<::Cairo::Context> &cr)
 	cr->save();
 	cr->translate(disp_left, disp_top);
 	cr->scale(disp_scale * 2.0, disp_scale);
-	Gdk::Cairo::set_source_pixbuf(cr, pixbuf);
+	Gdk::Cairo::set_source_pixbuf(cr, pixbufs[swap->getFront()]);
 	cr->paint();
 	cr->restore();
 
 	return true;
 }
 
-void
-Atari2600GtkDisp::reset(void)
-{
-	DPRINTF(1, "Atari2600GtkDisp::%s:\n", __func__);
-
-	vline = 0;
-	lines_since_vsync = 0;
-	lines_update_vstat = 0;
-	last_vheight = 999;
-	got_scanline = false;
-
-	memset(pb_data, 0, pb_stride * ATARI_VID_HEIGHT);
-	update_disp = true;
-}
-
-void
-Atari2600GtkDisp::setScanline(uint8_t colu[])
+// Once per host display refresh, pick up the newest finished frame.
+bool
+Atari2600GtkDisp::onTick(const Glib::RefPtr<Gdk::FrameClock> &clock)
 {
-	DPRINTF(4, "Atari2600GtkDisp::%s: y=%d\n", __func__, vline);
-
-	if (vline < ATARI_VID_VBLANK ||
-	    vline >= ATARI_VID_VBLANK + ATARI_VID_HEIGHT)
-		return;
-
-	int y = vline - ATARI_VID_VBLANK;
+	if (swap->acquire())
+		queue_draw();
 
-	u_char *p = pb_data + y * pb_stride;
-	for (int i = 0; i < ATARI_NATIVE_WIDTH; i++) {
-		const uint8_t *colp = &colortab[(colu[i] >> 1) * 3];
-		if (memcmp(p, colp, pb_n_channels) != 0) {
-			memcpy(p, colp, pb_n_channels);
-			update_disp = true;
-		}
-		p += pb_n_channels;
+	gint64 now = clock->get_frame_time();
+	if (now - vstat_time >= 1000000) {
+		// Update vertical status
+		static char buf[128];
+		int vheight = getVHeight();
+		if (vheight >= 999)
+			strncpy(buf, "Video Status: No VSync!", sizeof(buf));
+		else
+			snprintf(buf, sizeof(buf), "Video Status: VLines: %d",
+				 vheight);
+		vstatEntry->get_buffer()->set_text(buf);
+		vstat_time = now;
 	}
 
-	got_scanline = true;
-}
-
-void
-Atari2600GtkDisp::clearLines(int line, int n)
-{
-	DPRINTF(4, "Atari2600GtkDisp::%s: line=%d n=%d\n", __func__,
-		line, n);
-
-	u_char *p = pb_data + line * pb_stride;
-	int size = n * pb_stride;
-
-	for (int i = 0; i < size; i++) {
-		if (p[i] != 0)
-			update_disp = true;
-		p[i] = 0;
-	}
+	return true;
 }
 
+// Frame complete, on the emulation thread.
 void
-Atari2600GtkDisp::vsync(void)
+Atari2600GtkDisp::onFrame(FrameBuffer *frame)
 {
-	DPRINTF(5, "Atari2600GtkDisp::%s: vline=%d\n", __func__, vline);
-
-	if (vline < ATARI_VID_VBLANK + ATARI_VID_HEIGHT) {
-		// Blank extra lines.
-		if (last_vheight > vline)
-			clearLines(MAX(vline - ATARI_VID_VBLANK, 0),
-				   ATARI_VID_HEIGHT -
-				   MAX(vline - ATARI_VID_VBLANK, 0));
-	}
-
-	last_vheight = vline;
-	vline = 0;
-	lines_since_vsync = 0;
-
-	if(update_disp) {
-		queue_draw();
-		update_disp = false;
+	if (hold) {
+		swap->frameHeld(frame->isDirty());
+		return;
 	}
-}
 
-void
-Atari2600GtkDisp::hsync(void)
-{
-	if (!got_scanline && vline >= ATARI_VID_VBLANK &&
-	    vline < ATARI_VID_VBLANK + ATARI_VID_HEIGHT)
-		clearLines(vline - ATARI_VID_VBLANK, 1);
-
-	got_scanline = false;
-	vline++;
-
-	if (++lines_since_vsync == 600) {
-		// No vsync in roughly 38ms
-		DPRINTF(4, "Atari2600GtkDisp::%s: missing vsync.\n", __func__);
-		clearLines(0, ATARI_VID_HEIGHT);
-		last_vheight = 999;
-	}
+	if (capture)
+		capture->frame(frame);
 
-	if (++lines_update_vstat > 2000) {
-		// Update vertical status
-		static char buf[128];
-		if (last_vheight >= 999)
-			strncpy(buf, "Video Status: No VSync!", sizeof(buf));
-		else
-			snprintf(buf, sizeof(buf), "Video Status: VLines: %d", last_vheight);
-		vstatEntry->get_buffer()->set_text(buf);
-		lines_update_vstat = 0;
-	}
+	swap->frameDone(frame->isDirty());
 }
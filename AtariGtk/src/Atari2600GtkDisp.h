@@ -28,43 +28,48 @@
 #ifndef __ATARI2600GTKDISP_H__
 #define __ATARI2600GTKDISP_H__
 
-#include "Atari2600Video.h"
+#include "Atari2600Render.h"
+#include "Capture.h"
+#include "FrameSwap.h"
 
-class Atari2600GtkDisp : public Gtk::DrawingArea, public Atari2600Video {
+// Presents frames Atari2600Render draws on the emulation thread.  The
+// renderer's side runs on that thread; everything else is GUI thread.
+class Atari2600GtkDisp : public Gtk::DrawingArea, public Atari2600Render {
 private:
 	float		disp_scale;
 	float		disp_left;
 	float		disp_top;
 
-	int		vline;
-	unsigned int	lines_since_vsync;
-	int		last_vheight;
-	int		lines_update_vstat;
-	bool		got_scanline;
-	bool 		update_disp;
+	gint64		vstat_time;
 
 	Gtk::Entry	*vstatEntry;
 
-	Glib::RefPtr<Gdk::Pixbuf> pixbuf;
-	u_char		*pb_data;
-	int		pb_stride;
-	int		pb_n_channels;
-
-	void	clearLines(int line, int n);
+	Glib::RefPtr<Gdk::Pixbuf> pixbufs[FS_NBUFS];
+	FrameSwap	*swap;
+	Capture		*capture;
+	bool		hold;
 
 	bool	onConfigure(GdkEventConfigure *event);
 	bool	onDraw(const ::Cairo::RefPtr<::Cairo::Context> &cr);
+	bool	onTick(const Glib::RefPtr<Gdk::FrameClock> &clock);
+	void	onFrame(FrameBuffer *frame);
 public:
 	Atari2600GtkDisp(BaseObjectType *cobject,
 		       const Glib::RefPtr<Gtk::Builder> &refBuilder);
+	~Atari2600GtkDisp();
 
+	void	setCapture(Capture *_capture)
+	{ this->capture = _capture; }
 	void	connectSignals(Glib::RefPtr <Gtk::Builder> builder);
 
-	// Atari2600Video interface
-	void	setScanline(uint8_t colu[]);
-	void	vsync(void);
-	void	hsync(void);
-	void	reset(void);
+	// Emulation thread, or GUI thread while emulation is stopped.
+	void	flush(void)
+	{ swap->publish(); }
+	void	setTurbo(bool flag)
+	{ swap->setTurbo(flag); }
+	// Finished frames are neither shown nor captured while held.
+	void	setHold(bool flag)
+	{ this->hold = flag; }
 };
 
 #endif // __ATARI2600GTKDISP_H__
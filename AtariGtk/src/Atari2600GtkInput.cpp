@@ -29,6 +29,7 @@
 #include "Atari2600GtkInput.h"
 
 #include "Atari2600.h"
+#include "EmuThread.h"
 
 #ifdef DEBUGIN
 #  include <cstdio>
@@ -40,9 +41,10 @@
 
 Atari2600GtkInput::Atari2600GtkInput(BaseObjectType *cobject,
 			       const Glib::RefPtr<Gtk::Builder> &refBuilder,
-			       Atari2600 *_atari)
+			       Atari2600 *_atari, EmuThread *_emu)
 	: Gtk::Image(cobject),
-	atari(_atari)
+	atari(_atari),
+	emu(_emu)
 {
 	DPRINTF(1, "Atari2600GtkInput::constructor:\n");
 }
@@ -93,39 +95,39 @@ Atari2600GtkInput::onKeyPressEvent(GdkEventKey *event)
 
 	switch (keyval) {
 	case GDK_KEY_Left:
-		atari->setJoyLeft(JOY_LEFT, 0);
+		emu->post([=] { atari->setJoyLeft(JOY_LEFT, 0); });
 		break;
 	case GDK_KEY_Right:
-		atari->setJoyLeft(JOY_RIGHT, 0);
+		emu->post([=] { atari->setJoyLeft(JOY_RIGHT, 0); });
 		break;
 	case GDK_KEY_Up:
-		atari->setJoyLeft(JOY_UP, 0);
+		emu->post([=] { atari->setJoyLeft(JOY_UP, 0); });
 		break;
 	case GDK_KEY_Down:
-		atari->setJoyLeft(JOY_DOWN, 0);
+		emu->post([=] { atari->setJoyLeft(JOY_DOWN, 0); });
 		break;
 	case GDK_KEY_space:
-		atari->setJoyLeft(JOY_TRIGGER, 0);
+		emu->post([=] { atari->setJoyLeft(JOY_TRIGGER, 0); });
 		break;
 	case GDK_KEY_g:
 	case GDK_KEY_G:
-		atari->setJoyRight(JOY_LEFT, 0);
+		emu->post([=] { atari->setJoyRight(JOY_LEFT, 0); });
 		break;
 	case GDK_KEY_j:
 	case GDK_KEY_J:
-		atari->setJoyRight(JOY_RIGHT, 0);
+		emu->post([=] { atari->setJoyRight(JOY_RIGHT, 0); });
 		break;
 	case GDK_KEY_y:
 	case GDK_KEY_Y:
-		atari->setJoyRight(JOY_UP, 0);
+		emu->post([=] { atari->setJoyRight(JOY_UP, 0); });
 		break;
 	case GDK_KEY_h:
 	case GDK_KEY_H:
-		atari->setJoyRight(JOY_DOWN, 0);
+		emu->post([=] { atari->setJoyRight(JOY_DOWN, 0); });
 		break;
 	case GDK_KEY_f:
 	case GDK_KEY_F:
-		atari->setJoyRight(JOY_TRIGGER, 0);
+		emu->post([=] { atari->setJoyRight(JOY_TRIGGER, 0); });
 		break;
 	default:
 		return false;
@@ -143,39 +145,39 @@ Atari2600GtkInput::onKeyReleaseEvent(GdkEventKey *event)
 
 	switch (keyval) {
 	case GDK_KEY_Left:
-		atari->setJoyLeft(0, JOY_LEFT);
+		emu->post([=] { atari->setJoyLeft(0, JOY_LEFT); });
 		break;
 	case GDK_KEY_Right:
-		atari->setJoyLeft(0, JOY_RIGHT);
+		emu->post([=] { atari->setJoyLeft(0, JOY_RIGHT); });
 		break;
 	case GDK_KEY_Up:
-		atari->setJoyLeft(0, JOY_UP);
+		emu->post([=] { atari->setJoyLeft(0, JOY_UP); });
 		break;
 	case GDK_KEY_Down:
-		atari->setJoyLeft(0, JOY_DOWN);
+		emu->post([=] { atari->setJoyLeft(0, JOY_DOWN); });
 		break;
 	case GDK_KEY_space:
-		atari->setJoyLeft(0, JOY_TRIGGER);
+		emu->post([=] { atari->setJoyLeft(0, JOY_TRIGGER); });
 		break;
 	case GDK_KEY_g:
 	case GDK_KEY_G:
-		atari->setJoyRight(0, JOY_LEFT);
+		emu->post([=] { atari->setJoyRight(0, JOY_LEFT); });
 		break;
 	case GDK_KEY_j:
 	case GDK_KEY_J:
-		atari->setJoyRight(0, JOY_RIGHT);
+		emu->post([=] { atari->setJoyRight(0, JOY_RIGHT); });
 		break;
 	case GDK_KEY_y:
 	case GDK_KEY_Y:
-		atari->setJoyRight(0, JOY_UP);
+		emu->post([=] { atari->setJoyRight(0, JOY_UP); });
 		break;
 	case GDK_KEY_h:
 	case GDK_KEY_H:
-		atari->setJoyRight(0, JOY_DOWN);
+		emu->post([=] { atari->setJoyRight(0, JOY_DOWN); });
 		break;
 	case GDK_KEY_f:
 	case GDK_KEY_F:
-		atari->setJoyRight(0, JOY_TRIGGER);
+		emu->post([=] { atari->setJoyRight(0, JOY_TRIGGER); });
 		break;
 	default:
 		return false;
@@ -191,5 +193,5 @@ Atari2600GtkInput::onPaddleChange(int p, Glib::RefPtr<Gtk::Adjustment> adj)
 
 	DPRINTF(2, "Atari2600GtkInput::%s:p=%d adj=%f\n", __func__, p, val);
 
-	atari->setPaddle(p, (int)val);
+	emu->post([=] { atari->setPaddle(p, (int)val); });
 }
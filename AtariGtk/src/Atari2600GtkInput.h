@@ -27,10 +27,12 @@
 #define __ATARI2600GTKINPUT_H__
 
 class Atari2600;
+class EmuThread;
 
 class Atari2600GtkInput : public Gtk::Image {
 private:
 	Atari2600 *atari;
+	EmuThread *emu;
 
 	bool	onKeyPressEvent(GdkEventKey *event);
 	bool	onKeyReleaseEvent(GdkEventKey *event);
@@ -38,7 +40,7 @@ private:
 public:
 	Atari2600GtkInput(BaseObjectType *cobject,
 		       const Glib::RefPtr<Gtk::Builder> &refBuilder,
-		       Atari2600 *_atari);
+		       Atari2600 *_atari, EmuThread *_emu);
 	void	connectSignals(Glib::RefPtr <Gtk::Builder> builder);
 };
 
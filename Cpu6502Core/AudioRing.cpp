@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// AudioRing.cpp
+
+#include <stdint.h>
+
+#include "AudioRing.h"
+
+AudioRing::AudioRing(int _size, int _rate)
+{
+	// Round size up to a power of 2 so indices can just be masked.
+	for (size = 1; size < _size; size <<= 1)
+		;
+
+	buf = new int16_t[size];
+	rate = _rate;
+	head = 0;
+	tail = 0;
+	overruns = 0;
+	underruns = 0;
+	last = 0;
+	muted = false;
+}
+
+AudioRing::~AudioRing()
+{
+	delete [] buf;
+}
+
+// Add up to n samples.  Samples that don't fit are dropped and counted.
+// Returns number of samples written.
+int
+AudioRing::write(const int16_t *data, int n)
+{
+	if (muted)
+		return n;
+
+	unsigned h = head.load(std::memory_order_relaxed);
+	unsigned space = size - (h - tail.load(std::memory_order_acquire));
+
+	if (n > space) {
+		overruns.fetch_add(n - space, std::memory_order_relaxed);
+		n = space;
+	}
+
+	for (int i = 0; i < n; i++)
+		buf[(h + i) & (size - 1)] = data[i];
+
+	head.store(h + n, std::memory_order_release);
+
+	return n;
+}
+
+// Remove up to n samples.  If pad is true, a short ring is padded out
+// to n samples with the last sample (counted as underruns) as a real-time
+// sink needs.  Returns number of samples taken from the ring.
+int
+AudioRing::read(int16_t *data, int n, bool pad)
+{
+	unsigned t = tail.load(std::memory_order_relaxed);
+	int avail = head.load(std::memory_order_acquire) - t;
+	int m = n < avail ? n : avail;
+
+	for (int i = 0; i < m; i++)
+		data[i] = buf[(t + i) & (size - 1)];
+
+	tail.store(t + m, std::memory_order_release);
+
+	if (m > 0)
+		last = data[m - 1];
+
+	if (pad && m < n) {
+		underruns.fetch_add(n - m, std::memory_order_relaxed);
+		for (int i = m; i < n; i++)
+			data[i] = last;
+	}
+
+	return m;
+}
+
+// Discard everything in ring.  Only the reader may call this.
+void
+AudioRing::clear(void)
+{
+	tail.store(head.load(std::memory_order_acquire),
+		   std::memory_order_release);
+}
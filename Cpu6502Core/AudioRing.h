@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+#ifndef __AUDIORING_H__
+#define __AUDIORING_H__
+
+#include <stdint.h>
+#include <atomic>
+
+// Single-producer single-consumer ring of 16-bit mono samples.  The
+// emulator writes blocks of samples and a host audio sink or WAV
+// writer reads them, possibly from another thread.  Neither side locks.
+class AudioRing {
+private:
+	int16_t	*buf;
+	unsigned size;			// power of 2
+	int	rate;			// samples per second
+
+	std::atomic<unsigned> head;	// advanced by writer
+	std::atomic<unsigned> tail;	// advanced by reader
+
+	std::atomic<unsigned> overruns;	// samples dropped on a full ring
+	std::atomic<unsigned> underruns; // samples padded on an empty ring
+	int16_t	last;			// last sample read
+	bool	muted;			// writer drops samples
+public:
+	AudioRing(int _size, int _rate);
+	~AudioRing();
+
+	int	write(const int16_t *data, int n);
+	int	read(int16_t *data, int n, bool pad = false);
+	void	clear(void);
+
+	// Writer side.  While muted, written samples are thrown away.
+	void	setMute(bool flag)
+	{ this->muted = flag; }
+
+	int	getAvail(void)
+	{ return head.load(std::memory_order_acquire) -
+			tail.load(std::memory_order_acquire); }
+	int	getRate(void)
+	{ return this->rate; }
+	unsigned getOverruns(void)
+	{ return overruns.load(std::memory_order_relaxed); }
+	unsigned getUnderruns(void)
+	{ return underruns.load(std::memory_order_relaxed); }
+};
+
+#endif // __AUDIORING_H__
@@ -0,0 +1,245 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// BlepSynth.cpp
+//
+// Rather than the step itself, a band-limited impulse is added at
+// each transition into an accumulator which is integrated as samples
+// are produced.
+
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+#include "BlepSynth.h"
+#include "AudioRing.h"
+
+#define CUTOFF		0.45	// lowpass cutoff as fraction of sample rate
+#define DC_CUTOFF	4.0	// default DC blocker cutoff, Hz
+
+// Kernel shared by all instances.  It only depends on the ratio of
+// cutoff to sample rate.
+static float kernel[BLEP_PHASES][BLEP_WIDTH];
+static bool kernel_built;
+
+static void
+buildKernel(void)
+{
+	for (int p = 0; p < BLEP_PHASES; p++) {
+		double sum = 0.0;
+
+		for (int k = 0; k < BLEP_WIDTH; k++) {
+			// Distance of tap from impulse center, in samples.
+			double x = k - BLEP_WIDTH / 2 + 1 -
+				(double)p / BLEP_PHASES;
+			double s = x == 0.0 ? 2 * CUTOFF :
+				sin(2 * M_PI * CUTOFF * x) / (M_PI * x);
+			// Blackman window
+			double w = (x + BLEP_WIDTH / 2) / BLEP_WIDTH;
+			if (w < 0.0 || w > 1.0)
+				w = 0.0;
+			else
+				w = 0.42 - 0.5 * cos(2 * M_PI * w) +
+					0.08 * cos(4 * M_PI * w);
+			kernel[p][k] = s * w;
+			sum += s * w;
+		}
+
+		// Normalize so every phase makes a full step.
+		for (int k = 0; k < BLEP_WIDTH; k++)
+			kernel[p][k] /= sum;
+	}
+
+	kernel_built = true;
+}
+
+BlepSynth::BlepSynth(int _clock_rate)
+{
+	if (!kernel_built)
+		buildKernel();
+
+	ring = nullptr;
+	clock_rate = _clock_rate;
+	rate = 48000;
+	dc_cutoff = DC_CUTOFF;
+	dc_decay = exp(-2 * M_PI * dc_cutoff / rate);
+
+	reset();
+}
+
+void
+BlepSynth::reset(void)
+{
+	ntrans = 0;
+	time_base = 0;
+	level = 0;
+	frac = 0;
+	integ = 0.0;
+	dc_in = 0.0;
+	dc_out = 0.0;
+	std::fill(accum.begin(), accum.end(), 0.0);
+}
+
+void
+BlepSynth::setRing(AudioRing *_ring)
+{
+	ring = _ring;
+	if (ring) {
+		rate = ring->getRate();
+		trans_time.resize(BLEP_MAX_TRANS);
+		trans_delta.resize(BLEP_MAX_TRANS);
+		accum.resize(BLEP_BUFLEN + BLEP_WIDTH);
+		out.resize(BLEP_BUFLEN);
+	} else {
+		std::vector<uint32_t>().swap(trans_time);
+		std::vector<int>().swap(trans_delta);
+		std::vector<float>().swap(accum);
+		std::vector<int16_t>().swap(out);
+	}
+	dc_decay = exp(-2 * M_PI * dc_cutoff / rate);
+
+	reset();
+}
+
+// Set how fast a held level decays back to zero.
+void
+BlepSynth::setDcCutoff(double hz)
+{
+	dc_cutoff = hz;
+	dc_decay = exp(-2 * M_PI * dc_cutoff / rate);
+}
+
+// Record the input changing to _level at time clocks into the frame.
+void
+BlepSynth::addTransition(uint32_t time, int _level)
+{
+	if (_level == level)
+		return;
+	if (!ring) {
+		level = _level;
+		return;
+	}
+
+	// Make room by rendering what we have.  Further times are offset.
+	if (ntrans == BLEP_MAX_TRANS)
+		render(time - time_base);
+
+	trans_time[ntrans] = time - time_base;
+	trans_delta[ntrans] = _level - level;
+	ntrans++;
+
+	level = _level;
+}
+
+// Render all clocks up to time and start a new frame at zero.
+void
+BlepSynth::endFrame(uint32_t time)
+{
+	render(time - time_base);
+	time_base = 0;
+}
+
+// Carry on from time clocks into the frame with the input at _level,
+// e.g. after a state is loaded.  Transitions not yet rendered belong to
+// the old timeline and are dropped; a level change is a single step.
+void
+BlepSynth::seek(uint32_t time, int _level)
+{
+	ntrans = 0;
+	time_base = time;
+	addTransition(time, _level);
+}
+
+// Render the next clocks clocks, consuming transitions before that.
+void
+BlepSynth::render(uint32_t clocks)
+{
+	if (!ring) {
+		time_base += clocks;
+		return;
+	}
+
+	// Longest stretch that fits in accum[].
+	uint32_t max_clocks = (uint64_t)(BLEP_BUFLEN - 1) * clock_rate / rate;
+	uint32_t start = 0;
+	int t = 0;
+
+	while (start < clocks) {
+		uint32_t n = clocks - start;
+		if (n > max_clocks)
+			n = max_clocks;
+
+		// Add impulses at each transition's sub-sample position.
+		for (; t < ntrans && trans_time[t] < start + n; t++) {
+			uint64_t pos = frac + (uint64_t)(trans_time[t] - start) *
+				rate;
+			int i = pos / clock_rate;
+			int p = (pos % clock_rate) * BLEP_PHASES / clock_rate;
+
+			for (int k = 0; k < BLEP_WIDTH; k++)
+				accum[i + k] += trans_delta[t] * kernel[p][k];
+		}
+
+		uint64_t pos = frac + (uint64_t)n * rate;
+		int nout = pos / clock_rate;
+		frac = pos % clock_rate;
+
+		for (int i = 0; i < nout; i++) {
+			integ += accum[i];
+
+			// One pole DC blocker.
+			dc_out = integ - dc_in + dc_decay * dc_out;
+			dc_in = integ;
+
+			float s = dc_out;
+			if (s > 32767.0)
+				s = 32767.0;
+			else if (s < -32768.0)
+				s = -32768.0;
+			out[i] = (int16_t)lrintf(s);
+		}
+
+		// Keep the tails of impulses that reach past this chunk.
+		memmove(accum.data(), accum.data() + nout,
+			(BLEP_BUFLEN + BLEP_WIDTH - nout) * sizeof(float));
+		memset(accum.data() + BLEP_BUFLEN + BLEP_WIDTH - nout, 0,
+		       nout * sizeof(float));
+
+		if (nout > 0)
+			ring->write(out.data(), nout);
+
+		start += n;
+	}
+
+	// Shift anything left (added by a full list) to the new start.
+	int left = 0;
+	for (; t < ntrans; t++, left++) {
+		trans_time[left] = trans_time[t] - clocks;
+		trans_delta[left] = trans_delta[t];
+	}
+	ntrans = left;
+	time_base += clocks;
+}
@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+#ifndef __BLEPSYNTH_H__
+#define __BLEPSYNTH_H__
+
+#include <stdint.h>
+#include <vector>
+
+class AudioRing;
+
+#define BLEP_MAX_TRANS	4096	// transitions held per frame
+#define BLEP_WIDTH	16	// kernel taps
+#define BLEP_PHASES	64	// kernel sub-sample phases
+#define BLEP_BUFLEN	2048	// output samples per chunk
+
+// Turns a one-bit (or any stepped) output recorded as level changes at
+// machine clock times into band-limited PCM.  Each step is added to
+// the output as a windowed-sinc band-limited step, then a DC blocker
+// lets a held level decay to zero.  Times are clocks since the start
+// of the current frame; endFrame() renders and starts a new frame.
+// Without a ring nothing is rendered, and the buffers aren't allocated.
+class BlepSynth {
+private:
+	AudioRing *ring;
+	int	clock_rate;		// machine clocks per second
+	int	rate;			// output samples per second
+
+	std::vector<uint32_t> trans_time;	// BLEP_MAX_TRANS
+	std::vector<int> trans_delta;
+	int	ntrans;
+	uint32_t time_base;		// clocks already rendered this frame
+
+	int	level;			// current input level
+	uint64_t frac;			// output position remainder
+	std::vector<float> accum;	// BLEP_BUFLEN + BLEP_WIDTH
+	float	integ;			// integrated steps
+	float	dc_in;			// DC blocker state
+	float	dc_out;
+	float	dc_decay;		// DC blocker pole
+	double	dc_cutoff;		// Hz
+	std::vector<int16_t> out;	// BLEP_BUFLEN
+
+	void	render(uint32_t clocks);
+public:
+	BlepSynth(int _clock_rate);
+
+	void	reset(void);
+	void	addTransition(uint32_t time, int _level);
+	void	endFrame(uint32_t time);
+	void	seek(uint32_t time, int _level);
+
+	void	setRing(AudioRing *_ring);
+	void	setDcCutoff(double hz);
+	int	getLevel(void)
+	{ return this->level; }
+};
+
+#endif // __BLEPSYNTH_H__
@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// BootCache.cpp
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "BootCache.h"
+#include "StateHash.h"
+
+#ifdef DEBUGBOOT
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGBOOT) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+BootCache::BootCache(void)
+{
+	const char *env = getenv(BOOT_CACHE_ENV);
+
+	if (env)
+		dir = env;
+	hits = 0;
+	misses = 0;
+}
+
+uint64_t
+BootCache::key(const char *tag, int variant, uint64_t romhash)
+{
+	uint8_t buf[4 + 4 + 8 + 2];
+	int n = 0;
+
+	memcpy(buf, tag, 4);
+	n += 4;
+	for (int i = 0; i < 4; i++)
+		buf[n++] = (uint32_t)variant >> (8 * i);
+	for (int i = 0; i < 8; i++)
+		buf[n++] = romhash >> (8 * i);
+	buf[n++] = STATE_VERSION;
+	buf[n++] = BOOT_CACHE_VERSION;
+
+	return hashBytes(buf, n);
+}
+
+std::string
+BootCache::path(const char *tag, uint64_t key)
+{
+	char name[32];
+	int n = 0;
+
+	// The tag without its padding, as in "PET-<key>.e6ss".
+	for (int i = 0; i < 4 && tag[i] != ' '; i++)
+		name[n++] = tag[i];
+	snprintf(name + n, sizeof(name) - n, "-%016llx.e6ss",
+		 (unsigned long long)key);
+
+	return dir + "/" + name;
+}
+
+bool
+BootCache::load(const std::vector<uint8_t> &state)
+{
+	StateReader r(state.data(), state.size());
+
+	return load_fn(r);
+}
+
+bool
+BootCache::readFile(const std::string &name, std::vector<uint8_t> &state)
+{
+	FILE *fp = fopen(name.c_str(), "rb");
+	if (!fp)
+		return false;
+
+	uint8_t buf[4096];
+	size_t n;
+	state.clear();
+	while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+		state.insert(state.end(), buf, buf + n);
+	fclose(fp);
+
+	return state.size() > 0;
+}
+
+// Written under another name and renamed so a run starting at the same
+// time never reads half a file.
+void
+BootCache::writeFile(const std::string &name,
+		     const std::vector<uint8_t> &state)
+{
+	std::string tmp = name + "." + std::to_string(getpid());
+	FILE *fp = fopen(tmp.c_str(), "wb");
+	if (!fp)
+		return;
+
+	bool ok = fwrite(state.data(), 1, state.size(), fp) == state.size();
+	if (fclose(fp) != 0)
+		ok = false;
+	if (!ok || rename(tmp.c_str(), name.c_str()) != 0)
+		unlink(tmp.c_str());
+}
+
+// Boot the machine, from a snapshot if there is one.  Returns true if
+// it came from a snapshot.  A snapshot that won't load is replaced.
+bool
+BootCache::boot(const char *tag, int variant, uint64_t romhash)
+{
+	uint64_t k = key(tag, variant, romhash);
+
+	auto it = states.find(k);
+	if (it != states.end() && load(it->second)) {
+		hits++;
+		return true;
+	}
+
+	std::vector<uint8_t> state;
+	std::string name;
+	if (dir != "") {
+		name = path(tag, k);
+		if (readFile(name, state) && load(state)) {
+			DPRINTF(1, "BootCache::%s: loaded %s\n", __func__,
+				name.c_str());
+			states[k].swap(state);
+			hits++;
+			return true;
+		}
+	}
+
+	misses++;
+	boot_fn();
+	save_fn(w);
+	state.assign(w.getData(), w.getData() + w.getSize());
+	if (name != "") {
+		DPRINTF(1, "BootCache::%s: writing %s\n", __func__,
+			name.c_str());
+		writeFile(name, state);
+	}
+	states[k].swap(state);
+
+	return false;
+}
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// BootCache.h
+//
+//	Snapshots of machines that have just booted.  A cold start, like the
+//	PET's RAM test and screen clear or a game's init, runs once and is
+//	saved as a state.  Later boots with the same ROMs load that state
+//	instead.
+//
+//	A snapshot's key is a hash of the machine tag, a variant number and
+//	the ROM hash.  The variant covers anything else the boot depends on,
+//	such as model or RAM size.  States don't hold ROMs, so a changed ROM
+//	just makes a new key, and a new boot builds the snapshot for it.
+//
+//	Snapshots are kept in memory.  If a directory is named by
+//	EM6502_CACHE they are also kept in files there, so separate runs
+//	share them.
+//
+
+#ifndef __BOOTCACHE_H__
+#define __BOOTCACHE_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+
+#include "SaveState.h"
+
+#define BOOT_CACHE_ENV		"EM6502_CACHE"
+#define BOOT_CACHE_VERSION	1	// bump when boots would change
+
+class BootCache {
+private:
+	std::string	dir;
+	std::map<uint64_t, std::vector<uint8_t> > states;
+	StateWriter	w;
+
+	unsigned	hits;
+	unsigned	misses;
+
+	std::function<void (void)> boot_fn;
+	std::function<void (StateWriter &)> save_fn;
+	std::function<bool (StateReader &)> load_fn;
+
+	std::string	path(const char *tag, uint64_t key);
+	bool		load(const std::vector<uint8_t> &state);
+	bool		readFile(const std::string &name,
+				 std::vector<uint8_t> &state);
+	void		writeFile(const std::string &name,
+				  const std::vector<uint8_t> &state);
+public:
+	BootCache(void);
+
+	// Reset the machine and run it until it's ready.
+	void		setBootFunc(std::function<void (void)> _fn)
+	{ this->boot_fn = _fn; }
+	void		setSaveFunc(std::function<void (StateWriter &)> _fn)
+	{ this->save_fn = _fn; }
+	void		setLoadFunc(std::function<bool (StateReader &)> _fn)
+	{ this->load_fn = _fn; }
+	void		setDir(const std::string &_dir)
+	{ this->dir = _dir; }
+
+	static uint64_t	key(const char *tag, int variant, uint64_t romhash);
+	bool		boot(const char *tag, int variant, uint64_t romhash);
+	void		clear(void)
+	{ states.clear(); }
+
+	unsigned	getHits(void) const
+	{ return hits; }
+	unsigned	getMisses(void) const
+	{ return misses; }
+};
+
+#endif // __BOOTCACHE_H__
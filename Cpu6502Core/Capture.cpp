@@ -0,0 +1,274 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+// Capture.cpp
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#include "Capture.h"
+
+#ifdef DEBUGCAPT
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGCAPT) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+Capture::Capture()
+{
+	fp = nullptr;
+	ring = nullptr;
+	planes = nullptr;
+	for (int i = 0; i < CAPTURE_POOL_SIZE; i++)
+		pool[i].data = nullptr;
+	frames = 0;
+	dropped = 0;
+}
+
+Capture::~Capture()
+{
+	close();
+}
+
+// Start capturing frames the size of fb to basename.y4m and, if
+// audio_rate is non-zero, samples to basename.wav.  The frame rate is
+// fps_num / fps_den and pixels are aspect_num / aspect_den wide.
+bool
+Capture::open(const char *basename, const FrameBuffer *fb, int fps_num,
+	      int fps_den, int audio_rate, int aspect_num, int aspect_den)
+{
+	DPRINTF(1, "Capture::%s: %s\n", __func__, basename);
+
+	close();
+
+	std::string name = basename;
+
+	fp = fopen((name + ".y4m").c_str(), "wb");
+	if (!fp)
+		return false;
+
+	if (audio_rate && !wav.open((name + ".wav").c_str(), audio_rate)) {
+		fclose(fp);
+		fp = nullptr;
+		return false;
+	}
+
+	width = fb->getWidth();
+	height = fb->getHeight();
+
+	fprintf(fp, "YUV4MPEG2 W%d H%d F%d:%d Ip A%d:%d C444\n", width,
+		height, fps_num, fps_den, aspect_num, aspect_den);
+
+	// Room for RGBA so a frame can switch formats.
+	for (int i = 0; i < CAPTURE_POOL_SIZE; i++) {
+		pool[i].data = new uint8_t[width * height * 4];
+		free_q[i] = i;
+	}
+	n_free = CAPTURE_POOL_SIZE;
+	full_head = 0;
+	n_full = 0;
+	planes = new uint8_t[width * height * 3];
+
+	if (audio_rate)
+		ring = new AudioRing(CAPTURE_AUDIO_SIZE, audio_rate);
+
+	frames = 0;
+	dropped = 0;
+	stopping = false;
+	writer = std::thread(&Capture::writerLoop, this);
+
+	return true;
+}
+
+// Flush everything queued and close the files.
+void
+Capture::close(void)
+{
+	if (!fp)
+		return;
+
+	DPRINTF(1, "Capture::%s: frames=%u dropped=%u\n", __func__,
+		getFrames(), getDropped());
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_one();
+	writer.join();
+
+	fclose(fp);
+	fp = nullptr;
+	wav.close();
+	freePool();
+}
+
+void
+Capture::freePool(void)
+{
+	for (int i = 0; i < CAPTURE_POOL_SIZE; i++) {
+		delete [] pool[i].data;
+		pool[i].data = nullptr;
+	}
+	delete [] planes;
+	planes = nullptr;
+	delete ring;
+	ring = nullptr;
+}
+
+// Queue a finished frame.  This is the only copy made on the emulation
+// thread.  Never blocks on the writer: if no buffer is free the frame is
+// dropped.
+void
+Capture::frame(const FrameBuffer *fb)
+{
+	if (!fp || fb->getWidth() != width || fb->getHeight() != height)
+		return;
+
+	int idx;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (n_free == 0) {
+			dropped++;
+			return;
+		}
+		idx = free_q[--n_free];
+	}
+
+	Frame *f = &pool[idx];
+	int rowlen = width * (fb->getFormat() == FB_RGBA ? 4 : 1);
+
+	f->format = fb->getFormat();
+	if (f->format == FB_INDEXED)
+		memcpy(f->palette, fb->getPalette(), sizeof(f->palette));
+	for (int y = 0; y < height; y++)
+		memcpy(f->data + y * rowlen, fb->getRow(y), rowlen);
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		full_q[(full_head + n_full++) % CAPTURE_POOL_SIZE] = idx;
+	}
+	wake.notify_one();
+	frames++;
+}
+
+// Queue audio samples.  Samples that don't fit are counted by the ring.
+void
+Capture::audio(const int16_t *data, int n)
+{
+	if (ring)
+		ring->write(data, n);
+}
+
+void
+Capture::drainAudio(void)
+{
+	int16_t buf[1024];
+	int n;
+
+	if (!ring)
+		return;
+	while ((n = ring->read(buf, 1024)) > 0)
+		wav.write(buf, n);
+}
+
+void
+Capture::writerLoop(void)
+{
+	std::unique_lock<std::mutex> guard(lock);
+
+	for (;;) {
+		if (n_full > 0) {
+			int idx = full_q[full_head];
+			full_head = (full_head + 1) % CAPTURE_POOL_SIZE;
+			n_full--;
+
+			guard.unlock();
+			writeFrame(&pool[idx]);
+			drainAudio();
+			guard.lock();
+
+			free_q[n_free++] = idx;
+			continue;
+		}
+
+		if (stopping)
+			break;
+
+		// Audio keeps flowing even if frames stop, e.g. no vsync.
+		wake.wait_for(guard, std::chrono::milliseconds(50));
+		guard.unlock();
+		drainAudio();
+		guard.lock();
+	}
+
+	guard.unlock();
+	drainAudio();
+}
+
+// Convert a frame to BT.601 studio-range 4:4:4 planes and write it.
+void
+Capture::writeFrame(Frame *f)
+{
+	int npix = width * height;
+	uint8_t *yp = planes;
+	uint8_t *up = planes + npix;
+	uint8_t *vp = planes + 2 * npix;
+	uint8_t lut[FB_PALETTE_SIZE][3];
+
+	if (f->format == FB_INDEXED)
+		for (int i = 0; i < FB_PALETTE_SIZE; i++) {
+			const uint8_t *c = (const uint8_t *)&f->palette[i];
+			int r = c[0], g = c[1], b = c[2];
+
+			lut[i][0] = ((66 * r + 129 * g + 25 * b + 128) >> 8) +
+				16;
+			lut[i][1] = ((-38 * r - 74 * g + 112 * b + 128) >> 8) +
+				128;
+			lut[i][2] = ((112 * r - 94 * g - 18 * b + 128) >> 8) +
+				128;
+		}
+
+	for (int i = 0; i < npix; i++) {
+		if (f->format == FB_INDEXED) {
+			const uint8_t *yuv = lut[f->data[i]];
+
+			yp[i] = yuv[0];
+			up[i] = yuv[1];
+			vp[i] = yuv[2];
+		} else {
+			const uint8_t *c = f->data + i * 4;
+			int r = c[0], g = c[1], b = c[2];
+
+			yp[i] = ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16;
+			up[i] = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
+			vp[i] = ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
+		}
+	}
+
+	fputs("FRAME\n", fp);
+	fwrite(planes, 1, npix * 3, fp);
+}
@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+// Capture.h
+//
+//	Record frames and audio to an uncompressed .y4m video and a .wav
+//	file.  The emulation thread copies each finished frame once into
+//	a buffer from a fixed pool and queues it.  A writer thread converts
+//	and writes it.  If the writer falls behind and the pool runs dry,
+//	frames are dropped and counted so emulation never waits on disk.
+//
+
+#ifndef __CAPTURE_H__
+#define __CAPTURE_H__
+
+#include <stdint.h>
+#include <cstdio>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "FrameBuffer.h"
+#include "AudioRing.h"
+#include "WavWriter.h"
+
+#define CAPTURE_POOL_SIZE	8	// frame buffers
+#define CAPTURE_AUDIO_SIZE	65536	// samples queued for the writer
+
+class Capture {
+private:
+	struct Frame {
+		uint8_t		*data;		// width x height pixels
+		uint32_t	palette[FB_PALETTE_SIZE];
+		int		format;
+	};
+
+	Frame		pool[CAPTURE_POOL_SIZE];
+	int		width;
+	int		height;
+
+	// Both queues hold pool indices and are guarded by lock.
+	int		free_q[CAPTURE_POOL_SIZE];
+	int		n_free;
+	int		full_q[CAPTURE_POOL_SIZE];
+	int		full_head;
+	int		n_full;
+
+	std::mutex	lock;
+	std::condition_variable wake;
+	std::thread	writer;
+	bool		stopping;
+
+	AudioRing	*ring;
+	FILE		*fp;
+	WavWriter	wav;
+	uint8_t		*planes;	// Y, Cb, Cr for one frame
+
+	std::atomic<unsigned> frames;
+	std::atomic<unsigned> dropped;
+
+	void		writerLoop(void);
+	void		writeFrame(Frame *frame);
+	void		drainAudio(void);
+	void		freePool(void);
+public:
+	Capture();
+	~Capture();
+
+	bool		open(const char *basename, const FrameBuffer *fb,
+			     int fps_num, int fps_den, int audio_rate = 0,
+			     int aspect_num = 1, int aspect_den = 1);
+	void		close(void);
+	bool		isOpen(void) const
+	{ return this->fp != nullptr; }
+
+	// Emulation thread.
+	void		frame(const FrameBuffer *fb);
+	void		audio(const int16_t *data, int n);
+
+	unsigned	getFrames(void) const
+	{ return frames.load(std::memory_order_relaxed); }
+	unsigned	getDropped(void) const
+	{ return dropped.load(std::memory_order_relaxed); }
+	unsigned	getDroppedSamples(void) const
+	{ return ring ? ring->getOverruns() : 0; }
+};
+
+#endif // __CAPTURE_H__
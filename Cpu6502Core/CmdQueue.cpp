@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+// CmdQueue.cpp
+
+#include "CmdQueue.h"
+
+CmdQueue::CmdQueue()
+{
+	head = 0;
+	tail = 0;
+}
+
+// Producer side.  Returns false if the queue is full.
+bool
+CmdQueue::push(std::function<void (void)> cmd)
+{
+	unsigned h = head.load(std::memory_order_relaxed);
+
+	if (h - tail.load(std::memory_order_acquire) >= CMDQ_SIZE)
+		return false;
+
+	slots[h & (CMDQ_SIZE - 1)] = std::move(cmd);
+	head.store(h + 1, std::memory_order_release);
+
+	return true;
+}
+
+// Consumer side.  Run the oldest command, if any.
+bool
+CmdQueue::runOne(void)
+{
+	unsigned t = tail.load(std::memory_order_relaxed);
+
+	if (t == head.load(std::memory_order_acquire))
+		return false;
+
+	std::function<void (void)> cmd =
+		std::move(slots[t & (CMDQ_SIZE - 1)]);
+	slots[t & (CMDQ_SIZE - 1)] = nullptr;
+	tail.store(t + 1, std::memory_order_release);
+
+	cmd();
+
+	return true;
+}
+
+int
+CmdQueue::runAll(void)
+{
+	int n = 0;
+
+	while (runOne())
+		n++;
+
+	return n;
+}
@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+// CmdQueue.h
+//
+//	Single-producer single-consumer queue of commands.  The GUI thread
+//	posts input and menu commands that the emulation thread runs
+//	between slices, and the emulation thread posts notifications back
+//	the other way.  Neither side locks.
+//
+
+#ifndef __CMDQUEUE_H__
+#define __CMDQUEUE_H__
+
+#include <atomic>
+#include <functional>
+
+#define CMDQ_SIZE	256	// power of 2
+
+class CmdQueue {
+private:
+	std::function<void (void)> slots[CMDQ_SIZE];
+
+	std::atomic<unsigned> head;	// advanced by producer
+	std::atomic<unsigned> tail;	// advanced by consumer
+public:
+	CmdQueue();
+
+	bool	push(std::function<void (void)> cmd);
+	bool	runOne(void);
+	int	runAll(void);
+
+	bool	isEmpty(void) const
+	{ return head.load(std::memory_order_acquire) ==
+			tail.load(std::memory_order_acquire); }
+};
+
+#endif // __CMDQUEUE_H__
@@ -29,6 +29,7 @@
 
 #include "Cpu6502.h"
 #include "MemSpace.h"
+#include "SaveState.h"
 
 #if defined(CPU65C02) && defined(ILL6502)
 #error "Cpu6502: CPU65C02 and ILL6502 are mutally exclusive."
@@ -67,6 +68,23 @@ Cpu6502::Cpu6502(MemSpace *memspace)
 	step_flag = false;
 	hitbrk = false;
 	nbpts = 0;
+
+	// Power-on state isn't defined, but zero it so that saved and
+	// hashed states don't pick up whatever was in memory before.
+	a = 0;
+	x = 0;
+	y = 0;
+	sp = 0;
+	p = P_1;
+	pc = 0;
+	irq_signal = false;
+	needs_nmi = false;
+	doing_int = false;
+	pagedelay = false;
+	cyclenum = 0;
+	opcode = 0;
+	operand = 0;
+	opaddr = 0;
 }
 
 #ifdef DEBUG6502
@@ -133,8 +151,12 @@ Cpu6502::reset(void)
 	irq_signal = false;
 	needs_nmi = false;
 	doing_int = false;
+	pagedelay = false;
 	step_flag = false;
 	cyclenum = 0;
+	opcode = 0;
+	operand = 0;
+	opaddr = 0;
 }
 
 void
@@ -2095,6 +2117,54 @@ Cpu6502::nmiReq(void)
 	needs_nmi = true;
 }
 
+// Registers and where the CPU is within an instruction.  Breakpoints
+// belong to the debugger and aren't saved.
+void
+Cpu6502::saveState(StateWriter &w)
+{
+	w.beginChunk("CPU ");
+	w.put8(a);
+	w.put8(x);
+	w.put8(y);
+	w.put8(sp);
+	w.put8(p);
+	w.put16(pc);
+	w.putBool(irq_signal);
+	w.putBool(needs_nmi);
+	w.putBool(doing_int);
+	w.putBool(pagedelay);
+	w.put16(cyclenum);
+	w.put8(opcode);
+	w.put8(operand);
+	w.put16(opaddr);
+	w.endChunk();
+}
+
+void
+Cpu6502::loadState(StateReader &r)
+{
+	if (!r.openChunk("CPU "))
+		return;
+	a = r.get8();
+	x = r.get8();
+	y = r.get8();
+	sp = r.get8();
+	p = r.get8();
+	pc = r.get16();
+	irq_signal = r.getBool();
+	needs_nmi = r.getBool();
+	doing_int = r.getBool();
+	pagedelay = r.getBool();
+	cyclenum = (int16_t)r.get16();
+	opcode = r.get8();
+	operand = r.get8();
+	opaddr = r.get16();
+	r.endChunk();
+
+	step_flag = false;
+	hitbrk = false;
+}
+
 void
 Cpu6502::stepCpu(void)
 {
@@ -32,6 +32,9 @@
 
 #define NBPTS	4
 
+class StateWriter;
+class StateReader;
+
 class Cpu6502 {
 private:
 	uint8_t		read_byte(uint16_t addr);
@@ -112,6 +115,8 @@ public:
 	bool		cycle(void);
 	void		setIrq(bool level);
 	void		nmiReq(void);
+	void		saveState(StateWriter &w);
+	void		loadState(StateReader &r);
 
 	// Setter/getters for debuggers.
 	uint16_t	getPc(void)
@@ -128,11 +133,28 @@ public:
 	{ return sp; }
 	uint8_t		getP(void)
 	{ return p; }
+	void		setA(uint8_t a)
+	{ this->a = a; }
+	void		setX(uint8_t x)
+	{ this->x = x; }
+	void		setY(uint8_t y)
+	{ this->y = y; }
+	void		setSp(uint8_t sp)
+	{ this->sp = sp; }
+	void		setP(uint8_t p)
+	{ this->p = p; }
+	// Between instructions, when the next cycle fetches an opcode.
+	bool		isFetching(void)
+	{ return cyclenum == 0 && !doing_int; }
 	MemSpace	*getMemSpace(void)
 	{ return mem; }
 	void		stepCpu(void);
 	void		setBreak(int i, uint16_t addr);
 	void		setNumBreaks(int _n);
+	int		getNumBreaks(void)
+	{ return nbpts; }
+	bool		isStepping(void)
+	{ return step_flag; }
 };
 
 #endif // __CPU6502_H__
@@ -29,6 +29,7 @@
 #include "Cpu6502GtkDebug.h"
 
 #include "Cpu6502.h"
+#include "DirtyPages.h"
 
 #include <cstdio>
 
@@ -45,6 +46,8 @@ Cpu6502GtkDebug::Cpu6502GtkDebug(Cpu6502 *_cpu)
 
 	cpu = _cpu;
 	memspace = cpu->getMemSpace();
+	dirty = memspace->getDirtyPages();
+	memshown = false;
 
 	showIllOps = false;
 	numi = 0;
@@ -1125,13 +1128,19 @@ Cpu6502GtkDebug::setState(bool visible, bool _running)
 		visible, running);
 
 	if (visible) {
+		if (dirty && !debugWin->get_visible())
+			dirty->startTracking();
 		debugWin->set_visible(true);
 		this->running = _running;
 
 		updateDebugger();
 		updateMemDisp();
-	} else
+	} else {
+		if (dirty && debugWin->get_visible())
+			dirty->stopTracking();
 		debugWin->set_visible(false);
+		memshown = false;
+	}
 }
 
 // Display button for memory window is pressed
@@ -1389,6 +1398,25 @@ Cpu6502GtkDebug::updateInstrDisp(uint16_t addr, uint16_t pc, bool top)
 	asmView->get_buffer()->set_text(idispbuf);
 }
 
+// Could anything in the memory display have changed since it was drawn?
+// Only pages the machine says change solely through writes can be ruled
+// out.
+bool
+Cpu6502GtkDebug::memChanged(void)
+{
+	if (!dirty || !memshown || memaddr != memshown_addr)
+		return true;
+
+	for (int p = memaddr >> DIRTY_PAGE_SHIFT;
+	     p <= (memaddr + MEMDISPSZ - 1) >> DIRTY_PAGE_SHIFT &&
+		     p < DIRTY_NUM_PAGES; p++)
+		if (!dirty->isTracked(p) ||
+		    dirty->changedSince(p, memshown_gen))
+			return true;
+
+	return false;
+}
+
 void
 Cpu6502GtkDebug::updateMemDisp(void)
 {
@@ -1397,6 +1425,9 @@ Cpu6502GtkDebug::updateMemDisp(void)
 
 	DPRINTF(1, "Cpu6502GtkDebug::%s: addr=0x%x\n", __func__, memaddr);
 
+	if (!memChanged())
+		return;
+
 	uint16_t maddr = memaddr;
 	char disbuf[MEMDISPSZ / 8 * 48], *s = disbuf;
 	uint8_t mdata[8];
@@ -1430,4 +1461,10 @@ Cpu6502GtkDebug::updateMemDisp(void)
 	*s++ = '\0';
 
 	memView->get_buffer()->set_text(disbuf);
+
+	if (dirty) {
+		memshown = true;
+		memshown_addr = memaddr;
+		memshown_gen = dirty->nextGeneration();
+	}
 }
@@ -28,6 +28,7 @@
 
 class Cpu6502;
 class MemSpace;
+class DirtyPages;
 
 #define NINSTRS		32
 #define MEMDISPSZ 	0x100
@@ -72,6 +73,12 @@ private:
         uint16_t	memaddr;
 	uint16_t	disaddr;
 
+	// What the memory display last showed, to skip redundant redraws.
+	DirtyPages	*dirty;
+	bool		memshown;
+	uint16_t	memshown_addr;
+	uint32_t	memshown_gen;
+
 	// State of debug disassembly display.
 	int		numi;
 	uint16_t	iaddrs[NINSTRS];
@@ -91,6 +98,7 @@ private:
 	void		updateDebugger(void);
 	void		updateInstrDisp(uint16_t addr, uint16_t pc, bool top);
 	void		updateMemDisp(void);
+	bool		memChanged(void);
 public:
 	Cpu6502GtkDebug(Cpu6502 *_cpu);
 	void		connectSignals(Glib::RefPtr<Gtk::Builder> builder);
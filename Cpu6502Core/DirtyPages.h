@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// DirtyPages.h
+//
+//	Which 256 byte pages of a machine's address space have been
+//	written.  The write path calls mark() on every RAM write.  That is
+//	one OR of a flag that is zero while tracking is off, so it costs
+//	the same either way and never branches.  A byte per page rather
+//	than a bit keeps it to that single OR.
+//
+//	Any number of consumers can share one map.  Each keeps the
+//	generation nextGeneration() handed it, which also clears the map,
+//	and later asks changedSince() about the pages it cares about.  When
+//	a generation closes its dirty pages are stamped with it so nothing
+//	is lost to the other consumers.
+//
+
+#ifndef __DIRTYPAGES_H__
+#define __DIRTYPAGES_H__
+
+#include <stdint.h>
+#include <string.h>
+
+#define DIRTY_PAGE_SHIFT	8
+#define DIRTY_NUM_PAGES		256
+
+class DirtyPages {
+private:
+	uint8_t		dirty[DIRTY_NUM_PAGES];	// written this generation
+	uint32_t	stamp[DIRTY_NUM_PAGES];	// last closed gen written
+	bool		tracked[DIRTY_NUM_PAGES]; // changes only by mark()
+	uint32_t	generation;
+	int		users;
+	uint8_t		on;
+public:
+	DirtyPages(void) : generation(1), users(0), on(0)
+	{
+		memset(dirty, 0, sizeof(dirty));
+		memset(stamp, 0, sizeof(stamp));
+		memset(tracked, 0, sizeof(tracked));
+	}
+
+	// Write path.
+	void		mark(uint16_t addr)
+	{ dirty[addr >> DIRTY_PAGE_SHIFT] |= on; }
+	void		markRange(uint16_t addr, int len)
+	{
+		for (int i = 0; i < len; i += (1 << DIRTY_PAGE_SHIFT))
+			mark(addr + i);
+		if (len > 0)
+			mark(addr + len - 1);
+	}
+	void		markAll(void)
+	{ memset(dirty, on, sizeof(dirty)); }
+
+	// Pages whose contents only change through mark(), as opposed to
+	// I/O or mirrors.  Set up once by the machine.
+	void		setTracked(int page, int n)
+	{
+		for (int i = page; i < page + n && i < DIRTY_NUM_PAGES; i++)
+			tracked[i] = true;
+	}
+	bool		isTracked(int page) const
+	{ return tracked[page]; }
+
+	// Tracking is on while anyone uses it.  Turning it on marks
+	// everything, since nothing was seen while it was off.
+	void		startTracking(void)
+	{
+		if (users++ == 0) {
+			on = 1;
+			markAll();
+		}
+	}
+	void		stopTracking(void)
+	{
+		if (users > 0 && --users == 0)
+			on = 0;
+	}
+	bool		isTracking(void) const
+	{ return on != 0; }
+
+	// Consumers.
+	bool		isDirty(int page) const
+	{ return dirty[page] != 0; }
+	bool		changedSince(int page, uint32_t gen) const
+	{ return !on || dirty[page] || stamp[page] >= gen; }
+	uint32_t	getGeneration(void) const
+	{ return generation; }
+	uint32_t	nextGeneration(void)
+	{
+		for (int i = 0; i < DIRTY_NUM_PAGES; i++)
+			if (dirty[i]) {
+				stamp[i] = generation;
+				dirty[i] = 0;
+			}
+		return ++generation;
+	}
+};
+
+#endif // __DIRTYPAGES_H__
@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+// EmuThread.cpp
+
+#include <stdint.h>
+#include <climits>
+
+#include "EmuThread.h"
+
+#ifdef DEBUGEMU
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGEMU) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+EmuThread::EmuThread(Cpu6502 *_cpu, int clock_rate, int frame_cycles)
+	: pacer(clock_rate, frame_cycles)
+{
+	cpu = _cpu;
+	state = EMU_PARKED;
+	turbo_shown = false;
+
+	thread = std::thread(&EmuThread::loop, this);
+}
+
+EmuThread::~EmuThread()
+{
+	run(false);
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		state = EMU_QUIT;
+	}
+	wake.notify_all();
+	thread.join();
+}
+
+// Start or stop the machine.  Stopping waits until the thread has
+// parked at an instruction boundary so the GUI may then use the
+// machine directly, e.g. for the debugger.
+void
+EmuThread::run(bool flag)
+{
+	DPRINTF(1, "EmuThread::%s: flag=%d\n", __func__, flag);
+
+	std::unique_lock<std::mutex> guard(lock);
+
+	if (flag) {
+		if (state != EMU_PARKED)
+			return;
+		// Commands posted while parking ran late; run them first.
+		cmds.runAll();
+		state = EMU_RUNNING;
+		wake.notify_all();
+		return;
+	}
+
+	if (state == EMU_RUNNING)
+		state = EMU_PAUSING;
+	while (state == EMU_PAUSING)
+		wake.wait(guard);
+	cmds.runAll();
+}
+
+// Queue a command for the machine.  If the thread is parked the GUI
+// owns the machine and the command runs right away.
+void
+EmuThread::post(std::function<void (void)> cmd)
+{
+	while (!cmds.push(cmd))
+		std::this_thread::yield();
+
+	if (state.load(std::memory_order_acquire) == EMU_PARKED) {
+		std::lock_guard<std::mutex> guard(lock);
+		if (state == EMU_PARKED)
+			cmds.runAll();
+	}
+}
+
+void
+EmuThread::postGui(std::function<void (void)> cmd)
+{
+	while (!gui_cmds.push(cmd))
+		std::this_thread::yield();
+
+	if (notify_cb)
+		notify_cb();
+}
+
+// Run notifications from the machine.  GUI thread only.
+void
+EmuThread::runGui(void)
+{
+	gui_cmds.runAll();
+}
+
+void
+EmuThread::loop(void)
+{
+	std::unique_lock<std::mutex> guard(lock);
+
+	for (;;) {
+		while (state == EMU_PARKED)
+			wake.wait(guard);
+		if (state == EMU_QUIT)
+			break;
+
+		guard.unlock();
+		runSlices();
+		guard.lock();
+	}
+}
+
+// Run slices until asked to pause or the CPU stops on its own.  Each
+// slice runs whatever the pacer says is owed, normally one frame, then
+// sleeps until the next frame is due.
+void
+EmuThread::runSlices(void)
+{
+	pacer.reset();
+
+	while (state.load(std::memory_order_acquire) == EMU_RUNNING) {
+		cmds.runAll();
+
+		if (busy_fn)
+			pacer.setBusy(busy_fn());
+		int n = pacer.owed();
+		if (pacer.inTurbo() != turbo_shown) {
+			turbo_shown = pacer.inTurbo();
+			if (turbo_cb)
+				turbo_cb(turbo_shown);
+		}
+		if (!slice_fn(n)) {
+			// Breakpoint or single step.
+			park();
+			if (stop_cb)
+				postGui(stop_cb);
+			return;
+		}
+		pacer.ran(n);
+		pacer.wait();
+	}
+
+	// Asked to pause: finish the current instruction.
+	cpu->stepCpu();
+	slice_fn(INT_MAX);
+	park();
+}
+
+void
+EmuThread::park(void)
+{
+	cmds.runAll();
+
+	std::lock_guard<std::mutex> guard(lock);
+	if (state != EMU_QUIT)
+		state = EMU_PARKED;
+	wake.notify_all();
+}
@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+// EmuThread.h
+//
+//	Runs a machine on its own thread, away from the GUI main loop.
+//	The GUI owns the machine only while the thread is parked; while it
+//	runs, the GUI talks to the machine by posting commands that are run
+//	between slices.  Notifications come back through a second queue
+//	that the GUI drains when told to by the notify callback.
+//
+
+#ifndef __EMUTHREAD_H__
+#define __EMUTHREAD_H__
+
+#include <stdint.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+#include "MemSpace.h"
+#include "Cpu6502.h"
+#include "CmdQueue.h"
+#include "Pacer.h"
+
+class EmuThread {
+private:
+	enum { EMU_PARKED, EMU_RUNNING, EMU_PAUSING, EMU_QUIT };
+
+	Cpu6502		*cpu;
+	Pacer		pacer;
+
+	std::thread	thread;
+	std::mutex	lock;
+	std::condition_variable wake;
+	std::atomic<int> state;
+
+	CmdQueue	cmds;		// GUI to machine
+	CmdQueue	gui_cmds;	// machine to GUI
+
+	bool		turbo_shown;	// last told to turbo_cb
+
+	std::function<bool (int)> slice_fn;
+	std::function<bool (void)> busy_fn;
+	std::function<void (bool)> turbo_cb;
+	std::function<void (void)> stop_cb;
+	std::function<void (void)> notify_cb;
+
+	void		loop(void);
+	void		runSlices(void);
+	void		park(void);
+public:
+	EmuThread(Cpu6502 *_cpu, int clock_rate, int frame_cycles);
+	~EmuThread();
+
+	void		run(bool flag);
+	bool		isRunning(void) const
+	{ return state.load(std::memory_order_acquire) != EMU_PARKED; }
+	void		setTurbo(bool flag)
+	{ pacer.setTurbo(flag); }
+	// Run in turbo while the busy function says storage is busy.
+	void		setAutoTurbo(bool flag)
+	{ pacer.setAutoTurbo(flag); }
+	const Pacer	*getPacer(void) const
+	{ return &this->pacer; }
+
+	// GUI thread.
+	void		post(std::function<void (void)> cmd);
+	void		runGui(void);
+
+	// Machine thread.
+	void		postGui(std::function<void (void)> cmd);
+
+	// Run n clocks, returning false if the CPU stopped early.
+	void		setSliceFunc(std::function<bool (int)> _fn)
+	{ this->slice_fn = _fn; }
+	// Polled between slices: is a disk or tape busy?
+	void		setBusyFunc(std::function<bool (void)> _fn)
+	{ this->busy_fn = _fn; }
+	// Called on the machine thread when the pacer goes in or out of
+	// turbo, e.g. so the display skips frames.
+	void		setTurboCallback(std::function<void (bool)> _cb)
+	{ this->turbo_cb = _cb; }
+	// Posted to the GUI when a breakpoint or step stops the thread.
+	void		setStopCallback(std::function<void (void)> _cb)
+	{ this->stop_cb = _cb; }
+	// Called on the machine thread when postGui() queued something.
+	// A GUI wakes its main loop here, e.g. with Glib::Dispatcher.
+	void		setNotifyCallback(std::function<void (void)> _cb)
+	{ this->notify_cb = _cb; }
+};
+
+#endif // __EMUTHREAD_H__
@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// FrameBuffer.cpp
+
+#include <stdint.h>
+#include <string.h>
+
+#include "FrameBuffer.h"
+#include "StateHash.h"
+
+FrameBuffer::FrameBuffer(int _width, int _height)
+{
+	width = _width;
+	height = _height;
+	format = FB_INDEXED;
+	data = nullptr;
+	stride = 0;
+
+	// Default palette is a grey ramp.
+	for (int i = 0; i < FB_PALETTE_SIZE; i++)
+		setPalette(i, i, i, i);
+
+	frame_count = 0;
+	hash = 0;
+	hash_valid = false;
+	clearDirty();
+}
+
+// Supply memory for height rows of stride bytes.  A null pointer turns
+// rendering off.
+void
+FrameBuffer::setBuffer(void *_data, int _stride, int _format)
+{
+	data = (uint8_t *)_data;
+	stride = _stride;
+	format = _format;
+
+	hash_valid = false;
+	dirty_top = 0;
+	dirty_bottom = height - 1;
+}
+
+// Set palette entry used for FB_RGBA.  Entries are kept in memory byte
+// order so a pixel is one 32-bit store.
+void
+FrameBuffer::setPalette(int idx, uint8_t r, uint8_t g, uint8_t b)
+{
+	uint8_t rgba[4] = { r, g, b, 0xff };
+
+	memcpy(&palette[idx], rgba, sizeof(palette[idx]));
+}
+
+// Write n pixels starting at x, y.
+void
+FrameBuffer::putSpan(int x, int y, const uint8_t idx[], int n)
+{
+	if (format == FB_INDEXED)
+		memcpy(data + y * stride + x, idx, n);
+	else {
+		uint32_t *p = (uint32_t *)(data + y * stride) + x;
+		for (int i = 0; i < n; i++)
+			p[i] = palette[idx[i]];
+	}
+
+	markDirty(y, y);
+}
+
+// Set the entire frame to one color.
+void
+FrameBuffer::fill(uint8_t idx)
+{
+	for (int y = 0; y < height; y++) {
+		if (format == FB_INDEXED)
+			memset(data + y * stride, idx, width);
+		else {
+			uint32_t *p = (uint32_t *)(data + y * stride);
+			for (int x = 0; x < width; x++)
+				p[x] = palette[idx];
+		}
+	}
+
+	markDirty(0, height - 1);
+}
+
+void
+FrameBuffer::clearDirty(void)
+{
+	dirty_top = height;
+	dirty_bottom = -1;
+}
+
+// Called by the renderer when a frame has been completely drawn.  The
+// callback may look at the dirty rows; they are cleared afterward.
+void
+FrameBuffer::frameComplete(void)
+{
+	frame_count++;
+
+	if (frame_cb)
+		frame_cb(this);
+
+	clearDirty();
+}
+
+// Hash of the visible pixels, only computed when asked for.
+uint64_t
+FrameBuffer::getHash(void)
+{
+	if (hash_valid || !data)
+		return hash;
+
+	int rowlen = format == FB_INDEXED ? width : width * 4;
+
+	hash = HASH_FNV_BASIS;
+	for (int y = 0; y < height; y++)
+		hash = hashWords(data + y * stride, rowlen, hash);
+	hash_valid = true;
+
+	return hash;
+}
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// FrameBuffer.h
+//
+//	Frame buffer that a machine's renderer draws into.  Memory is
+//	supplied by the caller and holds either 8-bit palette indices or
+//	32-bit RGBA pixels looked up in a palette.  Without memory, the
+//	renderer skips drawing altogether.
+//
+
+#ifndef __FRAMEBUFFER_H__
+#define __FRAMEBUFFER_H__
+
+#include <stdint.h>
+#include <functional>
+
+#define FB_INDEXED	0	// one byte palette index per pixel
+#define FB_RGBA		1	// four bytes R, G, B, A per pixel
+
+#define FB_PALETTE_SIZE	256
+
+class FrameBuffer {
+private:
+	int		width;
+	int		height;
+	int		format;
+	uint8_t		*data;
+	int		stride;		// bytes per row
+
+	uint32_t	palette[FB_PALETTE_SIZE];
+
+	int		dirty_top;	// rows changed since frame complete
+	int		dirty_bottom;
+	unsigned	frame_count;
+	uint64_t	hash;
+	bool		hash_valid;
+
+	std::function<void (FrameBuffer *)> frame_cb;
+public:
+	FrameBuffer(int _width, int _height);
+
+	void		setBuffer(void *_data, int _stride, int _format);
+	// Switch to other memory of the same layout without marking rows
+	// dirty, e.g. when swapping buffers with a presenter.
+	void		setData(void *_data)
+	{ this->data = (uint8_t *)_data; }
+	void		setPalette(int idx, uint8_t r, uint8_t g, uint8_t b);
+
+	// Renderer interface.
+	bool		isActive(void) const
+	{ return data != nullptr; }
+	void		putSpan(int x, int y, const uint8_t idx[], int n);
+	void		fill(uint8_t idx);
+	void		frameComplete(void);
+
+	// Consumer interface.
+	int		getWidth(void) const
+	{ return width; }
+	int		getHeight(void) const
+	{ return height; }
+	int		getFormat(void) const
+	{ return format; }
+	int		getStride(void) const
+	{ return stride; }
+	uint8_t		*getRow(int y) const
+	{ return data + y * stride; }
+	const uint32_t	*getPalette(void) const
+	{ return palette; }
+	unsigned	getFrameCount(void) const
+	{ return frame_count; }
+	bool		isDirty(void) const
+	{ return dirty_top <= dirty_bottom; }
+	int		getDirtyTop(void) const
+	{ return dirty_top; }
+	int		getDirtyBottom(void) const
+	{ return dirty_bottom; }
+	void		clearDirty(void);
+	uint64_t	getHash(void);
+
+	void		setFrameCallback(std::function<void (FrameBuffer *)>
+					 _cb)
+	{ this->frame_cb = _cb; }
+
+	// Mark rows changed by a renderer writing rows directly.
+	void		markDirty(int top, int bottom)
+	{
+		if (top < dirty_top)
+			dirty_top = top;
+		if (bottom > dirty_bottom)
+			dirty_bottom = bottom;
+		hash_valid = false;
+	}
+};
+
+#endif // __FRAMEBUFFER_H__
@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+// FrameSwap.cpp
+
+#include <stdint.h>
+#include <string.h>
+
+#include "FrameSwap.h"
+
+// Take over three buffers of fb's size and layout.  The renderer draws
+// into buffer 0 first.
+FrameSwap::FrameSwap(FrameBuffer *_fb, void *buf0, void *buf1, void *buf2,
+		     int stride, int format)
+{
+	fb = _fb;
+	bufs[0] = (uint8_t *)buf0;
+	bufs[1] = (uint8_t *)buf1;
+	bufs[2] = (uint8_t *)buf2;
+	size = stride * fb->getHeight();
+
+	back = 0;
+	ready = 1;
+	front = 2;
+	pending = false;
+	turbo = false;
+
+	fb->setBuffer(bufs[back], stride, format);
+}
+
+// End of an emulated frame.  Publish it if anything changed since the
+// last one published, unless in turbo and the presenter hasn't caught
+// up yet.
+void
+FrameSwap::frameDone(bool dirty)
+{
+	pending = pending || dirty;
+	if (!pending)
+		return;
+
+	if (turbo.load(std::memory_order_relaxed) &&
+	    (ready.load(std::memory_order_relaxed) & FS_FRESH) != 0)
+		return;
+
+	publish();
+}
+
+// Hand the back buffer to the presenter and take the older waiting
+// buffer in exchange.  Renderers only redraw what changed, so the new
+// back buffer starts as a copy of the frame just published.
+void
+FrameSwap::publish(void)
+{
+	int prev = back;
+
+	back = ready.exchange(prev | FS_FRESH, std::memory_order_acq_rel) &
+		~FS_FRESH;
+	memcpy(bufs[back], bufs[prev], size);
+	fb->setData(bufs[back]);
+	pending = false;
+}
+
+// Take the newest finished frame, if there is one the presenter has not
+// seen.  Returns true if the front buffer changed.
+bool
+FrameSwap::acquire(void)
+{
+	if ((ready.load(std::memory_order_relaxed) & FS_FRESH) == 0)
+		return false;
+
+	front = ready.exchange(front, std::memory_order_acq_rel) & ~FS_FRESH;
+
+	return true;
+}
@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+// FrameSwap.h
+//
+//	Triple buffering between a renderer on the emulation thread and a
+//	presenter on the GUI thread.  The renderer always has a back buffer
+//	to draw into, the presenter always has a complete front buffer to
+//	show, and the newest finished frame waits in the middle.  Neither
+//	side ever waits for the other.
+//
+//	In turbo a finished frame is only handed over once the presenter
+//	has taken the last one, so running flat out doesn't spend its time
+//	copying frames that will never be shown.
+//
+
+#ifndef __FRAMESWAP_H__
+#define __FRAMESWAP_H__
+
+#include <stdint.h>
+#include <atomic>
+
+#include "FrameBuffer.h"
+
+#define FS_NBUFS	3
+#define FS_FRESH	4	// flag in ready: not yet seen by presenter
+
+class FrameSwap {
+private:
+	FrameBuffer	*fb;
+	uint8_t		*bufs[FS_NBUFS];
+	int		size;		// bytes per buffer
+
+	int		back;		// renderer's
+	int		front;		// presenter's
+	std::atomic<int> ready;		// index | FS_FRESH
+
+	bool		pending;	// back buffer has unpublished changes
+	std::atomic<bool> turbo;
+public:
+	FrameSwap(FrameBuffer *_fb, void *buf0, void *buf1, void *buf2,
+		  int stride, int format);
+
+	// Renderer side.
+	void		frameDone(bool dirty);
+	void		publish(void);
+	// End of a frame that isn't to be shown.  Its changes go out
+	// with the next frame that is.
+	void		frameHeld(bool dirty)
+	{ pending = pending || dirty; }
+
+	void		setTurbo(bool flag)
+	{ turbo.store(flag, std::memory_order_relaxed); }
+
+	// Presenter side.
+	bool		acquire(void);
+	int		getFront(void) const
+	{ return front; }
+};
+
+#endif // __FRAMESWAP_H__
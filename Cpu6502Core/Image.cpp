@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Image.cpp
+
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Image.h"
+
+#ifdef DEBUGIMAGE
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGIMAGE) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+Image::~Image()
+{
+	if (map_addr)
+		munmap(map_addr, size);
+}
+
+ImageRef
+Image::wrap(const uint8_t *data, size_t len)
+{
+	Image *image = new Image;
+
+	image->data = data;
+	image->size = len;
+
+	return ImageRef(image);
+}
+
+ImageRef
+Image::copy(const uint8_t *data, size_t len)
+{
+	return adopt(std::vector<uint8_t>(data, data + len));
+}
+
+ImageRef
+Image::adopt(std::vector<uint8_t> &&data)
+{
+	Image *image = new Image;
+
+	image->buf = std::move(data);
+	image->data = image->buf.data();
+	image->size = image->buf.size();
+
+	return ImageRef(image);
+}
+
+// Pages of the file are only read in as they are used, and are shared
+// with every other process mapping it.  An empty file can't be mapped
+// so it gets an empty image.
+ImageRef
+Image::map(const char *filename)
+{
+	struct stat st;
+	int fd = open(filename, O_RDONLY);
+
+	if (fd < 0)
+		return nullptr;
+	if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+		close(fd);
+		return nullptr;
+	}
+
+	Image *image = new Image;
+
+	if (st.st_size > 0) {
+		void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE,
+				  fd, 0);
+		if (addr == MAP_FAILED) {
+			close(fd);
+			delete image;
+			return nullptr;
+		}
+		image->map_addr = addr;
+		image->data = (const uint8_t *)addr;
+		image->size = st.st_size;
+	}
+	close(fd);
+
+	DPRINTF(1, "Image::%s: %s size=%zu\n", __func__, filename,
+		image->size);
+
+	return ImageRef(image);
+}
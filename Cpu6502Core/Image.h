@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Image.h
+//
+//	Shared media images: ROMs, cartridges and disks.  An Image never
+//	changes once made, so any number of machines can hold references
+//	to one copy, and it goes away with the last of them.  Its bytes are
+//	compiled into the program, mapped from a file or in a buffer of its
+//	own.
+//
+//	Media a machine writes to go through a CowImage, which shares the
+//	image until the first write and then makes a private copy.  ROM
+//	space is a RomPages table of pages into images, so a machine only
+//	keeps its own copy of a page something only partly fills.
+//
+
+#ifndef __IMAGE_H__
+#define __IMAGE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+#include <memory>
+
+#include "StateHash.h"
+
+class Image;
+typedef std::shared_ptr<const Image> ImageRef;
+
+class Image {
+private:
+	const uint8_t	*data;
+	size_t		size;
+	void		*map_addr;	// or null if not mapped
+	std::vector<uint8_t> buf;
+
+	Image(void) : data(nullptr), size(0), map_addr(nullptr) { }
+public:
+	~Image();
+
+	// Data that outlives every machine, like compiled-in ROMs.
+	static ImageRef	wrap(const uint8_t *data, size_t len);
+	static ImageRef	copy(const uint8_t *data, size_t len);
+	static ImageRef	adopt(std::vector<uint8_t> &&data);
+	// Map a whole file read-only.  Returns null if it can't.
+	static ImageRef	map(const char *filename);
+
+	const uint8_t	*getData(void) const
+	{ return data; }
+	size_t		getSize(void) const
+	{ return size; }
+	bool		isMapped(void) const
+	{ return map_addr != nullptr; }
+};
+
+// Writable media.  Reads see the image until the first edit() copies it.
+class CowImage {
+private:
+	ImageRef	image;
+	std::vector<uint8_t> copy;
+	const uint8_t	*data;
+	size_t		size;
+public:
+	CowImage(void) : data(nullptr), size(0) { }
+
+	void		set(ImageRef _image)
+	{
+		image = _image;
+		std::vector<uint8_t>().swap(copy);
+		data = image ? image->getData() : nullptr;
+		size = image ? image->getSize() : 0;
+	}
+	ImageRef	getImage(void) const
+	{ return image; }
+
+	const uint8_t	*getData(void) const
+	{ return data; }
+	size_t		getSize(void) const
+	{ return size; }
+	bool		isCopied(void) const
+	{ return !copy.empty(); }
+
+	uint8_t		*edit(void)
+	{
+		if (copy.empty() && size > 0) {
+			copy.assign(data, data + size);
+			data = copy.data();
+		}
+		return copy.data();
+	}
+};
+
+#define ROM_PAGE_SHIFT	11	// 2K, the smallest ROM chip
+
+// Offsets 0 to PAGES << SHIFT of ROM space.  Pages nothing was put in
+// read as zero.
+template <int PAGES, int SHIFT = ROM_PAGE_SHIFT>
+class RomPages {
+private:
+	enum { PAGE_SIZE = 1 << SHIFT };
+
+	const uint8_t	*page[PAGES];
+	ImageRef	image[PAGES];
+	std::unique_ptr<uint8_t[]> own[PAGES];	// private copies
+
+	uint8_t		*makeOwn(int p)
+	{
+		if (!own[p]) {
+			own[p].reset(new uint8_t[PAGE_SIZE]);
+			memcpy(own[p].get(), page[p], PAGE_SIZE);
+			page[p] = own[p].get();
+			image[p] = nullptr;
+		}
+		return own[p].get();
+	}
+public:
+	RomPages(void)
+	{
+		static const uint8_t blank[PAGE_SIZE] = { 0 };
+
+		for (int p = 0; p < PAGES; p++)
+			page[p] = blank;
+	}
+
+	uint8_t		read(int off) const
+	{ return page[off >> SHIFT][off & (PAGE_SIZE - 1)]; }
+	uint64_t	hash(void) const
+	{
+		uint64_t h = HASH_FNV_BASIS;
+
+		for (int p = 0; p < PAGES; p++)
+			h = hashBytes(page[p], PAGE_SIZE, h);
+		return h;
+	}
+	void		write(int off, uint8_t d8)
+	{ makeOwn(off >> SHIFT)[off & (PAGE_SIZE - 1)] = d8; }
+
+	// Put len bytes of an image, from offset from, at off.
+	void		set(int off, ImageRef img, size_t from, int len)
+	{
+		if (from + len > img->getSize())
+			len = from < img->getSize() ? img->getSize() - from : 0;
+		if (off + len > PAGES * PAGE_SIZE)
+			len = PAGES * PAGE_SIZE - off;
+
+		while (len > 0) {
+			int p = off >> SHIFT;
+			int o = off & (PAGE_SIZE - 1);
+			int n = len < PAGE_SIZE - o ? len : PAGE_SIZE - o;
+
+			if (n == PAGE_SIZE) {
+				own[p].reset();
+				image[p] = img;
+				page[p] = img->getData() + from;
+			} else
+				memcpy(makeOwn(p) + o, img->getData() + from,
+				       n);
+
+			off += n;
+			from += n;
+			len -= n;
+		}
+	}
+};
+
+#endif // __IMAGE_H__
@@ -0,0 +1,243 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Media.cpp
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "Media.h"
+#include "StateHash.h"
+
+#ifdef DEBUGMEDIA
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGMEDIA) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+#define D64_SIZE	174848		// 683 sectors
+#define D64_ERR_SIZE	175531		// and a byte of error per sector
+#define D64_BAM		(357 * 256)	// track 18 sector 0
+#define DSK_SIZE	143360		// 35 tracks of 16 256 byte sectors
+#define NIB_SIZE	(35 * 6656)	// 35 tracks of 6656 nibbles
+
+static const KnownRom known_roms[] = {
+	{ "PET BASIC 1", MEDIA_PET, 1, 0xc000, 0x3800,
+	  0x4bd62004a180f753ULL },
+	{ "PET BASIC 2", MEDIA_PET, 2, 0xc000, 0x3800,
+	  0x7d044c14690cced4ULL },
+	{ "PET BASIC 4", MEDIA_PET, 4, 0xb000, 0x4800,
+	  0x3faf7dac42e558c1ULL },
+	{ "Apple ][+", MEDIA_APPLE, 1, 0xd000, 0x3000,
+	  0x397ac9c54aebd6fdULL },
+};
+
+#define NUM_KNOWN_ROMS	(sizeof(known_roms) / sizeof(known_roms[0]))
+
+// Media type from the file name's extension or, failing that, its
+// length if only one type of disk is that long.
+int
+Media::typeOf(const std::string &filename, size_t len)
+{
+	static const struct {
+		const char	*ext;
+		int		type;
+	} exts[] = {
+		{ "bin", MEDIA_ROM },
+		{ "rom", MEDIA_ROM },
+		{ "prg", MEDIA_PRG },
+		{ "d64", MEDIA_D64 },
+		{ "dsk", MEDIA_DSK },
+		{ "do", MEDIA_DSK },
+		{ "po", MEDIA_DSK },
+		{ "nib", MEDIA_NIB },
+		{ "a26", MEDIA_CART },
+	};
+
+	size_t dot = filename.find_last_of("./");
+	if (dot != std::string::npos && filename[dot] == '.') {
+		std::string ext = filename.substr(dot + 1);
+		for (size_t i = 0; i < ext.size(); i++)
+			ext[i] = tolower(ext[i]);
+
+		for (size_t i = 0; i < sizeof(exts) / sizeof(exts[0]); i++)
+			if (ext == exts[i].ext)
+				return exts[i].type;
+	}
+
+	switch (len) {
+	case D64_SIZE:
+	case D64_ERR_SIZE:
+		return MEDIA_D64;
+	case DSK_SIZE:
+		return MEDIA_DSK;
+	case NIB_SIZE:
+		return MEDIA_NIB;
+	}
+
+	return MEDIA_UNKNOWN;
+}
+
+// Check data is something a machine can use as media of type.  Returns
+// what's wrong with it, or nullptr if nothing is.
+const char *
+Media::check(int type, const uint8_t *data, size_t len)
+{
+	switch (type) {
+	case MEDIA_ROM:
+		if (len == 0 || len > 0x10000 || (len & 0xff) != 0)
+			return "ROM isn't a whole number of pages";
+		break;
+	case MEDIA_PRG:
+		if (len < 3)
+			return "program is empty";
+		if ((data[0] | data[1] << 8) + len - 2 > 0x10000)
+			return "program runs past the end of memory";
+		break;
+	case MEDIA_D64:
+		if (len != D64_SIZE && len != D64_ERR_SIZE)
+			return "disk isn't a 35 track D64";
+		// The BAM sector links to the directory.
+		if (data[D64_BAM] != 18)
+			return "disk has no directory on track 18";
+		break;
+	case MEDIA_DSK:
+		if (len != DSK_SIZE)
+			return "disk isn't 35 tracks of 16 sectors";
+		break;
+	case MEDIA_NIB:
+		if (len != NIB_SIZE)
+			return "disk isn't 35 tracks of nibbles";
+		break;
+	case MEDIA_CART:
+		if (len != 0x800 && len != 0x1000 && len != 0x2000)
+			return "cartridge isn't 2K, 4K or 8K";
+		// The reset vector must point into the cartridge.
+		if ((data[len - 3] & 0x10) == 0)
+			return "cartridge has no reset vector";
+		break;
+	default:
+		return "unknown media type";
+	}
+
+	return nullptr;
+}
+
+// Map a media file and check it.  With type MEDIA_UNKNOWN the type
+// comes from typeOf().
+ImageRef
+Media::open(const std::string &filename, int type, std::string &error)
+{
+	errno = 0;
+	ImageRef image = Image::map(filename.c_str());
+	if (!image) {
+		error = errno ? strerror(errno) : "not a regular file";
+		return nullptr;
+	}
+
+	if (type == MEDIA_UNKNOWN)
+		type = typeOf(filename, image->getSize());
+
+	const char *msg = check(type, image->getData(), image->getSize());
+	if (msg) {
+		error = msg;
+		return nullptr;
+	}
+
+	DPRINTF(1, "Media::%s: %s type=%d size=%zu\n", __func__,
+		filename.c_str(), type, image->getSize());
+
+	return image;
+}
+
+// Look a ROM up in the index by its size and hash.
+const KnownRom *
+Media::identify(const uint8_t *data, size_t len)
+{
+	uint64_t hash = 0;
+
+	for (size_t i = 0; i < NUM_KNOWN_ROMS; i++) {
+		if (known_roms[i].size != len)
+			continue;
+		if (hash == 0)
+			hash = hashBytes(data, len);
+		if (known_roms[i].hash == hash) {
+			DPRINTF(1, "Media::%s: %s\n", __func__,
+				known_roms[i].name);
+			return &known_roms[i];
+		}
+	}
+
+	return nullptr;
+}
+
+// Find a known ROM for a machine and model in the ROM directory.
+// Files are recognized by their contents, not their names.
+ImageRef
+Media::findRom(int machine, int model)
+{
+	const char *dir = getenv(MEDIA_ROMDIR_ENV);
+	const KnownRom *known = nullptr;
+
+	for (size_t i = 0; i < NUM_KNOWN_ROMS; i++)
+		if (known_roms[i].machine == machine &&
+		    known_roms[i].model == model)
+			known = &known_roms[i];
+	if (!dir || !known)
+		return nullptr;
+
+	DIR *dp = opendir(dir);
+	if (!dp)
+		return nullptr;
+
+	ImageRef found;
+	struct dirent *de;
+	while (!found && (de = readdir(dp)) != nullptr) {
+		std::string path = std::string(dir) + "/" + de->d_name;
+		struct stat st;
+
+		if (stat(path.c_str(), &st) < 0 || !S_ISREG(st.st_mode) ||
+		    (size_t)st.st_size != known->size)
+			continue;
+
+		ImageRef image = Image::map(path.c_str());
+		if (image && hashBytes(image->getData(), image->getSize()) ==
+		    known->hash)
+			found = image;
+	}
+	closedir(dp);
+
+	DPRINTF(1, "Media::%s: %s %s\n", __func__, known->name,
+		found ? "found" : "not found");
+
+	return found;
+}
@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Media.h
+//
+//	Loading media files: ROMs, programs, disks and cartridges.  Files
+//	are mapped read-only as Images and checked for a size and layout
+//	the machines can use before any of them sees the bytes.
+//
+//	Known system ROMs are listed by size and hash, so a ROM file can be
+//	recognized whatever it's called, and the machine model it belongs
+//	to picked from it.  Known ROMs are also looked for in the directory
+//	named by EM6502_ROMS in place of the ones compiled in.
+//
+
+#ifndef __MEDIA_H__
+#define __MEDIA_H__
+
+#include <stdint.h>
+#include <string>
+
+#include "Image.h"
+
+// Media types.
+#define MEDIA_UNKNOWN	0
+#define MEDIA_ROM	1	// ROM image
+#define MEDIA_PRG	2	// program after a two byte load address
+#define MEDIA_D64	3	// CBM disk, 35 tracks
+#define MEDIA_DSK	4	// Disk II sectors (.dsk, .do, .po)
+#define MEDIA_NIB	5	// Disk II nibbles
+#define MEDIA_CART	6	// Atari 2600 cartridge
+
+// Machines in the known ROM index.
+#define MEDIA_PET	1
+#define MEDIA_APPLE	2
+
+#define MEDIA_ROMDIR_ENV	"EM6502_ROMS"
+
+struct KnownRom {
+	const char	*name;
+	int		machine;
+	int		model;
+	uint16_t	addr;		// where it's loaded
+	size_t		size;
+	uint64_t	hash;		// hashBytes() of the whole image
+};
+
+class Media {
+public:
+	static int	typeOf(const std::string &filename, size_t len = 0);
+	static const char *check(int type, const uint8_t *data, size_t len);
+	static ImageRef	open(const std::string &filename, int type,
+			     std::string &error);
+
+	static const KnownRom *identify(const uint8_t *data, size_t len);
+	static const KnownRom *identify(ImageRef image)
+	{ return identify(image->getData(), image->getSize()); }
+	static ImageRef	findRom(int machine, int model);
+};
+
+#endif // __MEDIA_H__
@@ -31,10 +31,16 @@
 #ifndef __MEMSPACE_H__
 #define __MEMSPACE_H__
 
+class DirtyPages;
+
 class MemSpace {
 public:
 	virtual uint8_t read(uint16_t addr) = 0;
 	virtual void write(uint16_t addr, uint8_t d8) = 0;
+
+	// Pages written through this space, if the machine tracks them.
+	virtual DirtyPages *getDirtyPages(void)
+	{ return nullptr; }
 };
 
 #endif // __MEMSPACE_H__
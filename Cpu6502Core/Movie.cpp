@@ -0,0 +1,348 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Movie.cpp
+
+#include <stdint.h>
+#include <string.h>
+#include <cstdio>
+
+#include "Movie.h"
+#include "StateHash.h"
+
+#ifdef DEBUGMOVIE
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGMOVIE) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+#define MOVIE_MAGIC	"E6MV"
+#define MOVIE_HDR_SIZE	22	// through length
+#define MOVIE_EVENT_SIZE 20
+
+static void
+put16(std::vector<uint8_t> &buf, uint16_t v)
+{
+	buf.push_back(v & 0xff);
+	buf.push_back(v >> 8);
+}
+
+static void
+put32(std::vector<uint8_t> &buf, uint32_t v)
+{
+	put16(buf, v & 0xffff);
+	put16(buf, v >> 16);
+}
+
+static void
+put64(std::vector<uint8_t> &buf, uint64_t v)
+{
+	put32(buf, v & 0xffffffff);
+	put32(buf, v >> 32);
+}
+
+static uint16_t
+get16(const uint8_t *p)
+{
+	return p[0] | p[1] << 8;
+}
+
+static uint32_t
+get32(const uint8_t *p)
+{
+	return get16(p) | (uint32_t)get16(p + 2) << 16;
+}
+
+static uint64_t
+get64(const uint8_t *p)
+{
+	return get32(p) | (uint64_t)get32(p + 4) << 32;
+}
+
+Movie::Movie(const char *_machine, int _frame_cycles)
+{
+	memcpy(machine, _machine, 4);
+	frame_cycles = _frame_cycles;
+	mode = MOVIE_IDLE;
+
+	clock = 0;
+	length = 0;
+	next_hash = 0;
+	next_event = 0;
+
+	checked = 0;
+	mismatches = 0;
+	first_mismatch = 0;
+}
+
+// FNV-1a over the machine's save state, unless the machine keeps a
+// hash of its own.  Either covers everything that matters to where the
+// machine goes next and nothing of the host's.
+uint64_t
+Movie::stateHash(void)
+{
+	if (hash_fn)
+		return hash_fn();
+
+	save_fn(w);
+
+	return hashBytes(w.getData(), w.getSize());
+}
+
+// Frame boundary: record the hash or check it against the recording.
+void
+Movie::frame(void)
+{
+	uint64_t h = stateHash();
+
+	if (mode == MOVIE_RECORDING)
+		hashes.push_back(h);
+	else {
+		size_t i = next_hash / frame_cycles - 1;
+
+		if (i < hashes.size()) {
+			checked++;
+			if (hashes[i] != h && mismatches++ == 0) {
+				first_mismatch = clock;
+				DPRINTF(1, "Movie::%s: mismatch at %llu\n",
+					__func__, (unsigned long long)clock);
+			}
+		}
+	}
+
+	next_hash += frame_cycles;
+}
+
+// Apply the events due now and stop at the end of the recording.
+void
+Movie::applyDue(void)
+{
+	while (next_event < events.size() &&
+	       events[next_event].clock <= clock)
+		input_fn(events[next_event++]);
+
+	if (clock >= length) {
+		DPRINTF(1, "Movie::%s: done checked=%u mismatches=%u\n",
+			__func__, checked, mismatches);
+		mode = MOVIE_IDLE;
+		if (done_cb)
+			done_cb();
+	}
+}
+
+// Start recording from the machine as it is now.
+bool
+Movie::record(void)
+{
+	DPRINTF(1, "Movie::%s:\n", __func__);
+
+	stop();
+
+	save_fn(w);
+	start.assign(w.getData(), w.getData() + w.getSize());
+	events.clear();
+	hashes.clear();
+
+	clock = 0;
+	length = 0;
+	next_hash = frame_cycles;
+	mode = MOVIE_RECORDING;
+
+	return true;
+}
+
+// Load the start state and play the recording from it.
+bool
+Movie::play(void)
+{
+	DPRINTF(1, "Movie::%s: length=%llu\n", __func__,
+		(unsigned long long)length);
+
+	stop();
+
+	StateReader r(start.data(), start.size());
+	if (start.empty() || !load_fn(r))
+		return false;
+
+	clock = 0;
+	next_hash = frame_cycles;
+	next_event = 0;
+	checked = 0;
+	mismatches = 0;
+	first_mismatch = 0;
+	mode = MOVIE_PLAYING;
+
+	applyDue();
+
+	return true;
+}
+
+void
+Movie::stop(void)
+{
+	if (mode == MOVIE_RECORDING)
+		length = clock;
+	mode = MOVIE_IDLE;
+}
+
+int
+Movie::until(int n) const
+{
+	if (mode == MOVIE_IDLE)
+		return n;
+
+	uint64_t to = next_hash;
+	if (mode == MOVIE_PLAYING) {
+		if (next_event < events.size() &&
+		    events[next_event].clock < to)
+			to = events[next_event].clock;
+		if (length < to)
+			to = length;
+	}
+
+	if (to - clock < (uint64_t)n)
+		n = (int)(to - clock);
+
+	return n;
+}
+
+void
+Movie::input(int type, int a, int b)
+{
+	if (mode != MOVIE_RECORDING)
+		return;
+
+	events.push_back({clock, type, a, b});
+}
+
+bool
+Movie::save(const char *filename) const
+{
+	std::vector<uint8_t> buf;
+
+	buf.insert(buf.end(), MOVIE_MAGIC, MOVIE_MAGIC + 4);
+	put16(buf, MOVIE_VERSION);
+	buf.insert(buf.end(), machine, machine + 4);
+	put32(buf, frame_cycles);
+	put64(buf, length);
+
+	put32(buf, start.size());
+	buf.insert(buf.end(), start.begin(), start.end());
+
+	put32(buf, events.size());
+	for (const InputEvent &in : events) {
+		put64(buf, in.clock);
+		put32(buf, in.type);
+		put32(buf, in.a);
+		put32(buf, in.b);
+	}
+
+	put32(buf, hashes.size());
+	for (uint64_t h : hashes)
+		put64(buf, h);
+
+	FILE *fp = fopen(filename, "wb");
+	if (!fp)
+		return false;
+	bool ok = fwrite(buf.data(), 1, buf.size(), fp) == buf.size();
+	if (fclose(fp) != 0)
+		ok = false;
+
+	return ok;
+}
+
+// Returns false, leaving the current movie alone, if the file can't be
+// read or isn't a movie of this machine.
+bool
+Movie::load(const char *filename)
+{
+	std::vector<uint8_t> buf;
+	uint8_t tmp[4096];
+	size_t n;
+
+	FILE *fp = fopen(filename, "rb");
+	if (!fp)
+		return false;
+	while ((n = fread(tmp, 1, sizeof(tmp), fp)) > 0)
+		buf.insert(buf.end(), tmp, tmp + n);
+	fclose(fp);
+
+	const uint8_t *p = buf.data();
+	const uint8_t *end = p + buf.size();
+
+	if (buf.size() < MOVIE_HDR_SIZE + 4 || memcmp(p, MOVIE_MAGIC, 4) ||
+	    get16(p + 4) != MOVIE_VERSION || memcmp(p + 6, machine, 4) ||
+	    get32(p + 10) != (uint32_t)frame_cycles) {
+		DPRINTF(1, "Movie::%s: not a %.4s movie\n", __func__, machine);
+		return false;
+	}
+	uint64_t len = get64(p + 14);
+	p += MOVIE_HDR_SIZE;
+
+	uint32_t state_len = get32(p);
+	p += 4;
+	if ((size_t)(end - p) < (size_t)state_len + 4)
+		return false;
+	std::vector<uint8_t> state(p, p + state_len);
+	p += state_len;
+
+	uint32_t nevents = get32(p);
+	p += 4;
+	if ((size_t)(end - p) / MOVIE_EVENT_SIZE < nevents)
+		return false;
+	std::vector<InputEvent> evs(nevents);
+	for (InputEvent &in : evs) {
+		in.clock = get64(p);
+		in.type = (int)get32(p + 8);
+		in.a = (int)get32(p + 12);
+		in.b = (int)get32(p + 16);
+		p += MOVIE_EVENT_SIZE;
+	}
+
+	if (end - p < 4)
+		return false;
+	uint32_t nhashes = get32(p);
+	p += 4;
+	if ((size_t)(end - p) / 8 < nhashes)
+		return false;
+	std::vector<uint64_t> hs(nhashes);
+	for (uint64_t &h : hs) {
+		h = get64(p);
+		p += 8;
+	}
+
+	stop();
+	length = len;
+	start = std::move(state);
+	events = std::move(evs);
+	hashes = std::move(hs);
+
+	DPRINTF(1, "Movie::%s: length=%llu events=%d hashes=%d\n", __func__,
+		(unsigned long long)length, (int)events.size(),
+		(int)hashes.size());
+
+	return true;
+}
@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Movie.h
+//
+//	Input movies.  A movie is a save state to start from, the input
+//	events applied after it, each stamped with the clock it went in
+//	at, and a hash of the machine state at every frame.  Playing it
+//	back applies each event on exactly the clock it was recorded at,
+//	so a run is the same on any host, in turbo or in a batch run, and
+//	the frame hashes say where it stops being the same.
+//
+//	file:	"E6MV" version(16) machine(4) frame_cycles(32) length(64)
+//		state_len(32) state[state_len]
+//		nevents(32) { clock(64) type(32) a(32) b(32) } ...
+//		nhashes(32) { hash(64) } ...
+//
+//	Hash i is of the state at clock (i + 1) * frame_cycles, from the
+//	machine's stateHash() if there is a hash function.  Like save
+//	states, movies don't hold ROMs or other media.  Everything but
+//	load() and save() runs on the emulation thread.
+//
+
+#ifndef __MOVIE_H__
+#define __MOVIE_H__
+
+#include <stdint.h>
+#include <vector>
+#include <functional>
+
+#include "SaveState.h"
+#include "InputEvent.h"
+
+#define MOVIE_VERSION	2
+
+class Movie {
+private:
+	enum { MOVIE_IDLE, MOVIE_RECORDING, MOVIE_PLAYING };
+
+	char		machine[4];
+	int		frame_cycles;
+	int		mode;
+
+	uint64_t	clock;		// clocks since the start state
+	uint64_t	length;		// clocks recorded
+	uint64_t	next_hash;
+	size_t		next_event;
+
+	std::vector<uint8_t> start;
+	std::vector<InputEvent> events;
+	std::vector<uint64_t> hashes;
+
+	unsigned	checked;
+	unsigned	mismatches;
+	uint64_t	first_mismatch;
+
+	StateWriter	w;
+
+	std::function<void (StateWriter &)> save_fn;
+	std::function<bool (StateReader &)> load_fn;
+	std::function<uint64_t (void)> hash_fn;
+	std::function<void (const InputEvent &)> input_fn;
+	std::function<void (void)> done_cb;
+
+	uint64_t	stateHash(void);
+	void		frame(void);
+	void		applyDue(void);
+public:
+	Movie(const char *_machine, int _frame_cycles);
+
+	// Save or load the whole machine.
+	void		setSaveFunc(std::function<void (StateWriter &)> _fn)
+	{ this->save_fn = _fn; }
+	void		setLoadFunc(std::function<bool (StateReader &)> _fn)
+	{ this->load_fn = _fn; }
+	// Hash the whole machine, or hash its save state if not set.
+	void		setHashFunc(std::function<uint64_t (void)> _fn)
+	{ this->hash_fn = _fn; }
+	// Apply a recorded input.
+	void		setInputFunc(std::function<void (const InputEvent &)>
+				     _fn)
+	{ this->input_fn = _fn; }
+	// Called when playback reaches the end.
+	void		setDoneCallback(std::function<void (void)> _cb)
+	{ this->done_cb = _cb; }
+
+	bool		record(void);
+	bool		play(void);
+	void		stop(void);
+
+	// Parked machine or other thread.
+	bool		load(const char *filename);
+	bool		save(const char *filename) const;
+
+	// Slice loop: run at most until() clocks, then report them.
+	int		until(int n) const;
+	void		ran(int n)
+	{
+		if (mode == MOVIE_IDLE)
+			return;
+		clock += n;
+		if (clock == next_hash)
+			frame();
+		if (mode == MOVIE_PLAYING)
+			applyDue();
+	}
+	void		input(int type, int a, int b);
+
+	bool		isRecording(void) const
+	{ return mode == MOVIE_RECORDING; }
+	bool		isPlaying(void) const
+	{ return mode == MOVIE_PLAYING; }
+	bool		isActive(void) const
+	{ return mode != MOVIE_IDLE; }
+	uint64_t	getClock(void) const
+	{ return clock; }
+	uint64_t	getLength(void) const
+	{ return length; }
+	unsigned	getChecked(void) const
+	{ return checked; }
+	unsigned	getMismatches(void) const
+	{ return mismatches; }
+	uint64_t	getFirstMismatch(void) const
+	{ return first_mismatch; }
+};
+
+#endif // __MOVIE_H__
@@ -0,0 +1,407 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Netplay.cpp
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netdb.h>
+
+#include "Netplay.h"
+
+#ifdef DEBUGNET
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGNET) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+#define NETPLAY_MAGIC	"E6NP"
+#define NETPLAY_HDR_SIZE 24
+#define NETPLAY_EVENT_SIZE 20
+#define NETPLAY_MAX_SIZE (NETPLAY_HDR_SIZE + \
+			  NETPLAY_MAX_EVENTS * NETPLAY_EVENT_SIZE)
+
+#define NETPLAY_STATE_MAGIC "E6NS"
+#define NETPLAY_ACK_MAGIC "E6NA"
+#define NETPLAY_STATE_HDR_SIZE 10
+#define NETPLAY_ACK_SIZE 6
+#define NETPLAY_MAX_STATE (65507 - NETPLAY_STATE_HDR_SIZE) // one datagram
+#define NETPLAY_RESEND_MS 50
+
+static void
+put16(uint8_t *p, uint16_t v)
+{
+	p[0] = v & 0xff;
+	p[1] = v >> 8;
+}
+
+static void
+put32(uint8_t *p, uint32_t v)
+{
+	put16(p, v & 0xffff);
+	put16(p + 2, v >> 16);
+}
+
+static void
+put64(uint8_t *p, uint64_t v)
+{
+	put32(p, v & 0xffffffff);
+	put32(p + 4, v >> 32);
+}
+
+static uint16_t
+get16(const uint8_t *p)
+{
+	return p[0] | p[1] << 8;
+}
+
+static uint32_t
+get32(const uint8_t *p)
+{
+	return get16(p) | (uint32_t)get16(p + 2) << 16;
+}
+
+static uint64_t
+get64(const uint8_t *p)
+{
+	return get32(p) | (uint64_t)get32(p + 4) << 32;
+}
+
+Netplay::Netplay(int _player)
+{
+	fd = -1;
+	memset(&peer, 0, sizeof(peer));
+	player = _player;
+
+	out_seq = 0;
+	in_seq = 0;
+	confirmed = 0;
+
+	delay_ms = 0;
+	loss = 0;
+	rng = 12345 + player;
+
+	sent = 0;
+	received = 0;
+	dropped = 0;
+}
+
+Netplay::~Netplay()
+{
+	close();
+}
+
+// Listen on port and send to host:peer_port.  Returns false if the
+// socket can't be set up or the host isn't found.
+bool
+Netplay::open(int port, const char *host, int peer_port)
+{
+	struct addrinfo hints, *res;
+
+	close();
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+	if (getaddrinfo(host, nullptr, &hints, &res) != 0)
+		return false;
+	memcpy(&peer, res->ai_addr, sizeof(peer));
+	peer.sin_port = htons(peer_port);
+	freeaddrinfo(res);
+
+	fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (fd < 0)
+		return false;
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	addr.sin_port = htons(port);
+	if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		close();
+		return false;
+	}
+
+	DPRINTF(1, "Netplay::%s: player=%d port=%d peer=%s:%d\n", __func__,
+		player, port, host, peer_port);
+
+	return true;
+}
+
+void
+Netplay::close(void)
+{
+	if (fd >= 0)
+		::close(fd);
+	fd = -1;
+	delayed.clear();
+}
+
+// Send now, or later if a test delay is set.  A test loss rate drops
+// packets at random.
+void
+Netplay::transmit(const uint8_t *data, int len)
+{
+	rng = rng * 1103515245 + 12345;
+	if (loss > 0 && (int)((rng >> 16) % 100) < loss) {
+		dropped++;
+		return;
+	}
+
+	if (delay_ms > 0) {
+		Delayed d;
+		d.when = clock::now() + std::chrono::milliseconds(delay_ms);
+		d.data.assign(data, data + len);
+		delayed.push_back(std::move(d));
+		return;
+	}
+
+	sendto(fd, data, len, 0, (struct sockaddr *)&peer, sizeof(peer));
+	sent++;
+}
+
+void
+Netplay::flushDelayed(void)
+{
+	clock::time_point now = clock::now();
+
+	while (!delayed.empty() && delayed.front().when <= now) {
+		const std::vector<uint8_t> &d = delayed.front().data;
+		sendto(fd, d.data(), d.size(), 0, (struct sockaddr *)&peer,
+		       sizeof(peer));
+		sent++;
+		delayed.pop_front();
+	}
+}
+
+// Next packet from the peer, skipping any from elsewhere.  Returns its
+// length, or -1 if there are no more for now.
+int
+Netplay::recvPeer(uint8_t *buf, int size)
+{
+	struct sockaddr_in from;
+	socklen_t fromlen;
+	ssize_t len;
+
+	for (;;) {
+		fromlen = sizeof(from);
+		len = recvfrom(fd, buf, size, MSG_DONTWAIT,
+			       (struct sockaddr *)&from, &fromlen);
+		if (len < 0)
+			return -1;
+		if (fromlen == sizeof(from) && from.sin_family == AF_INET &&
+		    from.sin_addr.s_addr == peer.sin_addr.s_addr &&
+		    from.sin_port == peer.sin_port)
+			return len;
+		DPRINTF(1, "Netplay::%s: packet not from peer\n", __func__);
+	}
+}
+
+void
+Netplay::sendStateAck(void)
+{
+	uint8_t buf[NETPLAY_ACK_SIZE];
+
+	memcpy(buf, NETPLAY_ACK_MAGIC, 4);
+	buf[4] = NETPLAY_VERSION;
+	buf[5] = player;
+	transmit(buf, NETPLAY_ACK_SIZE);
+}
+
+bool
+Netplay::exchangeState(std::vector<uint8_t> &state, int timeout_ms)
+{
+	std::vector<uint8_t> out, in(NETPLAY_STATE_HDR_SIZE +
+				     NETPLAY_MAX_STATE);
+
+	if (fd < 0 || (player == 0 && state.size() > NETPLAY_MAX_STATE))
+		return false;
+
+	if (player == 0) {
+		out.resize(NETPLAY_STATE_HDR_SIZE + state.size());
+		memcpy(&out[0], NETPLAY_STATE_MAGIC, 4);
+		out[4] = NETPLAY_VERSION;
+		out[5] = player;
+		put32(&out[6], state.size());
+		memcpy(&out[NETPLAY_STATE_HDR_SIZE], state.data(),
+		       state.size());
+	}
+
+	clock::time_point end = clock::now() +
+		std::chrono::milliseconds(timeout_ms);
+	clock::time_point resend = clock::now();
+	while (clock::now() < end) {
+		if (player == 0 && clock::now() >= resend) {
+			transmit(out.data(), out.size());
+			resend = clock::now() +
+				std::chrono::milliseconds(NETPLAY_RESEND_MS);
+		}
+		flushDelayed();
+
+		int len;
+		while ((len = recvPeer(in.data(), in.size())) >= 0) {
+			const uint8_t *p = in.data();
+
+			if (len < NETPLAY_ACK_SIZE ||
+			    p[4] != NETPLAY_VERSION || p[5] != 1 - player)
+				continue;
+
+			// Player 1 only sends input once it has the state,
+			// so that will do for an ack.
+			if (player == 0 &&
+			    (memcmp(p, NETPLAY_ACK_MAGIC, 4) == 0 ||
+			     memcmp(p, NETPLAY_MAGIC, 4) == 0))
+				return true;
+
+			if (player == 1 && len >= NETPLAY_STATE_HDR_SIZE &&
+			    memcmp(p, NETPLAY_STATE_MAGIC, 4) == 0) {
+				uint32_t n = get32(&p[6]);
+				if (n > len - NETPLAY_STATE_HDR_SIZE)
+					continue;
+				p += NETPLAY_STATE_HDR_SIZE;
+				state.assign(p, p + n);
+				sendStateAck();
+				return true;
+			}
+		}
+
+		usleep(1000);
+	}
+
+	DPRINTF(1, "Netplay::%s: no answer\n", __func__);
+	return false;
+}
+
+void
+Netplay::send(uint64_t local_confirmed)
+{
+	uint8_t buf[NETPLAY_MAX_SIZE];
+
+	if (fd < 0)
+		return;
+
+	// Events that don't fit go next time, so confirm only up to them.
+	int n = outbox.size();
+	if (n > NETPLAY_MAX_EVENTS) {
+		n = NETPLAY_MAX_EVENTS;
+		if (outbox[n].clock < local_confirmed)
+			local_confirmed = outbox[n].clock;
+	}
+
+	memcpy(buf, NETPLAY_MAGIC, 4);
+	buf[4] = NETPLAY_VERSION;
+	buf[5] = player;
+	put64(&buf[6], local_confirmed);
+	put32(&buf[14], in_seq);
+	put32(&buf[18], out_seq);
+	put16(&buf[22], n);
+
+	uint8_t *p = &buf[NETPLAY_HDR_SIZE];
+	for (int i = 0; i < n; i++) {
+		put64(p, outbox[i].clock);
+		put32(p + 8, outbox[i].type);
+		put32(p + 12, outbox[i].a);
+		put32(p + 16, outbox[i].b);
+		p += NETPLAY_EVENT_SIZE;
+	}
+
+	transmit(buf, p - buf);
+	flushDelayed();
+}
+
+bool
+Netplay::poll(std::function<void (const InputEvent &)> cb)
+{
+	uint8_t buf[NETPLAY_MAX_SIZE];
+	bool any = false;
+	ssize_t len;
+
+	if (fd < 0)
+		return false;
+
+	flushDelayed();
+
+	while ((len = recvPeer(buf, sizeof(buf))) >= 0) {
+		if (len < NETPLAY_ACK_SIZE ||
+		    buf[4] != NETPLAY_VERSION || buf[5] != 1 - player)
+			continue;
+
+		// Our ack of the start state was lost, so say it again.
+		// The state itself doesn't fit in buf, but that's fine.
+		if (memcmp(buf, NETPLAY_STATE_MAGIC, 4) == 0) {
+			sendStateAck();
+			continue;
+		}
+
+		if (len < NETPLAY_HDR_SIZE ||
+		    memcmp(buf, NETPLAY_MAGIC, 4) != 0)
+			continue;
+
+		uint64_t conf = get64(&buf[6]);
+		uint32_t ack = get32(&buf[14]);
+		uint32_t first = get32(&buf[18]);
+		int n = get16(&buf[22]);
+		if (len < NETPLAY_HDR_SIZE + n * NETPLAY_EVENT_SIZE)
+			continue;
+
+		received++;
+		any = true;
+
+		// The other side has everything before ack.
+		while (!outbox.empty() && (int32_t)(ack - out_seq) > 0) {
+			outbox.pop_front();
+			out_seq++;
+		}
+
+		// Take events in order.  A gap means packets were lost or
+		// came out of order, so wait for the missing events, which
+		// are sent again until acknowledged.  The confirmed clock
+		// covers them too and has to wait as well.
+		if ((int32_t)(first - in_seq) > 0)
+			continue;
+
+		const uint8_t *p = &buf[NETPLAY_HDR_SIZE];
+		for (int i = 0; i < n; i++, p += NETPLAY_EVENT_SIZE) {
+			if (first + i != in_seq)
+				continue;
+			InputEvent in = {get64(p), (int)get32(p + 8),
+					 (int)get32(p + 12),
+					 (int)get32(p + 16)};
+			cb(in);
+			in_seq++;
+		}
+
+		if (conf > confirmed)
+			confirmed = conf;
+	}
+
+	return any;
+}
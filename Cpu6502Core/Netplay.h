@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Netplay.h
+//
+//	Input exchange for netplay over UDP.  Each packet carries every
+//	local event the other side hasn't acknowledged yet, so a lost
+//	packet costs nothing but time, and the clock before which no more
+//	local events will come.  The receiver acknowledges by sequence
+//	number and only believes a confirmed clock once it holds every
+//	event sent before it.
+//
+//	packet:	"E6NP" version(8) player(8) confirmed(64) ack(32) first(32)
+//		n(16) { clock(64) type(32) a(32) b(32) } ...
+//
+//	Before play, player 0 sends the machine state both sides start
+//	from, again and again until player 1 acknowledges it:
+//
+//	state:	"E6NS" version(8) player(8) len(32) data...
+//	ack:	"E6NA" version(8) player(8)
+//
+//	Packets from anywhere but the peer are dropped.
+//
+//	For testing, outgoing packets can be delayed and randomly dropped.
+//
+
+#ifndef __NETPLAY_H__
+#define __NETPLAY_H__
+
+#include <stdint.h>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <functional>
+#include <netinet/in.h>
+
+#include "InputEvent.h"
+
+#define NETPLAY_VERSION	2
+#define NETPLAY_PORT	6502
+#define NETPLAY_MAX_EVENTS 64	// per packet
+
+class Netplay {
+private:
+	typedef std::chrono::steady_clock clock;
+
+	struct Delayed {
+		clock::time_point when;
+		std::vector<uint8_t> data;
+	};
+
+	int		fd;
+	struct sockaddr_in peer;
+	int		player;
+
+	std::deque<InputEvent> outbox;	// sent but not acknowledged
+	uint32_t	out_seq;	// sequence number of outbox[0]
+	uint32_t	in_seq;		// next remote event expected
+	uint64_t	confirmed;	// remote side's confirmed clock
+
+	int		delay_ms;
+	int		loss;		// percent
+	uint32_t	rng;
+	std::deque<Delayed> delayed;
+
+	unsigned	sent;
+	unsigned	received;
+	unsigned	dropped;
+
+	void		transmit(const uint8_t *data, int len);
+	void		flushDelayed(void);
+	int		recvPeer(uint8_t *buf, int size);
+	void		sendStateAck(void);
+public:
+	Netplay(int _player);
+	~Netplay();
+
+	bool		open(int port, const char *host, int peer_port);
+	void		close(void);
+
+	void		setDelay(int ms)
+	{ this->delay_ms = ms; }
+	void		setLoss(int percent)
+	{ this->loss = percent; }
+
+	// Player 0 sends state and player 1 receives it there.  Returns
+	// false if the other side doesn't answer within timeout_ms.
+	bool		exchangeState(std::vector<uint8_t> &state,
+				      int timeout_ms);
+
+	// Queue a local event for sending.
+	void		queue(const InputEvent &in)
+	{ outbox.push_back(in); }
+	// Send queued events along with the local confirmed clock.
+	void		send(uint64_t local_confirmed);
+	// Receive what has arrived, passing new remote events to cb in
+	// order.  Returns false if nothing did.
+	bool		poll(std::function<void (const InputEvent &)> cb);
+
+	uint64_t	getConfirmed(void) const
+	{ return confirmed; }
+	unsigned	getSent(void) const
+	{ return sent; }
+	unsigned	getReceived(void) const
+	{ return received; }
+	unsigned	getDropped(void) const
+	{ return dropped; }
+};
+
+#endif // __NETPLAY_H__
@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+// Pacer.cpp
+
+#include <stdint.h>
+#include <thread>
+
+#include "Pacer.h"
+
+#ifdef DEBUGPACE
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGPACE) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+Pacer::Pacer(int _clock_rate, int _frame_cycles)
+	: clock_rate(_clock_rate), frame_cycles(_frame_cycles)
+{
+	clock_hz = 0;
+	overruns = 0;
+	dropped = 0;
+	turbo = false;
+	auto_turbo = false;
+	busy = false;
+	in_turbo = false;
+
+	reset();
+}
+
+// Start emulated time over from now, e.g. after a pause.  Counters are
+// left alone.
+void
+Pacer::reset(void)
+{
+	rebase();
+	win_start = start;
+	win_cycles = 0;
+}
+
+// Emulated time catches up to now without touching the statistics.
+void
+Pacer::rebase(void)
+{
+	start = clock::now();
+	cycles = 0;
+}
+
+// Conversions split whole seconds off so they can't overflow.
+uint64_t
+Pacer::clocksAt(clock::time_point t) const
+{
+	int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		t - start).count();
+
+	if (ns <= 0)
+		return 0;
+
+	return (uint64_t)(ns / 1000000000) * clock_rate +
+		(uint64_t)(ns % 1000000000) * clock_rate / 1000000000;
+}
+
+Pacer::clock::time_point
+Pacer::timeAt(uint64_t c) const
+{
+	int64_t ns = (int64_t)(c / clock_rate) * 1000000000 +
+		(int64_t)(c % clock_rate) * 1000000000 / clock_rate;
+
+	return start + std::chrono::nanoseconds(ns);
+}
+
+// Clocks the machine should run now to be caught up with the wall
+// clock.  More than PACE_MAX_FRAMES behind, the excess is dropped.
+int
+Pacer::owed(void)
+{
+	bool t = turbo.load(std::memory_order_relaxed) ||
+		(busy && auto_turbo.load(std::memory_order_relaxed));
+	if (t != in_turbo) {
+		DPRINTF(1, "Pacer::%s: turbo=%d\n", __func__, t);
+
+		// Don't pay back time run ahead in turbo.
+		in_turbo = t;
+		rebase();
+	}
+
+	if (in_turbo)
+		return frame_cycles;
+
+	uint64_t due = clocksAt(clock::now());
+
+	if (due <= cycles)
+		return 0;
+
+	uint64_t n = due - cycles;
+	uint64_t max = (uint64_t)PACE_MAX_FRAMES * frame_cycles;
+	if (n > max) {
+		unsigned frames = (n - max) / frame_cycles;
+
+		DPRINTF(1, "Pacer::%s: behind %llu clocks, dropping %u\n",
+			__func__, (unsigned long long)n, frames);
+
+		dropped.fetch_add(frames, std::memory_order_relaxed);
+		cycles += n - max;
+		n = max;
+	}
+
+	return (int)n;
+}
+
+// The machine ran n clocks.
+void
+Pacer::ran(int n)
+{
+	cycles += n;
+	win_cycles += n;
+
+	auto now = clock::now();
+	auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		now - win_start).count();
+	if (ns >= 1000000000) {
+		clock_hz.store((int)(win_cycles * 1.0e9 / ns),
+			       std::memory_order_relaxed);
+		win_start = now;
+		win_cycles = 0;
+	}
+}
+
+// Sleep until the next emulated frame is due.  Getting here after it
+// was due means the last slice overran.
+void
+Pacer::wait(void)
+{
+	if (in_turbo)
+		return;
+
+	uint64_t next = (cycles / frame_cycles + 1) * frame_cycles;
+	clock::time_point t = timeAt(next);
+
+	if (clock::now() >= t) {
+		overruns.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	std::this_thread::sleep_until(t);
+}
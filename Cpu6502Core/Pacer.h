@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+// Pacer.h
+//
+//	Keeps emulated time locked to the wall clock.  Instead of running a
+//	fixed number of clocks per timer tick, the pacer works out how many
+//	clocks are owed since it was started and sleeps until the next
+//	emulated frame is due.  If the host falls far behind it gives up on
+//	the missed time rather than racing to catch up.
+//
+//	In turbo the pacer asks for a frame at a time and never sleeps.
+//	With auto turbo it also goes into turbo while the machine says a
+//	storage device is busy, and back to real time once it's idle.  The
+//	machine sees the same clocks either way.
+//
+
+#ifndef __PACER_H__
+#define __PACER_H__
+
+#include <stdint.h>
+#include <chrono>
+#include <atomic>
+
+#define PACE_MAX_FRAMES	3	// most frames owed before dropping some
+
+class Pacer {
+private:
+	typedef std::chrono::steady_clock clock;
+
+	int		clock_rate;
+	int		frame_cycles;
+
+	clock::time_point start;	// emulated time zero
+	uint64_t	cycles;		// clocks accounted for since start
+
+	std::atomic<bool> turbo;	// requested mode
+	std::atomic<bool> auto_turbo;	// turbo while busy
+	bool		busy;		// storage busy, from the machine
+	bool		in_turbo;	// mode of the running thread
+
+	clock::time_point win_start;	// one second statistics window
+	uint64_t	win_cycles;
+
+	std::atomic<int> clock_hz;	// clocks run per second, last window
+	std::atomic<unsigned> overruns;	// slices that missed their frame
+	std::atomic<unsigned> dropped;	// frames given up on
+
+	uint64_t	clocksAt(clock::time_point t) const;
+	clock::time_point timeAt(uint64_t c) const;
+	void		rebase(void);
+public:
+	Pacer(int _clock_rate, int _frame_cycles);
+
+	void		reset(void);
+	int		owed(void);
+	void		ran(int n);
+	void		wait(void);
+
+	void		setTurbo(bool flag)
+	{ turbo.store(flag, std::memory_order_relaxed); }
+	void		setAutoTurbo(bool flag)
+	{ auto_turbo.store(flag, std::memory_order_relaxed); }
+	// Running thread.
+	void		setBusy(bool flag)
+	{ this->busy = flag; }
+	bool		inTurbo(void) const
+	{ return in_turbo; }
+
+	int		getClockRate(void) const
+	{ return clock_rate; }
+	int		getClockHz(void) const
+	{ return clock_hz.load(std::memory_order_relaxed); }
+	double		getSpeed(void) const	// 1.0 is real time
+	{ return (double)getClockHz() / clock_rate; }
+	unsigned	getOverruns(void) const
+	{ return overruns.load(std::memory_order_relaxed); }
+	unsigned	getDropped(void) const
+	{ return dropped.load(std::memory_order_relaxed); }
+};
+
+#endif // __PACER_H__
@@ -0,0 +1,275 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Rewind.cpp
+
+#include <stdint.h>
+
+#include "Rewind.h"
+#include "DirtyPages.h"
+
+#ifdef DEBUGREWIND
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGREWIND) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+Rewind::Rewind(int _frame_cycles)
+{
+	frame_cycles = _frame_cycles;
+	interval = REWIND_INTERVAL;
+	key_interval = REWIND_KEY_INTERVAL;
+	budget = REWIND_BUDGET;
+
+	enabled = false;
+	replaying = false;
+	clock = 0;
+	dirty = nullptr;
+	key_gen = 0;
+
+	clear();
+}
+
+Rewind::~Rewind()
+{
+	if (enabled && dirty)
+		dirty->stopTracking();
+}
+
+void
+Rewind::setEnable(bool flag)
+{
+	DPRINTF(1, "Rewind::%s: flag=%d\n", __func__, flag);
+
+	if (flag == enabled)
+		return;
+
+	if (dirty) {
+		if (flag)
+			dirty->startTracking();
+		else
+			dirty->stopTracking();
+	}
+	enabled = flag;
+	clear();
+}
+
+void
+Rewind::setInterval(int frames, int key_snaps)
+{
+	interval = frames > 0 ? frames : 1;
+	key_interval = key_snaps > 0 ? key_snaps : 1;
+	clear();
+}
+
+void
+Rewind::setBudget(size_t bytes)
+{
+	budget = bytes;
+	trim();
+}
+
+// Without a dirty map every snapshot is a keyframe.
+void
+Rewind::setDirtyPages(DirtyPages *_dirty)
+{
+	if (enabled && dirty)
+		dirty->stopTracking();
+	dirty = _dirty;
+	if (enabled && dirty)
+		dirty->startTracking();
+	clear();
+}
+
+// Forget the history, e.g. when the ROM changes under it.  The next
+// slice starts it again with a keyframe.
+void
+Rewind::clear(void)
+{
+	snaps.clear();
+	inputs.clear();
+	used = 0;
+	since_key = 0;
+	next_snap = clock;
+}
+
+void
+Rewind::input(int type, int a, int b)
+{
+	if (!enabled || replaying)
+		return;
+
+	inputs.push_back({clock, type, a, b});
+}
+
+void
+Rewind::snapshot(void)
+{
+	bool key = !dirty || snaps.empty() || since_key >= key_interval;
+
+	w.setDelta(key ? nullptr : dirty, key_gen);
+	save_fn(w);
+	w.setDelta(nullptr, 0);
+
+	// Deltas hold pages written since the keyframe was taken.
+	if (key) {
+		if (dirty)
+			key_gen = dirty->nextGeneration();
+		since_key = 0;
+	} else
+		since_key++;
+
+	Snap s;
+	s.clock = clock;
+	s.key = key;
+	s.data.assign(w.getData(), w.getData() + w.getSize());
+	used += s.data.size();
+	snaps.push_back(std::move(s));
+
+	DPRINTF(2, "Rewind::%s: clock=%llu key=%d size=%d used=%d\n",
+		__func__, (unsigned long long)clock, key,
+		(int)w.getSize(), (int)used);
+
+	next_snap = clock + (uint64_t)interval * frame_cycles;
+	trim();
+}
+
+// Drop the oldest keyframe and its deltas until back under budget,
+// always keeping the newest keyframe.
+void
+Rewind::trim(void)
+{
+	while (used > budget) {
+		size_t k = 1;
+		while (k < snaps.size() && !snaps[k].key)
+			k++;
+		if (k >= snaps.size())
+			break;
+		while (k-- > 0) {
+			used -= snaps.front().data.size();
+			snaps.pop_front();
+		}
+	}
+
+	while (!inputs.empty() && !snaps.empty() &&
+	       inputs.front().clock < snaps.front().clock)
+		inputs.pop_front();
+}
+
+// Load snapshot n, which is its keyframe and then the delta if it is one.
+bool
+Rewind::load(size_t n)
+{
+	size_t k = n;
+	while (k > 0 && !snaps[k].key)
+		k--;
+
+	StateReader kr(snaps[k].data.data(), snaps[k].data.size());
+	if (!load_fn(kr))
+		return false;
+	if (k == n)
+		return true;
+
+	StateReader dr(snaps[n].data.data(), snaps[n].data.size());
+	return load_fn(dr);
+}
+
+// Run from the current clock to target, applying logged input on the
+// clock it first came in.
+void
+Rewind::replay(uint64_t target)
+{
+	replaying = true;
+
+	for (const InputEvent &in : inputs) {
+		if (in.clock < clock)
+			continue;
+		if (in.clock >= target)
+			break;
+		if (in.clock > clock) {
+			run_fn((int)(in.clock - clock));
+			clock = in.clock;
+		}
+		input_fn(in);
+	}
+	if (target > clock)
+		run_fn((int)(target - clock));
+	clock = target;
+
+	replaying = false;
+}
+
+// Go back the given number of frames, or as far as there is history.
+// What happened after that is forgotten.
+bool
+Rewind::seek(int frames)
+{
+	DPRINTF(1, "Rewind::%s: frames=%d\n", __func__, frames);
+
+	if (!enabled || snaps.empty())
+		return false;
+
+	uint64_t back = (uint64_t)frames * frame_cycles;
+	uint64_t target = clock > back ? clock - back : 0;
+	if (target < snaps.front().clock)
+		target = snaps.front().clock;
+
+	size_t n = snaps.size() - 1;
+	while (n > 0 && snaps[n].clock > target)
+		n--;
+
+	if (!load(n)) {
+		clear();
+		return false;
+	}
+
+	while (snaps.size() > n + 1) {
+		used -= snaps.back().data.size();
+		snaps.pop_back();
+	}
+	clock = snaps[n].clock;
+	replay(target);
+
+	while (!inputs.empty() && inputs.back().clock >= target)
+		inputs.pop_back();
+
+	// Loading marked all of RAM, so start a new keyframe.
+	next_snap = snaps[n].clock + (uint64_t)interval * frame_cycles;
+	since_key = key_interval;
+
+	return true;
+}
+
+// Frames of history that can be gone back.
+int
+Rewind::getHistory(void) const
+{
+	if (snaps.empty())
+		return 0;
+
+	return (int)((clock - snaps.front().clock) / frame_cycles);
+}
@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Rewind.h
+//
+//	Rewind history.  Every few frames the machine is snapshotted into a
+//	ring.  Most snapshots are deltas that hold only the RAM pages
+//	written since the last keyframe; a keyframe is a full state.  Input
+//	events are logged with the clock they were applied at.  Going back
+//	loads the nearest earlier snapshot and runs forward to the wanted
+//	frame, replaying the logged input.
+//
+//	The oldest keyframe and its deltas are dropped when the ring grows
+//	past its budget.  Everything here runs on the emulation thread.
+//
+
+#ifndef __REWIND_H__
+#define __REWIND_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <deque>
+#include <functional>
+
+#include "SaveState.h"
+#include "InputEvent.h"
+
+class DirtyPages;
+
+#define REWIND_INTERVAL		6	// frames between snapshots
+#define REWIND_KEY_INTERVAL	60	// snapshots between keyframes
+#define REWIND_BUDGET		(4 << 20)
+
+class Rewind {
+private:
+	struct Snap {
+		uint64_t	clock;
+		bool		key;
+		std::vector<uint8_t> data;
+	};
+
+	int		frame_cycles;
+	int		interval;	// frames between snapshots
+	int		key_interval;	// snapshots between keyframes
+	size_t		budget;		// bytes of snapshots kept
+
+	bool		enabled;
+	bool		replaying;
+	uint64_t	clock;		// clocks since history began
+	uint64_t	next_snap;
+	int		since_key;	// snapshots since last keyframe
+	size_t		used;
+
+	DirtyPages	*dirty;
+	uint32_t	key_gen;	// dirty generation at last keyframe
+
+	StateWriter	w;
+	std::deque<Snap> snaps;
+	std::deque<InputEvent> inputs;
+
+	std::function<void (StateWriter &)> save_fn;
+	std::function<bool (StateReader &)> load_fn;
+	std::function<void (int)> run_fn;
+	std::function<void (const InputEvent &)> input_fn;
+
+	void		snapshot(void);
+	void		trim(void);
+	bool		load(size_t n);
+	void		replay(uint64_t target);
+public:
+	Rewind(int _frame_cycles);
+	~Rewind();
+
+	void		setEnable(bool flag);
+	bool		isEnabled(void) const
+	{ return enabled; }
+	void		setInterval(int frames, int key_snaps);
+	void		setBudget(size_t bytes);
+	void		setDirtyPages(DirtyPages *_dirty);
+	void		clear(void);
+
+	// Save or load the whole machine.
+	void		setSaveFunc(std::function<void (StateWriter &)> _fn)
+	{ this->save_fn = _fn; }
+	void		setLoadFunc(std::function<bool (StateReader &)> _fn)
+	{ this->load_fn = _fn; }
+	// Run the machine n clocks, without coming back here.
+	void		setRunFunc(std::function<void (int)> _fn)
+	{ this->run_fn = _fn; }
+	// Apply a logged input again.
+	void		setInputFunc(std::function<void (const InputEvent &)>
+				     _fn)
+	{ this->input_fn = _fn; }
+
+	// Slice loop: run at most until() clocks, then report them.
+	int		until(int n) const
+	{
+		if (!enabled || next_snap - clock >= (uint64_t)n)
+			return n;
+		return (int)(next_snap - clock);
+	}
+	void		ran(int n)
+	{
+		clock += n;
+		if (enabled && clock >= next_snap)
+			snapshot();
+	}
+	void		input(int type, int a, int b);
+
+	bool		seek(int frames);
+
+	int		getHistory(void) const;
+	size_t		getUsed(void) const
+	{ return used; }
+};
+
+#endif // __REWIND_H__
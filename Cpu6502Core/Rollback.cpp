@@ -0,0 +1,263 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Rollback.cpp
+
+#include <stdint.h>
+#include <chrono>
+
+#include "Rollback.h"
+
+#ifdef DEBUGROLLBACK
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGROLLBACK) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+#define NO_REDO		(~(uint64_t)0)
+
+Rollback::Rollback(int _frame_cycles, int _player)
+{
+	frame_cycles = _frame_cycles;
+	player = _player;
+	delay = ROLLBACK_DELAY * frame_cycles;
+	window = ROLLBACK_WINDOW * frame_cycles;
+
+	clock = 0;
+	confirmed = 0;
+	redo = NO_REDO;
+	next_event = 0;
+
+	rollbacks = 0;
+	redo_frames = 0;
+	max_depth = 0;
+	redo_ns = 0;
+}
+
+// Local input delay.  Longer hides more network latency but makes the
+// game feel slower.  Both sides should use the same.
+void
+Rollback::setDelay(int frames)
+{
+	delay = (frames > 0 ? frames : 1) * frame_cycles;
+}
+
+void
+Rollback::setWindow(int frames)
+{
+	window = (frames > 0 ? frames : 1) * frame_cycles;
+}
+
+// Load the start state, which must be the same on both sides, and
+// start from there.  Returns false if it doesn't load.
+bool
+Rollback::start(const std::vector<uint8_t> &state)
+{
+	DPRINTF(1, "Rollback::%s: player=%d\n", __func__, player);
+
+	StateReader r(state.data(), state.size());
+	if (!load_fn(r))
+		return false;
+
+	clock = 0;
+	confirmed = 0;
+	redo = NO_REDO;
+	snaps.clear();
+	events.clear();
+	next_event = 0;
+
+	rollbacks = 0;
+	redo_frames = 0;
+	max_depth = 0;
+	redo_ns = 0;
+
+	snapshot();
+
+	return true;
+}
+
+// Insert in clock then player order, after events already there from
+// the same player.  One that lands among those already applied is late.
+void
+Rollback::insert(const InputEvent &in, int p)
+{
+	size_t i = events.size();
+	while (i > 0 && (events[i - 1].in.clock > in.clock ||
+			 (events[i - 1].in.clock == in.clock &&
+			  events[i - 1].player > p)))
+		i--;
+
+	bool late = i < next_event || in.clock < clock;
+
+	events.insert(events.begin() + i, {in, p});
+	if (i < next_event)
+		next_event++;
+
+	if (late && in.clock < redo) {
+		DPRINTF(2, "Rollback::%s: late clock=%llu now=%llu\n",
+			__func__, (unsigned long long)in.clock,
+			(unsigned long long)clock);
+		redo = in.clock;
+	}
+}
+
+InputEvent
+Rollback::local(int type, int a, int b)
+{
+	InputEvent in = {clock + delay, type, a, b};
+
+	insert(in, player);
+
+	return in;
+}
+
+void
+Rollback::remote(const InputEvent &in)
+{
+	insert(in, 1 - player);
+}
+
+// Drop snapshots and events that can no longer be rolled back to.
+void
+Rollback::setConfirmed(uint64_t _clock)
+{
+	if (_clock <= confirmed)
+		return;
+	confirmed = _clock;
+
+	uint64_t keep = confirmed < redo ? confirmed : redo;
+	while (snaps.size() > 1 && snaps[1].clock <= keep)
+		snaps.pop_front();
+
+	while (!events.empty() && next_event > 0 &&
+	       events.front().in.clock < snaps.front().clock) {
+		events.pop_front();
+		next_event--;
+	}
+}
+
+void
+Rollback::snapshot(void)
+{
+	save_fn(w);
+
+	Snap s;
+	s.clock = clock;
+	s.data.assign(w.getData(), w.getData() + w.getSize());
+	snaps.push_back(std::move(s));
+}
+
+void
+Rollback::applyDue(void)
+{
+	while (next_event < events.size() &&
+	       events[next_event].in.clock <= clock)
+		input_fn(events[next_event++].in);
+}
+
+// Account for n clocks run: snapshot at frame boundaries, before that
+// clock's input goes in.
+void
+Rollback::step(int n)
+{
+	clock += n;
+	if (clock % frame_cycles == 0)
+		snapshot();
+	applyDue();
+}
+
+int
+Rollback::until(int n) const
+{
+	uint64_t to = (clock / frame_cycles + 1) * frame_cycles;
+
+	if (next_event < events.size() && events[next_event].in.clock < to)
+		to = events[next_event].in.clock;
+	if (confirmed + window < to)
+		to = confirmed + window;
+
+	if (to <= clock)
+		return 0;
+	if (to - clock < (uint64_t)n)
+		n = (int)(to - clock);
+
+	return n;
+}
+
+void
+Rollback::sync(void)
+{
+	if (redo == NO_REDO) {
+		applyDue();
+		return;
+	}
+
+	auto t0 = std::chrono::steady_clock::now();
+	uint64_t now = clock;
+
+	size_t k = snaps.size() - 1;
+	while (k > 0 && snaps[k].clock > redo)
+		k--;
+	if (snaps[k].clock > redo)
+		DPRINTF(1, "Rollback::%s: no snapshot before %llu\n",
+			__func__, (unsigned long long)redo);
+
+	StateReader r(snaps[k].data.data(), snaps[k].data.size());
+	load_fn(r);
+	snaps.erase(snaps.begin() + k + 1, snaps.end());
+	clock = snaps[k].clock;
+	redo = NO_REDO;
+
+	next_event = 0;
+	while (next_event < events.size() &&
+	       events[next_event].in.clock < clock)
+		next_event++;
+	applyDue();
+
+	// Run back up to the present.
+	while (clock < now) {
+		uint64_t to = (clock / frame_cycles + 1) * frame_cycles;
+		if (next_event < events.size() &&
+		    events[next_event].in.clock < to)
+			to = events[next_event].in.clock;
+		if (now < to)
+			to = now;
+		run_fn((int)(to - clock));
+		step((int)(to - clock));
+	}
+
+	int depth = (int)((now - snaps[k].clock + frame_cycles - 1) /
+			  frame_cycles);
+	rollbacks++;
+	redo_frames += depth;
+	if (depth > max_depth)
+		max_depth = depth;
+	redo_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - t0).count();
+
+	DPRINTF(2, "Rollback::%s: depth=%d\n", __func__, depth);
+}
@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Rollback.h
+//
+//	Rollback for netplay.  Each side runs its own machine, both loaded
+//	from the same start state, and the two exchange only input events,
+//	each stamped with the clock it is to be applied at.  Local input
+//	is stamped a little into the future so it usually reaches the
+//	other side in time.  When a remote event
+//	turns up for a clock already run, the machine is loaded from the
+//	last snapshot before it and run again to the present with the
+//	event in place.
+//
+//	A snapshot is taken at every frame.  Those older than the newest
+//	one before the remote side's confirmed clock, the clock before
+//	which it promises to send nothing more, are dropped.  The machine
+//	doesn't run more than a window of frames past the confirmed clock.
+//
+//	Events on the same clock are applied in player order, so both
+//	sides see the same thing.  Everything here runs on one thread.
+//
+
+#ifndef __ROLLBACK_H__
+#define __ROLLBACK_H__
+
+#include <stdint.h>
+#include <vector>
+#include <deque>
+#include <functional>
+
+#include "SaveState.h"
+#include "InputEvent.h"
+
+#define ROLLBACK_DELAY	2	// frames local input is delayed
+#define ROLLBACK_WINDOW	30	// most frames past the confirmed clock
+
+class Rollback {
+private:
+	struct Snap {
+		uint64_t	clock;
+		std::vector<uint8_t> data;
+	};
+	struct Event {
+		InputEvent	in;
+		int		player;
+	};
+
+	int		frame_cycles;
+	int		player;		// local player, 0 or 1
+	int		delay;		// clocks
+	int		window;		// clocks
+
+	uint64_t	clock;
+	uint64_t	confirmed;	// remote input before this is all in
+	uint64_t	redo;		// earliest late event, or ~0
+
+	std::deque<Snap> snaps;
+	std::deque<Event> events;	// sorted by clock then player
+	size_t		next_event;	// first not yet applied
+
+	StateWriter	w;
+
+	unsigned	rollbacks;
+	uint64_t	redo_frames;	// frames run again
+	int		max_depth;	// frames
+	int64_t		redo_ns;
+
+	std::function<void (StateWriter &)> save_fn;
+	std::function<bool (StateReader &)> load_fn;
+	std::function<void (int)> run_fn;
+	std::function<void (const InputEvent &)> input_fn;
+
+	void		insert(const InputEvent &in, int p);
+	void		step(int n);
+	void		snapshot(void);
+	void		applyDue(void);
+public:
+	Rollback(int _frame_cycles, int _player);
+
+	// Save or load the whole machine.
+	void		setSaveFunc(std::function<void (StateWriter &)> _fn)
+	{ this->save_fn = _fn; }
+	void		setLoadFunc(std::function<bool (StateReader &)> _fn)
+	{ this->load_fn = _fn; }
+	// Run n clocks.
+	void		setRunFunc(std::function<void (int)> _fn)
+	{ this->run_fn = _fn; }
+	// Apply an input.
+	void		setInputFunc(std::function<void (const InputEvent &)>
+				     _fn)
+	{ this->input_fn = _fn; }
+
+	void		setDelay(int frames);
+	void		setWindow(int frames);
+	bool		start(const std::vector<uint8_t> &state);
+
+	// Local input, returned stamped for sending to the other side.
+	InputEvent	local(int type, int a, int b);
+	void		remote(const InputEvent &in);
+	void		setConfirmed(uint64_t _clock);
+	// Local input before this clock is all stamped already.
+	uint64_t	getLocalConfirmed(void) const
+	{ return clock + delay; }
+
+	// Run again from before any late remote input.
+	void		sync(void);
+
+	// Slice loop: run at most until() clocks, then report them.  Zero
+	// means waiting for the other side.
+	int		until(int n) const;
+	void		ran(int n)
+	{ step(n); }
+
+	uint64_t	getClock(void) const
+	{ return clock; }
+	unsigned	getRollbacks(void) const
+	{ return rollbacks; }
+	uint64_t	getRedoFrames(void) const
+	{ return redo_frames; }
+	int		getMaxDepth(void) const
+	{ return max_depth; }
+	int64_t		getRedoNs(void) const
+	{ return redo_ns; }
+};
+
+#endif // __ROLLBACK_H__
@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// RunAhead.cpp
+
+#include <stdint.h>
+
+#include "RunAhead.h"
+
+#ifdef DEBUGRUNAHEAD
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGRUNAHEAD) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+RunAhead::RunAhead(int _frame_cycles)
+{
+	frame_cycles = _frame_cycles;
+	frames = 0;
+	mode = RUNAHEAD_OFF;
+	countdown = frame_cycles;
+
+	win_start = clock::now();
+	win_ns = 0;
+	win_frames = 0;
+
+	cost_us = 0;
+	skipped = 0;
+}
+
+void
+RunAhead::setMode(int _mode)
+{
+	if (_mode == mode)
+		return;
+
+	mode = _mode;
+	if (mode_fn)
+		mode_fn(mode);
+}
+
+// Frames to run ahead, or 0 for off.
+void
+RunAhead::setFrames(int n)
+{
+	DPRINTF(1, "RunAhead::%s: n=%d\n", __func__, n);
+
+	if (n < 0)
+		n = 0;
+	else if (n > RUNAHEAD_MAX)
+		n = RUNAHEAD_MAX;
+
+	frames = n;
+	countdown = frame_cycles;
+	win_start = clock::now();
+	win_ns = 0;
+	win_frames = 0;
+	cost_us = 0;
+	setMode(frames > 0 ? RUNAHEAD_REAL : RUNAHEAD_OFF);
+}
+
+// A real frame is done.  Run ahead from it, showing only the last frame,
+// and come back.
+void
+RunAhead::frame(void)
+{
+	countdown = frame_cycles;
+
+	// Show the real frames until it is safe again.
+	if (safe_fn && !safe_fn()) {
+		skipped.fetch_add(1, std::memory_order_relaxed);
+		setMode(RUNAHEAD_OFF);
+		return;
+	}
+
+	clock::time_point t0 = clock::now();
+
+	save_fn(w);
+
+	setMode(RUNAHEAD_HIDDEN);
+	if (frames > 1)
+		run_fn((frames - 1) * frame_cycles);
+	setMode(RUNAHEAD_SHOWN);
+	run_fn(frame_cycles);
+
+	StateReader r(w.getData(), w.getSize());
+	if (!load_fn(r))
+		DPRINTF(1, "RunAhead::%s: load failed\n", __func__);
+	setMode(RUNAHEAD_REAL);
+
+	clock::time_point t1 = clock::now();
+	win_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+		t1 - t0).count();
+	win_frames++;
+
+	auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		t1 - win_start).count();
+	if (ns >= 1000000000) {
+		cost_us.store((int)(win_ns / 1000 / win_frames),
+			      std::memory_order_relaxed);
+		win_start = t1;
+		win_ns = 0;
+		win_frames = 0;
+	}
+}
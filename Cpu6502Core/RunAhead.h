@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// RunAhead.h
+//
+//	Run-ahead to hide input latency.  After each real frame the machine
+//	is saved, run a few frames further with the input it has now, and
+//	the last of those frames is shown instead of the real one.  Then
+//	the save is loaded and the real machine carries on.  What is on the
+//	screen is always the future the current input leads to, so input
+//	shows up that many frames sooner.
+//
+//	The frontend is told which kind of clocks are being run so it can
+//	hold back frames and mute sound that doesn't belong to the real
+//	machine.  Everything here runs on the emulation thread except the
+//	statistics getters.
+//
+
+#ifndef __RUNAHEAD_H__
+#define __RUNAHEAD_H__
+
+#include <stdint.h>
+#include <chrono>
+#include <atomic>
+#include <functional>
+
+#include "SaveState.h"
+
+#define RUNAHEAD_MAX	4	// most frames ahead
+
+// Modes for the frontend.
+#define RUNAHEAD_OFF	0	// real clocks, show frames
+#define RUNAHEAD_REAL	1	// real clocks, hold frames back
+#define RUNAHEAD_HIDDEN	2	// ahead, hold frames, mute sound
+#define RUNAHEAD_SHOWN	3	// ahead, show frames, mute sound
+
+class RunAhead {
+private:
+	typedef std::chrono::steady_clock clock;
+
+	int		frame_cycles;
+	int		frames;		// 0 is off
+	int		mode;
+	int		countdown;	// clocks to next real frame
+
+	StateWriter	w;
+
+	clock::time_point win_start;	// one second statistics window
+	int64_t		win_ns;
+	unsigned	win_frames;
+
+	std::atomic<int> cost_us;	// extra time per frame, last window
+	std::atomic<unsigned> skipped;	// frames not run ahead
+
+	std::function<void (StateWriter &)> save_fn;
+	std::function<bool (StateReader &)> load_fn;
+	std::function<void (int)> run_fn;
+	std::function<void (int)> mode_fn;
+	std::function<bool (void)> safe_fn;
+
+	void		setMode(int _mode);
+	void		frame(void);
+public:
+	RunAhead(int _frame_cycles);
+
+	// Save or load the whole machine.
+	void		setSaveFunc(std::function<void (StateWriter &)> _fn)
+	{ this->save_fn = _fn; }
+	void		setLoadFunc(std::function<bool (StateReader &)> _fn)
+	{ this->load_fn = _fn; }
+	// Run n clocks.
+	void		setRunFunc(std::function<void (int)> _fn)
+	{ this->run_fn = _fn; }
+	// Frontend mode, one of RUNAHEAD_*.
+	void		setModeFunc(std::function<void (int)> _fn)
+	{ this->mode_fn = _fn; }
+	// Whether running ahead is safe now.  Not, for instance, while
+	// writing to media that isn't part of the machine's state.
+	void		setSafeFunc(std::function<bool (void)> _fn)
+	{ this->safe_fn = _fn; }
+
+	void		setFrames(int n);
+	int		getFrames(void) const
+	{ return frames; }
+
+	// Slice loop: run at most until() clocks, then report them.
+	int		until(int n) const
+	{ return frames > 0 && countdown < n ? countdown : n; }
+	void		ran(int n)
+	{
+		if (frames == 0)
+			return;
+		countdown -= n;
+		if (countdown == 0)
+			frame();
+	}
+
+	bool		isAhead(void) const
+	{ return mode == RUNAHEAD_HIDDEN || mode == RUNAHEAD_SHOWN; }
+
+	// Any thread.
+	int		getCost(void) const	// microseconds per frame
+	{ return cost_us.load(std::memory_order_relaxed); }
+	unsigned	getSkipped(void) const
+	{ return skipped.load(std::memory_order_relaxed); }
+};
+
+#endif // __RUNAHEAD_H__
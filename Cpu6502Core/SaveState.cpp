@@ -0,0 +1,413 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// SaveState.cpp
+
+#include <stdint.h>
+#include <string.h>
+
+#include "SaveState.h"
+#include "DirtyPages.h"
+
+#ifdef DEBUGSTATE
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGSTATE) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+#define STATE_MAGIC	"E6SS"
+#define STATE_HDR_SIZE	10	// magic, version, machine
+#define CHUNK_HDR_SIZE	8	// tag, length
+
+// RAM block encodings.  An RLE control byte below 0x80 is followed by
+// that many plus one literal bytes, otherwise by one byte repeated
+// (c & 0x7f) + RLE_MIN_RUN times.  RAM_PAGES is a bitmap of pages
+// followed by each of those pages encoded as a block of its own.
+#define RAM_RAW		0
+#define RAM_RLE		1
+#define RAM_PAGES	2
+#define RAM_PAGE_SIZE	(1 << DIRTY_PAGE_SHIFT)
+#define RLE_MAX_LIT	128
+#define RLE_MIN_RUN	3
+#define RLE_MAX_RUN	(0x7f + RLE_MIN_RUN)
+
+#define ONES	0x0101010101010101ull
+#define HIGHS	0x8080808080808080ull
+
+static inline uint64_t
+load64(const uint8_t *p)
+{
+	uint64_t w;
+
+	memcpy(&w, p, sizeof(w));
+	return w;
+}
+
+// Does any byte of w equal zero?
+static inline bool
+zeroByte(uint64_t w)
+{
+	return ((w - ONES) & ~w & HIGHS) != 0;
+}
+
+// Length of the run of bytes equal to data[0], up to max.
+static int
+runLength(const uint8_t *data, int max)
+{
+	uint64_t pat = data[0] * ONES;
+	int n = 1;
+
+	while (n + 8 <= max && load64(&data[n]) == pat)
+		n += 8;
+	while (n < max && data[n] == data[0])
+		n++;
+
+	return n;
+}
+
+// Start a new state.  The buffer keeps its allocation between states.
+void
+StateWriter::begin(const char *machine)
+{
+	buf.clear();
+	putBytes(STATE_MAGIC, 4);
+	put16(STATE_VERSION);
+	putBytes(machine, 4);
+}
+
+void
+StateWriter::beginChunk(const char *tag)
+{
+	putBytes(tag, 4);
+	chunk = buf.size();
+	put32(0);
+}
+
+// Go back and fill in the length of the chunk just written.
+void
+StateWriter::endChunk(void)
+{
+	uint32_t len = buf.size() - chunk - 4;
+
+	for (int i = 0; i < 4; i++)
+		buf[chunk + i] = len >> (i * 8);
+}
+
+void
+StateWriter::put16(uint16_t d16)
+{
+	buf.push_back(d16);
+	buf.push_back(d16 >> 8);
+}
+
+void
+StateWriter::put32(uint32_t d32)
+{
+	buf.push_back(d32);
+	buf.push_back(d32 >> 8);
+	buf.push_back(d32 >> 16);
+	buf.push_back(d32 >> 24);
+}
+
+void
+StateWriter::putBytes(const void *data, int len)
+{
+	const uint8_t *p = (const uint8_t *)data;
+
+	buf.insert(buf.end(), p, p + len);
+}
+
+// Store a block of memory run-length encoded, or raw if encoding
+// doesn't make it smaller.
+void
+StateWriter::putRam(const uint8_t *data, int len)
+{
+	put32(len);
+	putBlock(data, len);
+}
+
+// RAM the CPU sees at addr.  In a delta only written pages are stored.
+void
+StateWriter::putRam(const uint8_t *data, int len, uint16_t addr)
+{
+	put32(len);
+	if (delta)
+		putRamPages(data, len, addr >> DIRTY_PAGE_SHIFT);
+	else
+		putBlock(data, len);
+}
+
+void
+StateWriter::putBlock(const uint8_t *data, int len)
+{
+	size_t mark = buf.size();
+	put8(RAM_RLE);
+
+	int lit = 0;	// start of literals not yet written
+	int i = 0;
+	while (i < len && buf.size() - mark <= (size_t)len) {
+		// Skip eight at a time where no three bytes in a row match.
+		while (i + 10 <= len) {
+			uint64_t w0 = load64(&data[i]);
+			uint64_t w1 = load64(&data[i + 1]);
+			uint64_t w2 = load64(&data[i + 2]);
+			if (zeroByte((w0 ^ w1) | (w1 ^ w2)))
+				break;
+			i += 8;
+		}
+
+		int run = runLength(&data[i], len - i < RLE_MAX_RUN ?
+				    len - i : RLE_MAX_RUN);
+		if (run < RLE_MIN_RUN) {
+			i += run;
+			continue;
+		}
+
+		while (lit < i) {
+			int n = i - lit < RLE_MAX_LIT ? i - lit : RLE_MAX_LIT;
+			put8(n - 1);
+			putBytes(&data[lit], n);
+			lit += n;
+		}
+		put8(0x80 | (run - RLE_MIN_RUN));
+		put8(data[i]);
+		i += run;
+		lit = i;
+	}
+	while (i >= len && lit < len) {
+		int n = len - lit < RLE_MAX_LIT ? len - lit : RLE_MAX_LIT;
+		put8(n - 1);
+		putBytes(&data[lit], n);
+		lit += n;
+	}
+
+	// Stopped early or no smaller?
+	if (i < len || buf.size() - mark > (size_t)len) {
+		buf.resize(mark);
+		put8(RAM_RAW);
+		putBytes(data, len);
+	}
+
+	DPRINTF(2, "StateWriter::%s: len=%d stored=%d\n", __func__, len,
+		(int)(buf.size() - mark - 1));
+}
+
+// Store the pages written since the delta generation.
+void
+StateWriter::putRamPages(const uint8_t *data, int len, int page)
+{
+	int npages = (len + RAM_PAGE_SIZE - 1) / RAM_PAGE_SIZE;
+
+	put8(RAM_PAGES);
+	size_t map = buf.size();
+	buf.resize(map + (npages + 7) / 8, 0);
+
+	for (int p = 0; p < npages; p++) {
+		if (page + p < DIRTY_NUM_PAGES &&
+		    !delta->changedSince(page + p, delta_gen))
+			continue;
+		buf[map + p / 8] |= 1 << (p % 8);
+
+		int n = len - p * RAM_PAGE_SIZE;
+		putBlock(&data[p * RAM_PAGE_SIZE],
+			 n < RAM_PAGE_SIZE ? n : RAM_PAGE_SIZE);
+	}
+}
+
+StateReader::StateReader(const uint8_t *_data, size_t _size)
+{
+	data = _data;
+	size = _size;
+	pos = 0;
+	chunks = 0;
+	end = 0;
+	ok = true;
+}
+
+// Check the header is a state of this version for this machine.
+bool
+StateReader::begin(const char *machine)
+{
+	if (size < STATE_HDR_SIZE || memcmp(data, STATE_MAGIC, 4) != 0 ||
+	    (data[4] | data[5] << 8) != STATE_VERSION ||
+	    memcmp(&data[6], machine, 4) != 0) {
+		DPRINTF(1, "StateReader::%s: not a version %d %.4s state\n",
+			__func__, STATE_VERSION, machine);
+		ok = false;
+		return false;
+	}
+
+	chunks = STATE_HDR_SIZE;
+	ok = true;
+	return true;
+}
+
+// Look for a chunk and set up to read it.  A missing chunk isn't an
+// error here so optional chunks can be skipped.
+bool
+StateReader::findChunk(const char *tag)
+{
+	size_t p = chunks;
+
+	while (ok && p + CHUNK_HDR_SIZE <= size) {
+		uint32_t len = data[p + 4] | data[p + 5] << 8 |
+			data[p + 6] << 16 | (uint32_t)data[p + 7] << 24;
+		if (len > size - p - CHUNK_HDR_SIZE)
+			break;
+		if (memcmp(&data[p], tag, 4) == 0) {
+			pos = p + CHUNK_HDR_SIZE;
+			end = pos + len;
+			return true;
+		}
+		p += CHUNK_HDR_SIZE + len;
+	}
+
+	DPRINTF(1, "StateReader::%s: no %.4s chunk\n", __func__, tag);
+	pos = end = 0;
+	return false;
+}
+
+bool
+StateReader::need(size_t n)
+{
+	if (ok && n <= end - pos)
+		return true;
+
+	ok = false;
+	return false;
+}
+
+uint8_t
+StateReader::get8(void)
+{
+	if (!need(1))
+		return 0;
+
+	return data[pos++];
+}
+
+uint16_t
+StateReader::get16(void)
+{
+	if (!need(2))
+		return 0;
+
+	uint16_t d16 = data[pos] | data[pos + 1] << 8;
+	pos += 2;
+	return d16;
+}
+
+uint32_t
+StateReader::get32(void)
+{
+	if (!need(4))
+		return 0;
+
+	uint32_t d32 = data[pos] | data[pos + 1] << 8 |
+		data[pos + 2] << 16 | (uint32_t)data[pos + 3] << 24;
+	pos += 4;
+	return d32;
+}
+
+void
+StateReader::getBytes(void *_data, int len)
+{
+	if (!need(len)) {
+		memset(_data, 0, len);
+		return;
+	}
+
+	memcpy(_data, &data[pos], len);
+	pos += len;
+}
+
+// Read a block stored by StateWriter::putRam().  It must be the same
+// length.
+void
+StateReader::getRam(uint8_t *_data, int len)
+{
+	if ((int)get32() != len) {
+		ok = false;
+		return;
+	}
+
+	if (pos < end && data[pos] == RAM_PAGES) {
+		pos++;
+		getRamPages(_data, len);
+	} else
+		getBlock(_data, len);
+}
+
+void
+StateReader::getBlock(uint8_t *_data, int len)
+{
+	uint8_t mode = get8();
+	if (mode == RAM_RAW) {
+		getBytes(_data, len);
+		return;
+	} else if (mode != RAM_RLE) {
+		ok = false;
+		return;
+	}
+
+	int i = 0;
+	while (ok && i < len) {
+		uint8_t c = get8();
+		int n = c < 0x80 ? c + 1 : (c & 0x7f) + RLE_MIN_RUN;
+		if (n > len - i) {
+			ok = false;
+			break;
+		}
+		if (c < 0x80)
+			getBytes(&_data[i], n);
+		else
+			memset(&_data[i], get8(), n);
+		i += n;
+	}
+}
+
+// Pages of a delta.  The rest of the block is left as the full state
+// loaded before it.
+void
+StateReader::getRamPages(uint8_t *_data, int len)
+{
+	int npages = (len + RAM_PAGE_SIZE - 1) / RAM_PAGE_SIZE;
+	uint8_t map[(DIRTY_NUM_PAGES + 7) / 8];
+
+	if (npages > DIRTY_NUM_PAGES) {
+		ok = false;
+		return;
+	}
+	getBytes(map, (npages + 7) / 8);
+
+	for (int p = 0; ok && p < npages; p++)
+		if (map[p / 8] & (1 << (p % 8))) {
+			int n = len - p * RAM_PAGE_SIZE;
+			getBlock(&_data[p * RAM_PAGE_SIZE],
+				 n < RAM_PAGE_SIZE ? n : RAM_PAGE_SIZE);
+		}
+}
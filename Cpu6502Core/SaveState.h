@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// SaveState.h
+//
+//	Machine save states.  A state is a short header followed by tagged
+//	chunks, usually one per device, so a loader can find the pieces it
+//	knows in any order.  Values are little endian.
+//
+//	header:	"E6SS" version(16) machine(4)
+//	chunk:	tag(4) length(32) data[length]
+//
+//	RAM blocks are stored raw or run-length encoded, whichever is
+//	smaller.  Media (ROM, disk and tape images), breakpoints and
+//	user preferences are not part of a state.
+//
+//	A delta state stores only the pages of CPU visible RAM written
+//	since some generation of a DirtyPages map.  It is loaded over the
+//	full state it is a delta against.
+//
+
+#ifndef __SAVESTATE_H__
+#define __SAVESTATE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#define STATE_VERSION	1
+
+class DirtyPages;
+
+class StateWriter {
+private:
+	std::vector<uint8_t> buf;
+	size_t		chunk;		// length field of open chunk
+
+	const DirtyPages *delta;	// or null for full states
+	uint32_t	delta_gen;
+
+	void		putBlock(const uint8_t *data, int len);
+	void		putRamPages(const uint8_t *data, int len, int page);
+public:
+	StateWriter() : chunk(0), delta(nullptr), delta_gen(0) { }
+
+	void		begin(const char *machine);
+	void		beginChunk(const char *tag);
+	void		endChunk(void);
+
+	void		put8(uint8_t d8)
+	{ buf.push_back(d8); }
+	void		putBool(bool flag)
+	{ buf.push_back(flag ? 1 : 0); }
+	void		put16(uint16_t d16);
+	void		put32(uint32_t d32);
+	void		putInt(int n)
+	{ put32((uint32_t)n); }
+	void		putBytes(const void *data, int len);
+	void		putRam(const uint8_t *data, int len);
+	void		putRam(const uint8_t *data, int len, uint16_t addr);
+
+	// Following states are deltas against generation gen, or full
+	// states again if dirty is null.
+	void		setDelta(const DirtyPages *dirty, uint32_t gen)
+	{
+		this->delta = dirty;
+		this->delta_gen = gen;
+	}
+
+	const uint8_t	*getData(void) const
+	{ return buf.data(); }
+	size_t		getSize(void) const
+	{ return buf.size(); }
+};
+
+// Reads past the end of a chunk or a missing chunk clear the ok flag
+// and return zeros, so loaders can read everything and check once.
+class StateReader {
+private:
+	const uint8_t	*data;
+	size_t		size;
+	size_t		pos;
+	size_t		chunks;		// first chunk
+	size_t		end;		// end of open chunk
+	bool		ok;
+
+	bool		need(size_t n);
+	void		getBlock(uint8_t *data, int len);
+	void		getRamPages(uint8_t *data, int len);
+public:
+	StateReader(const uint8_t *_data, size_t _size);
+
+	bool		begin(const char *machine);
+	bool		findChunk(const char *tag);
+	bool		openChunk(const char *tag)
+	{
+		if (!findChunk(tag))
+			ok = false;
+		return ok;
+	}
+	void		endChunk(void)
+	{ pos = end; }
+
+	uint8_t		get8(void);
+	bool		getBool(void)
+	{ return get8() != 0; }
+	uint16_t	get16(void);
+	uint32_t	get32(void);
+	int		getInt(void)
+	{ return (int32_t)get32(); }
+	void		getBytes(void *data, int len);
+	void		getRam(uint8_t *data, int len);
+
+	bool		isOk(void) const
+	{ return ok; }
+	void		fail(void)
+	{ ok = false; }
+};
+
+#endif // __SAVESTATE_H__
@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Spawn.cpp
+
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/wait.h>
+
+#include "Spawn.h"
+
+#ifdef DEBUGSPAWN
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGSPAWN) printf(f, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+Spawn::Spawn(int _max_children)
+{
+	if (_max_children <= 0)
+		_max_children = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	max_children = _max_children > 0 ? _max_children : 1;
+
+	spawned = 0;
+	finished = 0;
+	failed = 0;
+}
+
+// Fork a child for one branch.  The child never returns.
+bool
+Spawn::start(int branch)
+{
+	int fds[2];
+
+	if (pipe(fds) < 0)
+		return false;
+
+	// Anything buffered would otherwise come out once per child.
+	fflush(stdout);
+	fflush(stderr);
+
+	pid_t pid = fork();
+	if (pid < 0) {
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+
+	if (pid == 0) {
+		close(fds[0]);
+		for (Child &c : children)
+			close(c.fd);
+
+		std::vector<uint8_t> result;
+		branch_fn(branch, result);
+
+		const uint8_t *p = result.data();
+		size_t len = result.size();
+		while (len > 0) {
+			ssize_t k = write(fds[1], p, len);
+			if (k < 0 && errno == EINTR)
+				continue;
+			if (k <= 0)
+				_exit(1);
+			p += k;
+			len -= k;
+		}
+		_exit(0);
+	}
+
+	close(fds[1]);
+
+	Child c;
+	c.pid = pid;
+	c.fd = fds[0];
+	c.branch = branch;
+	children.push_back(std::move(c));
+	spawned++;
+
+	DPRINTF(2, "Spawn::%s: branch=%d pid=%d\n", __func__, branch,
+		(int)pid);
+
+	return true;
+}
+
+// Reap a child whose pipe has closed and pass on its result if it
+// exited cleanly.
+void
+Spawn::finish(Child &c)
+{
+	int status;
+
+	close(c.fd);
+	while (waitpid(c.pid, &status, 0) < 0 && errno == EINTR)
+		;
+
+	if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+		finished++;
+		if (result_fn)
+			result_fn(c.branch, c.data);
+	} else {
+		DPRINTF(1, "Spawn::%s: branch %d failed\n", __func__,
+			c.branch);
+		failed++;
+	}
+}
+
+// Wait for output from the children and finish those that are done.
+void
+Spawn::collect(void)
+{
+	std::vector<struct pollfd> pfds(children.size());
+	uint8_t buf[4096];
+
+	for (size_t i = 0; i < children.size(); i++) {
+		pfds[i].fd = children[i].fd;
+		pfds[i].events = POLLIN;
+	}
+	if (poll(pfds.data(), pfds.size(), -1) < 0)
+		return;
+
+	for (size_t i = children.size(); i-- > 0; ) {
+		if (!pfds[i].revents)
+			continue;
+
+		ssize_t k = read(children[i].fd, buf, sizeof(buf));
+		if (k > 0)
+			children[i].data.insert(children[i].data.end(),
+						buf, buf + k);
+		else if (k == 0 || errno != EINTR) {
+			finish(children[i]);
+			children.erase(children.begin() + i);
+		}
+	}
+}
+
+int
+Spawn::run(int first, int n)
+{
+	unsigned done = finished;
+	int next = first;
+
+	while (next < first + n || !children.empty()) {
+		while (next < first + n &&
+		       (int)children.size() < max_children) {
+			if (!start(next))
+				failed++;
+			next++;
+		}
+		if (!children.empty())
+			collect();
+	}
+
+	return (int)(finished - done);
+}
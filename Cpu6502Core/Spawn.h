@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// Spawn.h
+//
+//	Branch a running machine with fork().  Each child starts out as an
+//	exact copy of the parent, machine and all, sharing its memory copy-
+//	on-write, so nothing needs saving or loading to start a branch and
+//	ROM and RAM a branch doesn't touch are never copied.  A child runs
+//	its branch and hands back a result through a pipe.
+//
+//	fork() only copies the calling thread, so this is for headless
+//	drivers, not the GUI apps.
+//
+
+#ifndef __SPAWN_H__
+#define __SPAWN_H__
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <vector>
+#include <functional>
+
+class Spawn {
+private:
+	struct Child {
+		pid_t		pid;
+		int		fd;
+		int		branch;
+		std::vector<uint8_t> data;
+	};
+
+	int		max_children;
+	std::vector<Child> children;
+
+	unsigned	spawned;
+	unsigned	finished;
+	unsigned	failed;	// couldn't fork or didn't exit cleanly
+
+	std::function<void (int, std::vector<uint8_t> &)> branch_fn;
+	std::function<void (int, const std::vector<uint8_t> &)> result_fn;
+
+	bool		start(int branch);
+	void		collect(void);
+	void		finish(Child &c);
+public:
+	Spawn(int _max_children = 0);
+
+	// In the child: run branch n and fill in its result.
+	void		setBranchFunc(std::function<void (int,
+						std::vector<uint8_t> &)> _fn)
+	{ this->branch_fn = _fn; }
+	// In the parent: a branch's result, in the order they finish.
+	void		setResultFunc(std::function<void (int,
+						const std::vector<uint8_t> &)>
+				      _fn)
+	{ this->result_fn = _fn; }
+
+	// Run branches first to first+n-1 from the machine as it is now,
+	// at most max_children at once.  Returns the number that finished.
+	int		run(int first, int n);
+
+	unsigned	getSpawned(void) const
+	{ return spawned; }
+	unsigned	getFinished(void) const
+	{ return finished; }
+	unsigned	getFailed(void) const
+	{ return failed; }
+};
+
+#endif // __SPAWN_H__
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// StateHash.h
+//
+//	Hashes of machine state.  RamHash is a Zobrist hash of RAM: every
+//	value at every address has its own 64-bit key and the hash is the
+//	XOR of the keys for what RAM holds, so a write updates it in O(1)
+//	and equal RAM always gives an equal hash however it got that way.
+//	The keys come from a 64-bit mixer rather than a table, which would
+//	need 16M entries for 64K addresses.
+//
+//	The CPU and device registers are a few hundred bytes at most and
+//	are hashed whole, with hashBytes(), when the hash is asked for.
+//	Pixels are hashed eight at a time with hashWords(), which is
+//	several times faster.
+//
+
+#ifndef __STATEHASH_H__
+#define __STATEHASH_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define HASH_FNV_BASIS	0xcbf29ce484222325ULL
+#define HASH_FNV_PRIME	0x100000001b3ULL
+#define HASH_GOLDEN	0x9e3779b97f4a7c15ULL	// 2^64 / golden ratio
+
+// FNV-1a.
+static inline uint64_t
+hashBytes(const uint8_t *data, size_t len, uint64_t h = HASH_FNV_BASIS)
+{
+	for (size_t i = 0; i < len; i++)
+		h = (h ^ data[i]) * HASH_FNV_PRIME;
+	return h;
+}
+
+// FNV-1a's shape over 64-bit words, with a shift to mix the high bits
+// back down, and hashBytes() for any bytes left over.
+static inline uint64_t
+hashWords(const uint8_t *data, size_t len, uint64_t h = HASH_FNV_BASIS)
+{
+	size_t i;
+
+	for (i = 0; i + 8 <= len; i += 8) {
+		uint64_t w;
+		memcpy(&w, data + i, sizeof(w));
+		h = (h ^ w) * HASH_GOLDEN;
+		h ^= h >> 29;
+	}
+	return hashBytes(data + i, len - i, h);
+}
+
+class RamHash {
+private:
+	uint64_t	hash;
+public:
+	RamHash(void) : hash(0) { }
+
+	// splitmix64's finalizer over address and value.
+	static uint64_t	key(uint16_t addr, uint8_t d8)
+	{
+		uint64_t z = (((uint64_t)addr << 8 | d8) + 1) * HASH_GOLDEN;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+	// Write path, with what was there before.
+	void		write(uint16_t addr, uint8_t old, uint8_t d8)
+	{ hash ^= key(addr, old) ^ key(addr, d8); }
+
+	// Start over from a whole block of RAM, after a reset or a load.
+	void		rehash(const uint8_t *ram, int len, uint16_t addr = 0)
+	{
+		hash = 0;
+		for (int i = 0; i < len; i++)
+			hash ^= key(addr + i, ram[i]);
+	}
+
+	uint64_t	get(void) const
+	{ return hash; }
+};
+
+#endif // __STATEHASH_H__
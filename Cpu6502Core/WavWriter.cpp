@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// WavWriter.cpp
+
+#include <stdint.h>
+#include <cstdio>
+
+#include "WavWriter.h"
+
+#define WAV_HDR_SIZE	44
+
+static void
+put16(uint8_t *p, uint16_t v)
+{
+	p[0] = v & 0xff;
+	p[1] = v >> 8;
+}
+
+static void
+put32(uint8_t *p, uint32_t v)
+{
+	put16(p, v & 0xffff);
+	put16(p + 2, v >> 16);
+}
+
+WavWriter::WavWriter()
+{
+	fp = nullptr;
+	rate = 0;
+	channels = 1;
+	datalen = 0;
+}
+
+WavWriter::~WavWriter()
+{
+	close();
+}
+
+// Fill in RIFF header.  Lengths are only right after close().
+void
+WavWriter::writeHeader(void)
+{
+	uint8_t hdr[WAV_HDR_SIZE];
+
+	hdr[0] = 'R'; hdr[1] = 'I'; hdr[2] = 'F'; hdr[3] = 'F';
+	put32(&hdr[4], 36 + datalen);
+	hdr[8] = 'W'; hdr[9] = 'A'; hdr[10] = 'V'; hdr[11] = 'E';
+	hdr[12] = 'f'; hdr[13] = 'm'; hdr[14] = 't'; hdr[15] = ' ';
+	put32(&hdr[16], 16);			// fmt chunk size
+	put16(&hdr[20], 1);			// PCM
+	put16(&hdr[22], channels);
+	put32(&hdr[24], rate);
+	put32(&hdr[28], rate * channels * 2);	// bytes per second
+	put16(&hdr[32], channels * 2);		// bytes per frame
+	put16(&hdr[34], 16);			// bits per sample
+	hdr[36] = 'd'; hdr[37] = 'a'; hdr[38] = 't'; hdr[39] = 'a';
+	put32(&hdr[40], datalen);
+
+	fseek(fp, 0, SEEK_SET);
+	fwrite(hdr, 1, WAV_HDR_SIZE, fp);
+	fseek(fp, 0, SEEK_END);
+}
+
+// Create file.  Returns false if it can't be opened.
+bool
+WavWriter::open(const char *filename, int _rate, int _channels)
+{
+	close();
+
+	fp = fopen(filename, "wb");
+	if (!fp)
+		return false;
+
+	rate = _rate;
+	channels = _channels;
+	datalen = 0;
+	writeHeader();
+
+	return true;
+}
+
+// Append n samples (interleaved if more than one channel).
+void
+WavWriter::write(const int16_t *data, int n)
+{
+	uint8_t buf[512];
+
+	if (!fp)
+		return;
+
+	while (n > 0) {
+		int m = n < sizeof(buf) / 2 ? n : sizeof(buf) / 2;
+
+		for (int i = 0; i < m; i++)
+			put16(&buf[i * 2], data[i]);
+		fwrite(buf, 2, m, fp);
+
+		datalen += m * 2;
+		data += m;
+		n -= m;
+	}
+}
+
+void
+WavWriter::close(void)
+{
+	if (!fp)
+		return;
+
+	writeHeader();
+	fclose(fp);
+	fp = nullptr;
+}
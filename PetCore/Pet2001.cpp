@@ -26,9 +26,11 @@
 // Pet2001.cpp
 
 #include <stdint.h>
+#include <string.h>
 
 #include "Pet2001.h"
 #include "Pet2001Hw.h"
+#include "SaveState.h"
 
 unsigned int cycles;
 
@@ -37,6 +39,8 @@ Pet2001::reset(void)
 {
 	pethw.reset();
 	cpu.reset();
+	if (input_cb)
+		input_cb(PET_INPUT_RESET, 0, 0);
 }
 
 bool
@@ -53,6 +57,20 @@ Pet2001::cycle(void)
 	return retv;
 }
 
+// Apply an input event reported earlier by the input callback.
+void
+Pet2001::input(int type, int a, int b)
+{
+	switch (type) {
+	case PET_INPUT_KEYROW:
+		setKeyrow(a, b);
+		break;
+	case PET_INPUT_RESET:
+		reset();
+		break;
+	}
+}
+
 void
 Pet2001::readRange(uint16_t addr, uint8_t *data, int length)
 {
@@ -66,3 +84,52 @@ Pet2001::writeRange(uint16_t addr, const uint8_t *data, int length)
 	for (int i = 0; i < length; i++)
 		pethw.write(addr + i, data[i]);
 }
+
+// Save the whole machine between cycles.  The writer's buffer is reused
+// so this doesn't allocate once it has grown.
+void
+Pet2001::saveState(StateWriter &w)
+{
+	w.begin("PET ");
+	cpu.saveState(w);
+	pethw.saveState(w);
+}
+
+// Returns false if the state is not for this machine and version, or is
+// damaged.  A damaged state can leave the machine partly loaded.
+bool
+Pet2001::loadState(StateReader &r)
+{
+	if (!r.begin("PET "))
+		return false;
+	cpu.loadState(r);
+	pethw.loadState(r);
+
+	return r.isOk();
+}
+
+// A hash of the whole machine, equal whenever the state is.  RAM is
+// hashed as it is written, so only the CPU and I/O are hashed here.
+uint64_t
+Pet2001::stateHash(void)
+{
+	hashw.begin("PET ");
+	cpu.saveState(hashw);
+
+	return pethw.stateHash(hashw);
+}
+
+// BASIC has finished its cold start and printed READY. on the screen.
+bool
+Pet2001::basicReady(void)
+{
+	static const uint8_t ready[] = { 0x12, 0x05, 0x01, 0x04, 0x19, 0x2e };
+	uint8_t scr[1000];
+
+	readRange(VIDRAM_ADDR, scr, sizeof(scr));
+	for (int i = 0; i + sizeof(ready) <= sizeof(scr); i++)
+		if (memcmp(&scr[i], ready, sizeof(ready)) == 0)
+			return true;
+
+	return false;
+}
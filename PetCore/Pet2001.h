@@ -28,14 +28,24 @@
 #ifndef __PET2001_H__
 #define __PET2001_H__
 
+#include <functional>
+
 #include "Cpu6502.h"
 #include "Pet2001Hw.h"
+#include "SaveState.h"
+
+// Input events, as reported to the input callback and replayed by
+// input().
+#define PET_INPUT_KEYROW	0	// a=row b=keyrow
+#define PET_INPUT_RESET		1
 
 class Pet2001 {
 private:
 	Cpu6502		cpu;
 	Pet2001Hw	pethw;
+	StateWriter	hashw;
 
+	std::function<void (int, int, int)> input_cb;
 public:
 	Pet2001(PetVideo *video = 0, PetCassHw *cass = 0, PetIeeeHw *ieee = 0)
 		: cpu(&pethw),
@@ -46,7 +56,15 @@ public:
 	void		setVideo(PetVideo *video)
 	{ pethw.setVideo(video); }
 	void		setKeyrow(int row, uint8_t keyrow)
-	{ pethw.setKeyrow(row, keyrow); }
+	{
+		pethw.setKeyrow(row, keyrow);
+		if (input_cb)
+			input_cb(PET_INPUT_KEYROW, row, keyrow);
+	}
+	void		input(int type, int a, int b);
+	void		setInputCallback(std::function<void (int, int, int)>
+					 _cb)
+	{ this->input_cb = _cb; }
 	void		setRamsize(int ramsize)
 	{ pethw.setRamsize(ramsize); }
 	void		readRange(uint16_t addr, uint8_t *data, int length);
@@ -55,12 +73,25 @@ public:
 	void		writeRom(uint16_t addr, const uint8_t *data,
 			int length)
 	{ pethw.writeRom(addr, data, length); }
-	void		setAudioBuf(uint8_t *buf, int len)
-	{ pethw.setAudioBuf(buf, len); }
-	int		getAudioTail(void)
-	{ return pethw.getAudioTail(); }
+	void		setRom(uint16_t addr, ImageRef image, size_t offset,
+			       int length)
+	{ pethw.setRom(addr, image, offset, length); }
+	void		setAudioRing(AudioRing *ring)
+	{ pethw.setAudioRing(ring); }
 	Cpu6502		*getCpu(void)
 	{ return &cpu; }
+	DirtyPages	*getDirtyPages(void)
+	{ return pethw.getDirtyPages(); }
+
+	void		saveState(StateWriter &w);
+	bool		loadState(StateReader &r);
+	uint64_t	stateHash(void);
+	// ROMs loaded, for telling apart states that need different ones.
+	uint64_t	romHash(void) const
+	{ return pethw.romHash(); }
+	int		getRamsize(void) const
+	{ return pethw.getRamsize(); }
+	bool		basicReady(void);
 };
 
 #endif // __PET2001_H__
@@ -31,6 +31,7 @@
 
 #include "MemSpace.h"
 #include "PetVideo.h"
+#include "SaveState.h"
 
 void
 Pet2001Hw::reset(void)
@@ -42,6 +43,8 @@ Pet2001Hw::reset(void)
 
 	for (int i = 0; i < MAX_RAM_SIZE; i++)
 		ram[i] = 0x44;
+	dirty.markAll();
+	ramhash.rehash(ram, MAX_RAM_SIZE);
 }
 
 void
@@ -50,15 +53,83 @@ Pet2001Hw::cycle(void)
 	io.cycle();
 }
 
-// Write ROM space.
+// Write ROM space with a copy of romdata.
 void
 Pet2001Hw::writeRom(uint16_t addr, const uint8_t *romdata, int len)
 {
-	for (int i = 0; i < len; i++)
-		if (addr > IO_ADDR)
-			rom[addr - ROM_ADDR - IO_SIZE + i] = romdata[i];
+	setRom(addr, Image::copy(romdata, len), 0, len);
+}
+
+// Map ROM space onto part of an image, which is shared, not copied.  A
+// ROM that would run into I/O space continues after it.
+void
+Pet2001Hw::setRom(uint16_t addr, ImageRef image, size_t offset, int len)
+{
+	while (len > 0 && addr >= ROM_ADDR) {
+		int n = len;
+
+		if (addr >= IO_ADDR && addr < IO_ADDR + IO_SIZE)
+			addr = IO_ADDR + IO_SIZE;
+		else if (addr < IO_ADDR && addr + n > IO_ADDR)
+			n = IO_ADDR - addr;
+		else if (addr + n > 0x10000)
+			n = 0x10000 - addr;
+
+		if (addr < IO_ADDR)
+			rom.set(addr - ROM_ADDR, image, offset, n);
 		else
-			rom[addr - ROM_ADDR + i] = romdata[i];
+			rom.set(addr - ROM_ADDR - IO_SIZE, image, offset, n);
+		dirty.markRange(addr, n);
+
+		addr += n;
+		offset += n;
+		len -= n;
+	}
+}
+
+// RAM, then I/O and video.  ROM is loaded media and not saved.
+void
+Pet2001Hw::saveState(StateWriter &w)
+{
+	w.beginChunk("PHW ");
+	w.put16(ramsize);
+	w.putRam(ram, MAX_RAM_SIZE, 0);
+	w.endChunk();
+
+	io.saveState(w);
+	if (video)
+		video->saveState(w);
+}
+
+void
+Pet2001Hw::loadState(StateReader &r)
+{
+	if (!r.openChunk("PHW "))
+		return;
+	ramsize = r.get16();
+	if (ramsize > MAX_RAM_SIZE)
+		r.fail();
+	r.getRam(ram, MAX_RAM_SIZE);
+	r.endChunk();
+	dirty.markAll();
+	ramhash.rehash(ram, MAX_RAM_SIZE);
+
+	io.loadState(r);
+	if (video)
+		video->loadState(r);
+}
+
+// The RAM hash kept up on writes, and a hash of the rest of the state
+// added on to w.
+uint64_t
+Pet2001Hw::stateHash(StateWriter &w)
+{
+	w.put16(ramsize);
+	io.saveState(w);
+	if (video)
+		video->saveState(w);
+
+	return ramhash.get() ^ hashBytes(w.getData(), w.getSize());
 }
 
 // ******************* MemSpace interface to cpu6502 **********************
@@ -69,9 +140,9 @@ Pet2001Hw::read(uint16_t addr)
 	if (addr < ramsize)
 		return ram[addr];
 	else if (addr >= ROM_ADDR && addr < IO_ADDR)
-		return rom[addr - ROM_ADDR];
+		return rom.read(addr - ROM_ADDR);
 	else if (addr >= IO_ADDR + IO_SIZE)
-		return rom[addr - ROM_ADDR - IO_SIZE];
+		return rom.read(addr - ROM_ADDR - IO_SIZE);
 	else if (addr >= VIDRAM_ADDR && addr < VIDRAM_ADDR + VIDRAM_SIZE) {
 		if (video)
 			return video->read(addr - VIDRAM_ADDR);
@@ -87,15 +158,22 @@ Pet2001Hw::read(uint16_t addr)
 void
 Pet2001Hw::write(uint16_t addr, uint8_t d8)
 {
-	if (addr <ramsize)
+	if (addr <ramsize) {
+		ramhash.write(addr, ram[addr], d8);
 		ram[addr] = d8;
+		dirty.mark(addr);
+	}
 #ifdef WRITEROM
-	else if (addr >= ROM_ADDR && addr < IO_ADDR)
-		rom[addr - ROM_ADDR] = d8;
-	else if (addr >= IO_ADDR + IO_SIZE)
-		rom[addr - ROM_ADDR - IO_SIZE] = d8;
+	else if (addr >= ROM_ADDR && addr < IO_ADDR) {
+		rom.write(addr - ROM_ADDR, d8);
+		dirty.mark(addr);
+	} else if (addr >= IO_ADDR + IO_SIZE) {
+		rom.write(addr - ROM_ADDR - IO_SIZE, d8);
+		dirty.mark(addr);
+	}
 #endif
 	else if (addr >= VIDRAM_ADDR && addr < VIDRAM_ADDR + VIDRAM_SIZE) {
+		dirty.mark(addr);
 		if (video)
 			video->write(addr - VIDRAM_ADDR, d8);
 	}
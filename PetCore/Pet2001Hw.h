@@ -29,12 +29,17 @@
 #define __PET2001HW_H__
 
 #include "MemSpace.h"
+#include "DirtyPages.h"
+#include "StateHash.h"
+#include "Image.h"
 #include "Pet2001Io.h"
 
 class Cpu6502;
 class PetVideo;
 class PetCassHw;
 class PetIeeeHw;
+class StateWriter;
+class StateReader;
 
 #define MAX_RAM_SIZE	0x8000	// 32K
 #define VIDRAM_ADDR	0x8000
@@ -49,8 +54,10 @@ private:
 	Pet2001Io	io;
 	PetVideo	*video;
 	uint8_t		ram[MAX_RAM_SIZE];
-	uint8_t		rom[ROM_SIZE];
+	RomPages<(ROM_SIZE >> ROM_PAGE_SHIFT)> rom;	// shared images
 	uint16_t	ramsize;
+	DirtyPages	dirty;
+	RamHash		ramhash;
 
 public:
 	Pet2001Hw(Cpu6502 *cpu, PetVideo *video,
@@ -59,6 +66,14 @@ public:
 	{
 		this->video = video;
 		ramsize = MAX_RAM_SIZE;
+		memset(ram, 0x44, sizeof(ram));
+		ramhash.rehash(ram, MAX_RAM_SIZE);
+
+		// RAM, video RAM and ROM only change through write paths.
+		dirty.setTracked(0, IO_ADDR >> DIRTY_PAGE_SHIFT);
+		dirty.setTracked((IO_ADDR + IO_SIZE) >> DIRTY_PAGE_SHIFT,
+				 (0x10000 - IO_ADDR - IO_SIZE) >>
+				 DIRTY_PAGE_SHIFT);
 	}
 
 	uint8_t read(uint16_t addr);
@@ -76,10 +91,18 @@ public:
 	void setRamsize(int ramsize)
 	{ this->ramsize = ramsize; }
 	void writeRom(uint16_t addr, const uint8_t *data, int len);
-	void setAudioBuf(uint8_t *buf, int len)
-	{ io.setAudioBuf(buf, len); }
-	int getAudioTail(void)
-	{ return io.getAudioTail(); }
+	void setRom(uint16_t addr, ImageRef image, size_t offset, int len);
+	void setAudioRing(AudioRing *ring)
+	{ io.setAudioRing(ring); }
+	DirtyPages *getDirtyPages(void)
+	{ return &dirty; }
+	void saveState(StateWriter &w);
+	void loadState(StateReader &r);
+	uint64_t stateHash(StateWriter &w);
+	uint64_t romHash(void) const
+	{ return rom.hash(); }
+	int	getRamsize(void) const
+	{ return ramsize; }
 };
 
 #endif // __PET2001HW_H__
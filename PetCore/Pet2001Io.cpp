@@ -33,6 +33,7 @@
 #include "PetVideo.h"
 #include "PetCassHw.h"
 #include "PetIeeeHw.h"
+#include "SaveState.h"
 
 #ifdef DEBUGIO
 extern unsigned int cycles;
@@ -72,6 +73,8 @@ extern unsigned int cycles;
 #define VIA_IER		0x4e
 #define VIA_ANH		0x4f
 
+#define CB2_AMPLITUDE	12000	// sound sample level when CB2 high
+
 // PET I/O in a nut-shell:
 //
 // PIA1.PA[3:0] =>  keyrow (0..9, 11=light LED)
@@ -121,6 +124,7 @@ Pet2001Io::reset(void)
 	pia1_pb_out =	0;
 	pia1_ddrb =	0;
 	pia1_crb =	0;
+	pia1_ca1 =	0;
 	pia1_ca2 =	0;
 	pia1_cb1 =	0;
 
@@ -149,6 +153,7 @@ Pet2001Io::reset(void)
 	via_t2ch =	0xff;
 	via_t2_1shot =	0;
 	via_t2_undf =	0;
+	via_t2ll =	0xff;
 	via_sr =	0;
 	via_sr_cntr =	0;
 	via_sr_start =  0;
@@ -160,6 +165,9 @@ Pet2001Io::reset(void)
 	via_cb1 =	1;
 	via_cb2 =	1;
 
+	sound_on =	false;
+	sound.reset();
+
 	video_cycle =	0;
 
 	if (ieee)
@@ -662,6 +670,7 @@ Pet2001Io::write(uint16_t addr, uint8_t d8)
 			via_cb1 = 1;
 		}
 		via_acr = d8;
+		cb2Sound();
 		break;
 	case VIA_PCR:
 		// Did we change CA2 output?
@@ -690,6 +699,19 @@ Pet2001Io::write(uint16_t addr, uint8_t d8)
 	}
 }
 
+// Record a change in CB2 sound output.  Only the free-running shift
+// register mode is taken as sound.  Times are clocks into the video frame.
+void
+Pet2001Io::cb2Sound(void)
+{
+	bool on = (via_acr & 0x1c) == 0x10 && via_cb2;
+
+	if (on != sound_on) {
+		sound_on = on;
+		sound.addTransition(video_cycle, on ? CB2_AMPLITUDE : 0);
+	}
+}
+
 void
 Pet2001Io::cycle(void)
 {
@@ -700,6 +722,7 @@ Pet2001Io::cycle(void)
 		sync(0);
 		if (video)
 			video->sync();
+		sound.endFrame(video_cycle);
 		video_cycle = 0;
 	}
 
@@ -741,6 +764,7 @@ Pet2001Io::cycle(void)
 			if (via_cb1) {
 				via_sr = (via_sr >> 7) | (via_sr << 1);
 				via_cb2 = via_sr & 1;
+				cb2Sound();
 				DPRINTF(3, "Pet2001Io::%s: SR=0x%02x\n",
 					__func__, via_sr);
 			}
@@ -802,13 +826,6 @@ Pet2001Io::cycle(void)
 		via_sr_cntr = (via_acr & 0x10) == 0 ? 8 : 9;
 	}
 
-	// Handle CB2 sound.
-	if (audiobuf && (via_acr & 0x1c) == 0x10) {
-		audiobuf[audiobuftail] = via_cb2 ? 0xff : 0x00;
-		if (++audiobuftail >= audiobuflen)
-			audiobuftail = 0;
-	}
-
 	// Look for changes in CA1 (cassette input).
 	if (cass) {
 		int read = cass->readData();
@@ -827,3 +844,138 @@ Pet2001Io::cycle(void)
 			cass->cycle();
 	}
 }
+
+// PIA and VIA registers.  The cassette and IEEE interfaces follow in
+// their own chunks.
+void
+Pet2001Io::saveState(StateWriter &w)
+{
+	w.beginChunk("PIO ");
+	w.put8(pia1_pa_in);
+	w.put8(pia1_pa_out);
+	w.put8(pia1_ddra);
+	w.put8(pia1_cra);
+	w.put8(pia1_pb_in);
+	w.put8(pia1_pb_out);
+	w.put8(pia1_ddrb);
+	w.put8(pia1_crb);
+	w.put8(pia1_ca1);
+	w.put8(pia1_ca2);
+	w.put8(pia1_cb1);
+
+	w.put8(pia2_pa_in);
+	w.put8(pia2_pa_out);
+	w.put8(pia2_ddra);
+	w.put8(pia2_cra);
+	w.put8(pia2_pb_in);
+	w.put8(pia2_pb_out);
+	w.put8(pia2_ddrb);
+	w.put8(pia2_crb);
+
+	w.put8(via_drb_in);
+	w.put8(via_drb_out);
+	w.put8(via_dra_in);
+	w.put8(via_dra_out);
+	w.put8(via_ddrb);
+	w.put8(via_ddra);
+	w.put8(via_t1cl);
+	w.put8(via_t1ch);
+	w.put8(via_t1_1shot);
+	w.put8(via_t1_undf);
+	w.put8(via_t1ll);
+	w.put8(via_t1lh);
+	w.put8(via_t2cl);
+	w.put8(via_t2ch);
+	w.put8(via_t2_1shot);
+	w.put8(via_t2_undf);
+	w.put8(via_t2ll);
+	w.put8(via_sr);
+	w.put8(via_sr_cntr);
+	w.put8(via_sr_start);
+	w.put8(via_acr);
+	w.put8(via_pcr);
+	w.put8(via_ifr);
+	w.put8(via_ier);
+	w.put8(via_cb1);
+	w.put8(via_cb2);
+
+	w.putBool(sound_on);
+	w.putBytes(keyrow, sizeof(keyrow));
+	w.putInt(video_cycle);
+	w.endChunk();
+
+	if (cass)
+		cass->saveState(w);
+	if (ieee)
+		ieee->saveState(w);
+}
+
+void
+Pet2001Io::loadState(StateReader &r)
+{
+	if (!r.openChunk("PIO "))
+		return;
+	pia1_pa_in = r.get8();
+	pia1_pa_out = r.get8();
+	pia1_ddra = r.get8();
+	pia1_cra = r.get8();
+	pia1_pb_in = r.get8();
+	pia1_pb_out = r.get8();
+	pia1_ddrb = r.get8();
+	pia1_crb = r.get8();
+	pia1_ca1 = r.get8();
+	pia1_ca2 = r.get8();
+	pia1_cb1 = r.get8();
+
+	pia2_pa_in = r.get8();
+	pia2_pa_out = r.get8();
+	pia2_ddra = r.get8();
+	pia2_cra = r.get8();
+	pia2_pb_in = r.get8();
+	pia2_pb_out = r.get8();
+	pia2_ddrb = r.get8();
+	pia2_crb = r.get8();
+
+	via_drb_in = r.get8();
+	via_drb_out = r.get8();
+	via_dra_in = r.get8();
+	via_dra_out = r.get8();
+	via_ddrb = r.get8();
+	via_ddra = r.get8();
+	via_t1cl = r.get8();
+	via_t1ch = r.get8();
+	via_t1_1shot = r.get8();
+	via_t1_undf = r.get8();
+	via_t1ll = r.get8();
+	via_t1lh = r.get8();
+	via_t2cl = r.get8();
+	via_t2ch = r.get8();
+	via_t2_1shot = r.get8();
+	via_t2_undf = r.get8();
+	via_t2ll = r.get8();
+	via_sr = r.get8();
+	via_sr_cntr = r.get8();
+	via_sr_start = r.get8();
+	via_acr = r.get8();
+	via_pcr = r.get8();
+	via_ifr = r.get8();
+	via_ier = r.get8();
+	via_cb1 = r.get8();
+	via_cb2 = r.get8();
+
+	sound_on = r.getBool();
+	r.getBytes(keyrow, sizeof(keyrow));
+	video_cycle = r.getInt();
+	r.endChunk();
+
+	sound.seek(video_cycle, sound_on ? CB2_AMPLITUDE : 0);
+
+	if (cass) {
+		cass->loadState(r);
+		// The motor is driven by CB2, as in write().
+		cass->setMotor((pia1_crb & 0x20) == 0 ||
+			       (pia1_crb & 0x08) == 0);
+	}
+	if (ieee)
+		ieee->loadState(r);
+}
@@ -29,11 +29,18 @@
 #define __PET2001IO_H__
 
 #include "MemSpace.h"
+#include "BlepSynth.h"
 
 class Cpu6502;
 class PetVideo;
 class PetCassHw;
 class PetIeeeHw;
+class AudioRing;
+class StateWriter;
+class StateReader;
+
+#define PET_CLOCK_RATE	1000000		// Hz
+#define PET_FRAME_CYCLES 16640		// clocks per video frame
 
 class Pet2001Io : MemSpace {
 private:
@@ -41,9 +48,7 @@ private:
 	PetVideo	*video;
 	PetCassHw	*cass;
 	PetIeeeHw	*ieee;
-	uint8_t		*audiobuf;
-	int		audiobuflen;
-	int		audiobuftail;
+	BlepSynth	sound;
 
 	uint8_t		pia1_pa_in;
 	uint8_t		pia1_pa_out;
@@ -92,11 +97,13 @@ private:
 	uint8_t		via_ier;
 	uint8_t		via_cb1;
 	uint8_t		via_cb2;
+	bool		sound_on;	// CB2 free-running sound output
 
 	uint8_t		keyrow[10];
 	int		video_cycle;
 
 	void updateIrq(void);
+	void cb2Sound(void);
 	void sync(int sync);
 public:
 	Pet2001Io(Cpu6502 *cpu, PetVideo *video,
@@ -105,29 +112,21 @@ public:
 		  video(video),
 		  cass(cass),
 		  ieee(ieee),
-		  audiobuf(0)
+		  sound(PET_CLOCK_RATE)
 	{
 		reset();
 	}
 	void setVideo(PetVideo *video) { this->video = video; }
 	uint8_t read(uint16_t addr);
 	void write(uint16_t addr, uint8_t d8);
-	void setAudioBuf(uint8_t *buf, int len)
-	{
-		audiobuf = buf;
-		audiobuflen = len;
-		audiobuftail = 0;
-	}
-	int getAudioTail(void)
-	{
-		int tail = audiobuftail;
-		audiobuftail = 0;
-		return tail;
-	}
+	void setAudioRing(AudioRing *ring)
+	{ sound.setRing(ring); }
 
 	void setKeyrow(int row, uint8_t keyrow);
 	void reset(void);
 	void cycle(void);
+	void saveState(StateWriter &w);
+	void loadState(StateReader &r);
 };
 
 #endif // __PET2001IO_H__
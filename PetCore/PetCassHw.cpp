@@ -28,6 +28,7 @@
 #include <stdint.h>
 
 #include "PetCassHw.h"
+#include "SaveState.h"
 
 #ifdef DEBUGCASS
 extern unsigned int cycles;
@@ -277,6 +278,8 @@ void
 PetCassHw::setMotor(bool set)
 {
 	DPRINTF(1, "PetCassHw::%s: set=%d\n", __func__, set);
+
+	motor = set;
 }
 
 // Can also be used to cancel a load or save.
@@ -289,6 +292,46 @@ PetCassHw::reset(void)
 	delay_cycle = 0;
 	csense = 0;
 	rdata = 1;
+	motor = false;
+}
+
+// Where a load or save is.  The tape data itself isn't saved; a state
+// taken mid-load carries on with whatever tape is loaded.
+void
+PetCassHw::saveState(StateWriter &w)
+{
+	w.beginChunk("CASS");
+	w.putInt(delay_cycle);
+	w.putInt(edge_count);
+	w.putInt(offset);
+	w.putInt(bitcount);
+	w.put8(byte);
+	w.putInt(parity);
+	w.putInt(state);
+	w.putInt(rdata);
+	w.putInt(csense);
+	w.putInt(blocklen);
+	w.putInt(data_len);
+	w.endChunk();
+}
+
+void
+PetCassHw::loadState(StateReader &r)
+{
+	if (!r.openChunk("CASS"))
+		return;
+	delay_cycle = r.getInt();
+	edge_count = r.getInt();
+	offset = r.getInt();
+	bitcount = r.getInt();
+	byte = r.get8();
+	parity = r.getInt();
+	state = r.getInt();
+	rdata = r.getInt();
+	csense = r.getInt();
+	blocklen = r.getInt();
+	data_len = r.getInt();
+	r.endChunk();
 }
 
 void
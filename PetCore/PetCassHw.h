@@ -30,6 +30,9 @@
 
 #include <functional>
 
+class StateWriter;
+class StateReader;
+
 class PetCassHw {
 private:
 	int	delay_cycle;
@@ -45,6 +48,7 @@ private:
 	uint8_t *hdr_data;
 	uint8_t *progdata;
 	int	data_len;
+	bool	motor;
 
 	std::function<void (int)> cass_done_cb;
 
@@ -61,8 +65,11 @@ public:
 	int	readData(void) { return rdata; }
 	int	sense(void) { return csense; }
 	void	setMotor(bool set);
+	bool	isMotorOn(void) { return motor; }
 	void	reset(void);
 	void	cycle(void);
+	void	saveState(StateWriter &w);
+	void	loadState(StateReader &r);
 };
 
 #endif // __PETCASSHW_H__
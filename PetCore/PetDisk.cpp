@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <vector>
 
 #include "PetDisk.h"
 
@@ -126,24 +127,20 @@ PetDisk::nextDirEnt(enum fileType &ftype, int &fsize)
 	}
 }
 
-void
-PetDisk::blankDisk(void)
+// A blank disk is the same for every drive, so it is built once.
+ImageRef
+PetDisk::makeBlankDisk(void)
 {
-	DPRINTF(1, "PetDisk::%s:\n", __func__);
-
-	diskdata_len = MAX_DISK_LEN;
-	memset(diskdata, 0, diskdata_len);
+	std::vector<uint8_t> diskdata(MAX_DISK_LEN, 0);
 
 	int hdr = trackOff(18);
-	memset(diskdata + hdr + 0x90, 0xa0, 16);
-	memcpy(diskdata + hdr + 0x90, "NEWDISK", 7);
+	memset(&diskdata[hdr + 0x90], 0xa0, 16);
+	memcpy(&diskdata[hdr + 0x90], "NEWDISK", 7);
 
 	diskdata[hdr + 0x00] = 0x12; // First directory track
 	diskdata[hdr + 0x01] = 0x01; // First directory sector
 	diskdata[hdr + 0x02] = 0x41; // DOS version "A"
 
-	blocks_free = 0;
-
 	// Fill out BAM entries
 	for(int trk = 0; trk < 36; trk++) {
 		int n = nsects(trk);
@@ -151,7 +148,6 @@ PetDisk::blankDisk(void)
 			n = 0;
 
 		diskdata[hdr + trk * 4] = n;
-		blocks_free += n;
 
 		uint32_t mask = 0xffffff >> (24 - n);
 		diskdata[hdr + trk * 4 + 1] = mask & 0xff;
@@ -165,7 +161,7 @@ PetDisk::blankDisk(void)
 	diskdata[hdr + 0xa4] = 0xa0;
 	diskdata[hdr + 0xa5] = 0x32;	// DOS type "2A"
 	diskdata[hdr + 0xa6] = 0x41;
-	memset(diskdata + hdr + 0xa7, 0xa0, 4);
+	memset(&diskdata[hdr + 0xa7], 0xa0, 4);
 
 	// Interleave directory sectors
 	const uint8_t intlv[] =
@@ -179,22 +175,51 @@ PetDisk::blankDisk(void)
 		diskdata[hdr + off] = 18;
 		diskdata[hdr + off + 1] = intlv[i + 1];
 	}
+
+	return Image::adopt(std::move(diskdata));
+}
+
+void
+PetDisk::blankDisk(void)
+{
+	static ImageRef blank = makeBlankDisk();
+
+	DPRINTF(1, "PetDisk::%s:\n", __func__);
+
+	setImage(blank);
+}
+
+void
+PetDisk::setImage(ImageRef _image)
+{
+	image.set(_image);
+	diskdata = image.getData();
+	diskdata_len = image.getSize();
+
+	blocks_free = 0;
+	int hdr = trackOff(18);
+	if (diskdata_len > hdr + 36 * 4)
+		for (int trk = 0; trk < 36; trk++)
+			blocks_free += diskdata[hdr + trk * 4];
 }
 
 void
 PetDisk::loadDisk(uint8_t data[], int len)
 {
-	DPRINTF(1, "PetDisk::%s: len=%d\n", __func__, len);
+	loadDisk(Image::copy(data, len));
+}
+
+// The image is shared, not copied.
+void
+PetDisk::loadDisk(ImageRef _image)
+{
+	DPRINTF(1, "PetDisk::%s: len=%zu\n", __func__, _image->getSize());
 
 	// XXX: we need to protect against short files and mal-formed disk
 	// images else we get all kinds of out of range errors.
 	//
 
-	diskdata_len = len;
-	if (len == 0)
-		return;
-
-	memcpy(diskdata, data, len);
+	setImage(_image);
 
 #ifdef DEBUGIEEE
 	char *s;
@@ -206,11 +231,6 @@ PetDisk::loadDisk(uint8_t data[], int len)
 			__func__, s, ftype, fsize);
 	}
 #endif // DEBUGIEEE
-
-	blocks_free = 0;
-	int hdr = trackOff(18);
-	for (int trk = 0; trk < 36; trk++)
-		blocks_free += diskdata[hdr + trk *4];
 }
 
 int
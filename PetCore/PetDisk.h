@@ -26,6 +26,8 @@
 #ifndef __PETDISK_H__
 #define __PETDISK_H__
 
+#include "Image.h"
+
 #define MAX_DISK_LEN		174848
 
 enum fileType {
@@ -38,13 +40,16 @@ enum fileType {
 
 class PetDisk {
 private:
-	uint8_t		diskdata[MAX_DISK_LEN];
+	CowImage	image;		// shared until written
+	const uint8_t	*diskdata;
 	int		diskdata_len;
 	int		blocks_free;
 	int		curr_dirent;
 	int		next_dirsec;
-	int		trackOff(int track);
-	int		nsects(int track);
+	static int	trackOff(int track);
+	static int	nsects(int track);
+	static ImageRef	makeBlankDisk(void);
+	void		setImage(ImageRef _image);
 	void		firstDirEnt(void);
 	char		*nextDirEnt(enum fileType &ftype, int &size);
 	int		readDirectory(uint8_t *data, int maxlen);
@@ -53,6 +58,7 @@ public:
 	{ blankDisk(); }
 	void		blankDisk(void);
 	void		loadDisk(uint8_t data[], int len);
+	void		loadDisk(ImageRef _image);
 	int		readFile(const char *name, uint8_t *data,
 				 int maxlen);
 	int		writeFile(const char *name, const uint8_t *data,
@@ -29,6 +29,7 @@
 
 #include "PetIeeeHw.h"
 #include "IeeeDev.h"
+#include "SaveState.h"
 
 #ifdef DEBUGIEEE
 #  include <cstdio>
@@ -148,6 +149,60 @@ PetIeeeHw::doDataIn(uint8_t d8)
 	}
 }
 
+// Bus lines and the transfer in progress.  Files open on the device
+// are the device's business.
+void
+PetIeeeHw::saveState(StateWriter &w)
+{
+	w.beginChunk("IEEE");
+	w.put8(dio);
+	w.putBool(ndac_i);
+	w.putBool(ndac_o);
+	w.putBool(nrfd_i);
+	w.putBool(nrfd_o);
+	w.putBool(atn);
+	w.putBool(dav_i);
+	w.putBool(dav_o);
+	w.putBool(srq);
+	w.putBool(eoi_i);
+	w.putBool(eoi_o);
+	w.put8(state);
+	w.putBytes(filename, sizeof(filename));
+	w.putInt(fnum);
+	w.putInt(data_index);
+	w.putInt(sender_timeout);
+	w.endChunk();
+}
+
+void
+PetIeeeHw::loadState(StateReader &r)
+{
+	if (!r.openChunk("IEEE"))
+		return;
+	dio = r.get8();
+	ndac_i = r.getBool();
+	ndac_o = r.getBool();
+	nrfd_i = r.getBool();
+	nrfd_o = r.getBool();
+	atn = r.getBool();
+	dav_i = r.getBool();
+	dav_o = r.getBool();
+	srq = r.getBool();
+	eoi_i = r.getBool();
+	eoi_o = r.getBool();
+	uint8_t st = r.get8();
+	if (st > IEEE_STATE_TALK)
+		r.fail();
+	else
+		state = (decltype(state))st;
+	r.getBytes(filename, sizeof(filename));
+	filename[sizeof(filename) - 1] = '\0';
+	fnum = r.getInt();
+	data_index = r.getInt();
+	sender_timeout = r.getInt();
+	r.endChunk();
+}
+
 uint8_t
 PetIeeeHw::din(void)
 {
@@ -31,6 +31,8 @@
 #define SENDER_TIMEOUT_CYCLES	640000
 
 class IeeeDev;
+class StateWriter;
+class StateReader;
 
 class PetIeeeHw {
 private:
@@ -82,7 +84,12 @@ public:
 	bool	ndacIn(void)	{ return ndac_i && ndac_o; }
 	void	ndacOut(bool ndac);
 
+	// Addressed as a talker or listener.
+	bool	isBusy(void)	{ return state != IEEE_STATE_IDLE; }
+
 	void	cycle(void);
+	void	saveState(StateWriter &w);
+	void	loadState(StateReader &r);
 };
 
 #define MY_ADDRESS	8
@@ -0,0 +1,326 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// PetRender.cpp
+
+#include <stdint.h>
+#include <string.h>
+
+#include "PetRender.h"
+#include "SaveState.h"
+
+#ifdef DEBUGVID
+extern unsigned int cycles;
+#  include <cstdio>
+#  define DPRINTF(l, f, arg...)					\
+	do { if ((l) <= DEBUGVID) printf("[%d] " f, cycles, arg); } while (0)
+#else
+#  define DPRINTF(l, f, arg...)
+#endif
+
+extern uint8_t characters_1[];
+extern uint8_t characters_2[];
+
+/* VCYCLE0 is the number of 1us cycles after the SYNC signal goes low that
+ * the first video RAM data is read.  Video bytes are read each of the next
+ * 40 cycles.  The next line starts being read 64 cycles after the first.
+ */
+#define VCYCLE0	3863
+#define VCYCLEEND (VCYCLE0 + (64 * 199) + 40)
+
+PetRender::PetRender()
+	: fb(PET_NATIVE_WIDTH, PET_NATIVE_HEIGHT)
+{
+	DPRINTF(1, "PetRender::%s:\n", __func__);
+
+	fb.setPalette(PET_COLOR_BG, 0x00, 0x00, 0x00);
+	fb.setPalette(PET_COLOR_FG, 0xff, 0xff, 0xff);
+
+	charrom = characters_1;
+	version = 0;
+
+	reset();
+}
+
+void
+PetRender::setVersion(int n)
+{
+	DPRINTF(1, "PetRender::%s: n=%d\n", __func__, n);
+
+	if (version == n)
+		return;
+
+	version = n;
+
+	charrom = (version == 1 ? characters_2 : characters_1);
+	if (version > 0)
+		blank = false;
+}
+
+void
+PetRender::reset(void)
+{
+	DPRINTF(1, "PetRender::%s:\n", __func__);
+
+	blank = false;
+	alt_charset = false;
+	video_cycle = 0;
+	snowcycle = false;
+	snowbyte = 0;
+
+	// Initialize video RAM with pattern that shows all characters.
+	for (int i = 0; i < PET_VRAM_SIZE; i++)
+		vidmem[i] = (i & 255);
+
+	redraw();
+}
+
+// Paint the frame buffer background and forget what was drawn.  cycle()
+// or updateChar() will draw the current video RAM contents.  Used when
+// the buffer or its colors change.
+void
+PetRender::redraw(void)
+{
+	DPRINTF(1, "PetRender::%s:\n", __func__);
+
+	memset(vidpixels, 0x00, PET_VIDPIXELS_SIZE);
+
+	if (fb.isActive())
+		fb.fill(PET_COLOR_BG);
+}
+
+// Draw eight pixels of one character line.
+void
+PetRender::putByte(int x, int y, uint8_t cdata)
+{
+	uint8_t pix[8];
+
+	for (int i = 0; i < 8; i++) {
+		pix[i] = (cdata & 0x80) != 0 ? PET_COLOR_FG : PET_COLOR_BG;
+		cdata <<= 1;
+	}
+
+	fb.putSpan(x, y, pix, 8);
+}
+
+// updateChar() draws a character cell at once rather than as the
+// video beam reaches it.  Used to show changes while single-stepping.
+void
+PetRender::updateChar(int col, int row, uint8_t d8)
+{
+	DPRINTF(3, "PetRender::%s: col=%d row=%d d8=0x%02x\n", __func__,
+		col, row, d8);
+
+	if (!fb.isActive())
+		return;
+
+	int charoffset = (d8 & 0x7f) * 8 + (alt_charset ? 1024 : 0);
+
+	for (int y = 0; y < 8; y++) {
+		uint8_t cdata = charrom[charoffset++];
+		if ((d8 & 0x80) != 0)
+			cdata ^= 0xff;
+		if (blank)
+			cdata = 0x00;
+		if (cdata != vidpixels[col + (row * 8 + y) * 40]) {
+			vidpixels[col + (row * 8 + y) * 40] = cdata;
+			putByte(col * 8, row * 8 + y, cdata);
+		}
+	}
+}
+
+void
+PetRender::updateAll(void)
+{
+	DPRINTF(2, "PetRender::%s:\n", __func__);
+
+	for (int row = 0; row < 25; row++)
+		for (int col = 0; col < 40; col++)
+			updateChar(col, row, vidmem[row * 40 + col]);
+}
+
+void
+PetRender::write(uint16_t offset, uint8_t d8)
+{
+	DPRINTF(3, "PetRender::%s offset=0x%x d8=0x%02x:\n", __func__,
+		offset, d8);
+
+	offset &= (PET_VRAM_SIZE - 1);
+	vidmem[offset] = d8;
+
+	// Does this write produce snow?
+	if (version == 0 && video_cycle >= VCYCLE0 && video_cycle <
+	    VCYCLEEND && !blank && ((video_cycle - VCYCLE0) & 0x3f) < 40) {
+		snowcycle = true;
+		snowbyte = d8;
+	}
+}
+
+uint8_t
+PetRender::read(uint16_t offset)
+{
+	DPRINTF(3, "PetRender::%s offset=0x%x:\n", __func__, offset);
+
+	offset &= (PET_VRAM_SIZE - 1);
+	uint8_t d8 = vidmem[offset];
+
+	// Does this read produce snow?
+	if (version == 0 && video_cycle >= VCYCLE0 && video_cycle <
+	    VCYCLEEND && !blank && ((video_cycle - VCYCLE0) & 0x3f) < 40) {
+		snowcycle = true;
+		snowbyte = d8;
+	}
+
+	return d8;
+}
+
+void
+PetRender::setCharset(bool alt)
+{
+	DPRINTF(2, "PetRender::%s: alt=%d\n", __func__, alt);
+
+	this->alt_charset = alt;
+}
+
+void
+PetRender::setBlank(bool blank)
+{
+	DPRINTF(2, "PetRender::%s: blank=%d\n", __func__, blank);
+
+	if (version == 0)
+		this->blank = blank;
+}
+
+void
+PetRender::cycle(void)
+{
+	if (video_cycle < VCYCLE0 || video_cycle >= VCYCLEEND) {
+		video_cycle++;
+		return;
+	}
+
+	// Which byte is being read from video RAM?
+	int col = (video_cycle - VCYCLE0) & 0x3f;
+	if (col > 39) {
+		video_cycle++;
+		return;
+	}
+
+	// Nothing to draw into, but the snow byte is still used up so the
+	// state doesn't depend on whether anyone is watching.
+	if (!fb.isActive()) {
+		if (!blank)
+			snowcycle = false;
+		video_cycle++;
+		return;
+	}
+	int row = (video_cycle - VCYCLE0) >> 6;
+
+	DPRINTF(3, "PetRender::%s: video_cycle=%d col=%d row=%d\n",
+		__func__, video_cycle, col, row);
+
+	video_cycle++;
+
+	// Get byte from video memory.
+	uint8_t vbyte = vidmem[col + (row >> 3) * 40];
+	uint8_t cdata = 0;
+	if (!blank) {
+		if (snowcycle) {
+			DPRINTF(3, "PetRender::%s: snowcycle=true "
+				"snowbyte=%02x\n", __func__, snowbyte);
+			vbyte = snowbyte;
+			snowcycle = false;
+		}
+
+		// Get 8 pixels from charrom
+		int charoffset = (vbyte & 0x7f) * 8 +
+			(alt_charset ? 1024 : 0) + (row & 0x07);
+		cdata = charrom[charoffset];
+		if ((vbyte & 0x80) != 0)
+			cdata ^= 0xff;
+	}
+
+	// Update pixels?
+	if (cdata != vidpixels[col + row * 40]) {
+		vidpixels[col + row * 40] = cdata;
+		putByte(col * 8, row, cdata);
+	}
+}
+
+// Video RAM in its own chunk so PetVideoStub can read the same one.
+// The beam and charset are in PREN, which the stub neither writes nor
+// needs.  The version and colors are configuration and not saved.
+void
+PetRender::saveState(StateWriter &w)
+{
+	w.beginChunk("PVID");
+	w.putBytes(vidmem, PET_VRAM_SIZE);
+	w.endChunk();
+
+	w.beginChunk("PREN");
+	w.putBool(alt_charset);
+	w.putBool(blank);
+	w.putInt(video_cycle);
+	w.putBool(snowcycle);
+	w.put8(snowbyte);
+	w.endChunk();
+}
+
+void
+PetRender::loadState(StateReader &r)
+{
+	if (!r.openChunk("PVID"))
+		return;
+	r.getBytes(vidmem, PET_VRAM_SIZE);
+	r.endChunk();
+
+	// Missing from states saved by PetVideoStub.
+	alt_charset = false;
+	blank = false;
+	video_cycle = 0;
+	snowcycle = false;
+	snowbyte = 0;
+	if (r.findChunk("PREN")) {
+		alt_charset = r.getBool();
+		blank = r.getBool();
+		video_cycle = r.getInt();
+		snowcycle = r.getBool();
+		snowbyte = r.get8();
+		r.endChunk();
+	}
+
+	// Show it now rather than when the beam gets there.
+	updateAll();
+}
+
+// Called on falling edge of SYNC signal.
+void
+PetRender::sync(void)
+{
+	video_cycle = 0;
+
+	if (fb.isActive())
+		fb.frameComplete();
+}
@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2026 Thomas Skibo.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL AUTHOR OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+//
+
+// PetRender.h
+//
+//	PET video that draws into a core FrameBuffer.  Palette index 0 is
+//	the background and 1 the foreground.  Front ends present the
+//	frame buffer; batch programs can read it directly.
+//
+
+#ifndef __PETRENDER_H__
+#define __PETRENDER_H__
+
+#include "PetVideo.h"
+#include "FrameBuffer.h"
+
+#define PET_NATIVE_WIDTH	320
+#define PET_NATIVE_HEIGHT	200
+#define PET_VIDPIXELS_SIZE 	8000
+
+#define PET_COLOR_BG		0	// palette indices
+#define PET_COLOR_FG		1
+
+class PetRender : public PetVideo {
+protected:
+	FrameBuffer	fb;
+
+	uint8_t		vidmem[PET_VRAM_SIZE];
+	uint8_t		vidpixels[PET_VIDPIXELS_SIZE];
+	const uint8_t	*charrom;
+	int		version;
+	bool		alt_charset;
+	bool		blank;
+	int		video_cycle;
+	bool		snowcycle;
+	uint8_t		snowbyte;
+
+	void		putByte(int x, int y, uint8_t cdata);
+	void 		updateChar(int col, int row, uint8_t d8);
+	void		updateAll(void);
+public:
+	PetRender();
+
+	void		setVersion(int);	// 0 = PET 2001, 1 = PET 2001N.
+	void		redraw(void);
+	FrameBuffer	*getFrameBuffer(void)
+	{ return &this->fb; }
+	int		*getCycleCounter(void)
+	{ return &this->video_cycle; }
+
+	// PetVideo interface
+	void		sync(void);
+	void		reset(void);
+	void		cycle(void);
+	void		setCharset(bool alt);
+	void		setBlank(bool blank);
+
+	void		write(uint16_t offset, uint8_t d8);
+	uint8_t		read(uint16_t offset);
+	void		saveState(StateWriter &w);
+	void		loadState(StateReader &r);
+};
+
+#endif // __PETRENDER_H__
@@ -32,6 +32,9 @@
 
 #define PET_VRAM_SIZE	0x400
 
+class StateWriter;
+class StateReader;
+
 class PetVideo : public MemSpace {
 public:
 	virtual void	sync(void) = 0;
@@ -42,6 +45,8 @@ public:
 
 	virtual uint8_t read(uint16_t addr) = 0;
 	virtual void write(uint16_t addr, uint8_t d8) = 0;
+	virtual void saveState(StateWriter &w) = 0;
+	virtual void loadState(StateReader &r) = 0;
 };
 
 #endif // __PETVIDEO_H__
@@ -28,6 +28,7 @@
 #include <stdint.h>
 
 #include "PetVideoStub.h"
+#include "SaveState.h"
 
 #ifdef DEBUGVID
 extern unsigned int cycles;
@@ -78,3 +79,21 @@ PetVideoStub::setBlank(bool blank)
 {
 	DPRINTF(1, "PetVideoStub::%s: blank=%d\n", __func__, blank);
 }
+
+void
+PetVideoStub::saveState(StateWriter &w)
+{
+	w.beginChunk("PVID");
+	w.putBytes(vidmem, PET_VRAM_SIZE);
+	w.endChunk();
+}
+
+// Only video RAM.  The renderer's PREN chunk is ignored.
+void
+PetVideoStub::loadState(StateReader &r)
+{
+	if (!r.openChunk("PVID"))
+		return;
+	r.getBytes(vidmem, PET_VRAM_SIZE);
+	r.endChunk();
+}
@@ -42,6 +42,8 @@ public:
 
 	uint8_t	read(uint16_t addr);
 	void	write(uint16_t addr, uint8_t d8);
+	void	saveState(StateWriter &w);
+	void	loadState(StateReader &r);
 };
 
 #endif //  __PETVIDEOSTUB_H__
@@ -0,0 +1,520 @@
+#include <stdint.h>
+
+uint8_t characters_1[] = {
+	0x1c, 0x22, 0x4a, 0x56, 0x4c, 0x20, 0x1e, 0x00,
+	0x18, 0x24, 0x42, 0x7e, 0x42, 0x42, 0x42, 0x00,
+	0x7c, 0x22, 0x22, 0x3c, 0x22, 0x22, 0x7c, 0x00,
+	0x1c, 0x22, 0x40, 0x40, 0x40, 0x22, 0x1c, 0x00,
+	0x78, 0x24, 0x22, 0x22, 0x22, 0x24, 0x78, 0x00,
+	0x7e, 0x40, 0x40, 0x78, 0x40, 0x40, 0x7e, 0x00,
+	0x7e, 0x40, 0x40, 0x78, 0x40, 0x40, 0x40, 0x00,
+	0x1c, 0x22, 0x40, 0x4e, 0x42, 0x22, 0x1c, 0x00,
+	0x42, 0x42, 0x42, 0x7e, 0x42, 0x42, 0x42, 0x00,
+	0x1c, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1c, 0x00,
+	0x0e, 0x04, 0x04, 0x04, 0x04, 0x44, 0x38, 0x00,
+	0x42, 0x44, 0x48, 0x70, 0x48, 0x44, 0x42, 0x00,
+	0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x7e, 0x00,
+	0x42, 0x66, 0x5a, 0x5a, 0x42, 0x42, 0x42, 0x00,
+	0x42, 0x62, 0x52, 0x4a, 0x46, 0x42, 0x42, 0x00,
+	0x18, 0x24, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00,
+	0x7c, 0x42, 0x42, 0x7c, 0x40, 0x40, 0x40, 0x00,
+	0x18, 0x24, 0x42, 0x42, 0x4a, 0x24, 0x1a, 0x00,
+	0x7c, 0x42, 0x42, 0x7c, 0x48, 0x44, 0x42, 0x00,
+	0x3c, 0x42, 0x40, 0x3c, 0x02, 0x42, 0x3c, 0x00,
+	0x3e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00,
+	0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3c, 0x00,
+	0x42, 0x42, 0x42, 0x24, 0x24, 0x18, 0x18, 0x00,
+	0x42, 0x42, 0x42, 0x5a, 0x5a, 0x66, 0x42, 0x00,
+	0x42, 0x42, 0x24, 0x18, 0x24, 0x42, 0x42, 0x00,
+	0x22, 0x22, 0x22, 0x1c, 0x08, 0x08, 0x08, 0x00,
+	0x7e, 0x02, 0x04, 0x18, 0x20, 0x40, 0x7e, 0x00,
+	0x3c, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x00,
+	0x00, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00,
+	0x3c, 0x04, 0x04, 0x04, 0x04, 0x04, 0x3c, 0x00,
+	0x00, 0x08, 0x1c, 0x2a, 0x08, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x10, 0x20, 0x7f, 0x20, 0x10, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x08, 0x00,
+	0x24, 0x24, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x24, 0x24, 0x7e, 0x24, 0x7e, 0x24, 0x24, 0x00,
+	0x08, 0x1e, 0x28, 0x1c, 0x0a, 0x3c, 0x08, 0x00,
+	0x00, 0x62, 0x64, 0x08, 0x10, 0x26, 0x46, 0x00,
+	0x30, 0x48, 0x48, 0x30, 0x4a, 0x44, 0x3a, 0x00,
+	0x04, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x04, 0x08, 0x10, 0x10, 0x10, 0x08, 0x04, 0x00,
+	0x20, 0x10, 0x08, 0x08, 0x08, 0x10, 0x20, 0x00,
+	0x08, 0x2a, 0x1c, 0x3e, 0x1c, 0x2a, 0x08, 0x00,
+	0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x10,
+	0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00,
+	0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x00,
+	0x3c, 0x42, 0x46, 0x5a, 0x62, 0x42, 0x3c, 0x00,
+	0x08, 0x18, 0x28, 0x08, 0x08, 0x08, 0x3e, 0x00,
+	0x3c, 0x42, 0x02, 0x0c, 0x30, 0x40, 0x7e, 0x00,
+	0x3c, 0x42, 0x02, 0x1c, 0x02, 0x42, 0x3c, 0x00,
+	0x04, 0x0c, 0x14, 0x24, 0x7e, 0x04, 0x04, 0x00,
+	0x7e, 0x40, 0x78, 0x04, 0x02, 0x44, 0x38, 0x00,
+	0x1c, 0x20, 0x40, 0x7c, 0x42, 0x42, 0x3c, 0x00,
+	0x7e, 0x42, 0x04, 0x08, 0x10, 0x10, 0x10, 0x00,
+	0x3c, 0x42, 0x42, 0x3c, 0x42, 0x42, 0x3c, 0x00,
+	0x3c, 0x42, 0x42, 0x3e, 0x02, 0x04, 0x38, 0x00,
+	0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x00,
+	0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x08, 0x10,
+	0x0e, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0e, 0x00,
+	0x00, 0x00, 0x7e, 0x00, 0x7e, 0x00, 0x00, 0x00,
+	0x70, 0x18, 0x0c, 0x06, 0x0c, 0x18, 0x70, 0x00,
+	0x3c, 0x42, 0x02, 0x0c, 0x10, 0x00, 0x10, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
+	0x08, 0x1c, 0x3e, 0x7f, 0x7f, 0x1c, 0x3e, 0x00,
+	0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00,
+	0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+	0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+	0x00, 0x00, 0x00, 0x00, 0xe0, 0x10, 0x08, 0x08,
+	0x08, 0x08, 0x08, 0x04, 0x03, 0x00, 0x00, 0x00,
+	0x08, 0x08, 0x08, 0x10, 0xe0, 0x00, 0x00, 0x00,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xff,
+	0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+	0xff, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0xff, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+	0x00, 0x3c, 0x7e, 0x7e, 0x7e, 0x7e, 0x3c, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00,
+	0x36, 0x7f, 0x7f, 0x7f, 0x3e, 0x1c, 0x08, 0x00,
+	0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40,
+	0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x08, 0x08,
+	0x81, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x81,
+	0x00, 0x3c, 0x42, 0x42, 0x42, 0x42, 0x3c, 0x00,
+	0x08, 0x1c, 0x2a, 0x77, 0x2a, 0x08, 0x08, 0x00,
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+	0x08, 0x1c, 0x3e, 0x7f, 0x3e, 0x1c, 0x08, 0x00,
+	0x08, 0x08, 0x08, 0x08, 0xff, 0x08, 0x08, 0x08,
+	0xa0, 0x50, 0xa0, 0x50, 0xa0, 0x50, 0xa0, 0x50,
+	0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x01, 0x3e, 0x54, 0x14, 0x14, 0x00,
+	0xff, 0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0x03, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0xaa, 0x55, 0xaa, 0x55,
+	0xff, 0xfe, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0x80,
+	0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+	0x08, 0x08, 0x08, 0x08, 0x0f, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f,
+	0x08, 0x08, 0x08, 0x08, 0x0f, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xf8, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+	0x00, 0x00, 0x00, 0x00, 0x0f, 0x08, 0x08, 0x08,
+	0x08, 0x08, 0x08, 0x08, 0xff, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0x08, 0x08, 0x08,
+	0x08, 0x08, 0x08, 0x08, 0xf8, 0x08, 0x08, 0x08,
+	0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0,
+	0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0,
+	0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+	0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xff,
+	0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0xf0, 0xf0,
+	0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00,
+	0x08, 0x08, 0x08, 0x08, 0xf8, 0x00, 0x00, 0x00,
+	0xf0, 0xf0, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0xf0, 0xf0, 0xf0, 0x0f, 0x0f, 0x0f, 0x0f,
+	0x1c, 0x22, 0x4a, 0x56, 0x4c, 0x20, 0x1e, 0x00,
+	0x18, 0x24, 0x42, 0x7e, 0x42, 0x42, 0x42, 0x00,
+	0x7c, 0x22, 0x22, 0x3c, 0x22, 0x22, 0x7c, 0x00,
+	0x1c, 0x22, 0x40, 0x40, 0x40, 0x22, 0x1c, 0x00,
+	0x78, 0x24, 0x22, 0x22, 0x22, 0x24, 0x78, 0x00,
+	0x7e, 0x40, 0x40, 0x78, 0x40, 0x40, 0x7e, 0x00,
+	0x7e, 0x40, 0x40, 0x78, 0x40, 0x40, 0x40, 0x00,
+	0x1c, 0x22, 0x40, 0x4e, 0x42, 0x22, 0x1c, 0x00,
+	0x42, 0x42, 0x42, 0x7e, 0x42, 0x42, 0x42, 0x00,
+	0x1c, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1c, 0x00,
+	0x0e, 0x04, 0x04, 0x04, 0x04, 0x44, 0x38, 0x00,
+	0x42, 0x44, 0x48, 0x70, 0x48, 0x44, 0x42, 0x00,
+	0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x7e, 0x00,
+	0x42, 0x66, 0x5a, 0x5a, 0x42, 0x42, 0x42, 0x00,
+	0x42, 0x62, 0x52, 0x4a, 0x46, 0x42, 0x42, 0x00,
+	0x18, 0x24, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00,
+	0x7c, 0x42, 0x42, 0x7c, 0x40, 0x40, 0x40, 0x00,
+	0x18, 0x24, 0x42, 0x42, 0x4a, 0x24, 0x1a, 0x00,
+	0x7c, 0x42, 0x42, 0x7c, 0x48, 0x44, 0x42, 0x00,
+	0x3c, 0x42, 0x40, 0x3c, 0x02, 0x42, 0x3c, 0x00,
+	0x3e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00,
+	0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3c, 0x00,
+	0x42, 0x42, 0x42, 0x24, 0x24, 0x18, 0x18, 0x00,
+	0x42, 0x42, 0x42, 0x5a, 0x5a, 0x66, 0x42, 0x00,
+	0x42, 0x42, 0x24, 0x18, 0x24, 0x42, 0x42, 0x00,
+	0x22, 0x22, 0x22, 0x1c, 0x08, 0x08, 0x08, 0x00,
+	0x7e, 0x02, 0x04, 0x18, 0x20, 0x40, 0x7e, 0x00,
+	0x3c, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x00,
+	0x00, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00,
+	0x3c, 0x04, 0x04, 0x04, 0x04, 0x04, 0x3c, 0x00,
+	0x00, 0x08, 0x1c, 0x2a, 0x08, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x10, 0x20, 0x7f, 0x20, 0x10, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x08, 0x00,
+	0x24, 0x24, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x24, 0x24, 0x7e, 0x24, 0x7e, 0x24, 0x24, 0x00,
+	0x08, 0x1e, 0x28, 0x1c, 0x0a, 0x3c, 0x08, 0x00,
+	0x00, 0x62, 0x64, 0x08, 0x10, 0x26, 0x46, 0x00,
+	0x30, 0x48, 0x48, 0x30, 0x4a, 0x44, 0x3a, 0x00,
+	0x04, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x04, 0x08, 0x10, 0x10, 0x10, 0x08, 0x04, 0x00,
+	0x20, 0x10, 0x08, 0x08, 0x08, 0x10, 0x20, 0x00,
+	0x08, 0x2a, 0x1c, 0x3e, 0x1c, 0x2a, 0x08, 0x00,
+	0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x10,
+	0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00,
+	0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x00,
+	0x3c, 0x42, 0x46, 0x5a, 0x62, 0x42, 0x3c, 0x00,
+	0x08, 0x18, 0x28, 0x08, 0x08, 0x08, 0x3e, 0x00,
+	0x3c, 0x42, 0x02, 0x0c, 0x30, 0x40, 0x7e, 0x00,
+	0x3c, 0x42, 0x02, 0x1c, 0x02, 0x42, 0x3c, 0x00,
+	0x04, 0x0c, 0x14, 0x24, 0x7e, 0x04, 0x04, 0x00,
+	0x7e, 0x40, 0x78, 0x04, 0x02, 0x44, 0x38, 0x00,
+	0x1c, 0x20, 0x40, 0x7c, 0x42, 0x42, 0x3c, 0x00,
+	0x7e, 0x42, 0x04, 0x08, 0x10, 0x10, 0x10, 0x00,
+	0x3c, 0x42, 0x42, 0x3c, 0x42, 0x42, 0x3c, 0x00,
+	0x3c, 0x42, 0x42, 0x3e, 0x02, 0x04, 0x38, 0x00,
+	0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x00,
+	0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x08, 0x10,
+	0x0e, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0e, 0x00,
+	0x00, 0x00, 0x7e, 0x00, 0x7e, 0x00, 0x00, 0x00,
+	0x70, 0x18, 0x0c, 0x06, 0x0c, 0x18, 0x70, 0x00,
+	0x3c, 0x42, 0x02, 0x0c, 0x10, 0x00, 0x10, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x38, 0x04, 0x3c, 0x44, 0x3a, 0x00,
+	0x40, 0x40, 0x5c, 0x62, 0x42, 0x62, 0x5c, 0x00,
+	0x00, 0x00, 0x3c, 0x42, 0x40, 0x42, 0x3c, 0x00,
+	0x02, 0x02, 0x3a, 0x46, 0x42, 0x46, 0x3a, 0x00,
+	0x00, 0x00, 0x3c, 0x42, 0x7e, 0x40, 0x3c, 0x00,
+	0x0c, 0x12, 0x10, 0x7c, 0x10, 0x10, 0x10, 0x00,
+	0x00, 0x00, 0x3a, 0x46, 0x46, 0x3a, 0x02, 0x3c,
+	0x40, 0x40, 0x5c, 0x62, 0x42, 0x42, 0x42, 0x00,
+	0x08, 0x00, 0x18, 0x08, 0x08, 0x08, 0x1c, 0x00,
+	0x04, 0x00, 0x0c, 0x04, 0x04, 0x04, 0x44, 0x38,
+	0x40, 0x40, 0x44, 0x48, 0x50, 0x68, 0x44, 0x00,
+	0x18, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1c, 0x00,
+	0x00, 0x00, 0x76, 0x49, 0x49, 0x49, 0x49, 0x00,
+	0x00, 0x00, 0x5c, 0x62, 0x42, 0x42, 0x42, 0x00,
+	0x00, 0x00, 0x3c, 0x42, 0x42, 0x42, 0x3c, 0x00,
+	0x00, 0x00, 0x5c, 0x62, 0x62, 0x5c, 0x40, 0x40,
+	0x00, 0x00, 0x3a, 0x46, 0x46, 0x3a, 0x02, 0x02,
+	0x00, 0x00, 0x5c, 0x62, 0x40, 0x40, 0x40, 0x00,
+	0x00, 0x00, 0x3e, 0x40, 0x3c, 0x02, 0x7c, 0x00,
+	0x10, 0x10, 0x7c, 0x10, 0x10, 0x12, 0x0c, 0x00,
+	0x00, 0x00, 0x42, 0x42, 0x42, 0x46, 0x3a, 0x00,
+	0x00, 0x00, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00,
+	0x00, 0x00, 0x41, 0x49, 0x49, 0x49, 0x36, 0x00,
+	0x00, 0x00, 0x42, 0x24, 0x18, 0x24, 0x42, 0x00,
+	0x00, 0x00, 0x42, 0x42, 0x46, 0x3a, 0x02, 0x3c,
+	0x00, 0x00, 0x7e, 0x04, 0x18, 0x20, 0x7e, 0x00,
+	0x08, 0x08, 0x08, 0x08, 0xff, 0x08, 0x08, 0x08,
+	0xa0, 0x50, 0xa0, 0x50, 0xa0, 0x50, 0xa0, 0x50,
+	0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+	0xcc, 0xcc, 0x33, 0x33, 0xcc, 0xcc, 0x33, 0x33,
+	0xcc, 0x66, 0x33, 0x99, 0xcc, 0x66, 0x33, 0x99,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0xaa, 0x55, 0xaa, 0x55,
+	0x99, 0x33, 0x66, 0xcc, 0x99, 0x33, 0x66, 0xcc,
+	0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+	0x08, 0x08, 0x08, 0x08, 0x0f, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f,
+	0x08, 0x08, 0x08, 0x08, 0x0f, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xf8, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+	0x00, 0x00, 0x00, 0x00, 0x0f, 0x08, 0x08, 0x08,
+	0x08, 0x08, 0x08, 0x08, 0xff, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0x08, 0x08, 0x08,
+	0x08, 0x08, 0x08, 0x08, 0xf8, 0x08, 0x08, 0x08,
+	0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0,
+	0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0,
+	0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+	0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff,
+	0x01, 0x02, 0x44, 0x48, 0x50, 0x60, 0x40, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0xf0, 0xf0,
+	0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00,
+	0x08, 0x08, 0x08, 0x08, 0xf8, 0x00, 0x00, 0x00,
+	0xf0, 0xf0, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0xf0, 0xf0, 0xf0, 0x0f, 0x0f, 0x0f, 0x0f
+};
+
+
+uint8_t characters_2[] = {
+	0x1c, 0x22, 0x4a, 0x56, 0x4c, 0x20, 0x1e, 0x00,
+	0x18, 0x24, 0x42, 0x7e, 0x42, 0x42, 0x42, 0x00,
+	0x7c, 0x22, 0x22, 0x3c, 0x22, 0x22, 0x7c, 0x00,
+	0x1c, 0x22, 0x40, 0x40, 0x40, 0x22, 0x1c, 0x00,
+	0x78, 0x24, 0x22, 0x22, 0x22, 0x24, 0x78, 0x00,
+	0x7e, 0x40, 0x40, 0x78, 0x40, 0x40, 0x7e, 0x00,
+	0x7e, 0x40, 0x40, 0x78, 0x40, 0x40, 0x40, 0x00,
+	0x1c, 0x22, 0x40, 0x4e, 0x42, 0x22, 0x1c, 0x00,
+	0x42, 0x42, 0x42, 0x7e, 0x42, 0x42, 0x42, 0x00,
+	0x1c, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1c, 0x00,
+	0x0e, 0x04, 0x04, 0x04, 0x04, 0x44, 0x38, 0x00,
+	0x42, 0x44, 0x48, 0x70, 0x48, 0x44, 0x42, 0x00,
+	0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x7e, 0x00,
+	0x42, 0x66, 0x5a, 0x5a, 0x42, 0x42, 0x42, 0x00,
+	0x42, 0x62, 0x52, 0x4a, 0x46, 0x42, 0x42, 0x00,
+	0x18, 0x24, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00,
+	0x7c, 0x42, 0x42, 0x7c, 0x40, 0x40, 0x40, 0x00,
+	0x18, 0x24, 0x42, 0x42, 0x4a, 0x24, 0x1a, 0x00,
+	0x7c, 0x42, 0x42, 0x7c, 0x48, 0x44, 0x42, 0x00,
+	0x3c, 0x42, 0x40, 0x3c, 0x02, 0x42, 0x3c, 0x00,
+	0x3e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00,
+	0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3c, 0x00,
+	0x42, 0x42, 0x42, 0x24, 0x24, 0x18, 0x18, 0x00,
+	0x42, 0x42, 0x42, 0x5a, 0x5a, 0x66, 0x42, 0x00,
+	0x42, 0x42, 0x24, 0x18, 0x24, 0x42, 0x42, 0x00,
+	0x22, 0x22, 0x22, 0x1c, 0x08, 0x08, 0x08, 0x00,
+	0x7e, 0x02, 0x04, 0x18, 0x20, 0x40, 0x7e, 0x00,
+	0x3c, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x00,
+	0x00, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00,
+	0x3c, 0x04, 0x04, 0x04, 0x04, 0x04, 0x3c, 0x00,
+	0x00, 0x08, 0x1c, 0x2a, 0x08, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x10, 0x20, 0x7f, 0x20, 0x10, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x08, 0x00,
+	0x24, 0x24, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x24, 0x24, 0x7e, 0x24, 0x7e, 0x24, 0x24, 0x00,
+	0x08, 0x1e, 0x28, 0x1c, 0x0a, 0x3c, 0x08, 0x00,
+	0x00, 0x62, 0x64, 0x08, 0x10, 0x26, 0x46, 0x00,
+	0x30, 0x48, 0x48, 0x30, 0x4a, 0x44, 0x3a, 0x00,
+	0x04, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x04, 0x08, 0x10, 0x10, 0x10, 0x08, 0x04, 0x00,
+	0x20, 0x10, 0x08, 0x08, 0x08, 0x10, 0x20, 0x00,
+	0x08, 0x2a, 0x1c, 0x3e, 0x1c, 0x2a, 0x08, 0x00,
+	0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x10,
+	0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00,
+	0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x00,
+	0x3c, 0x42, 0x46, 0x5a, 0x62, 0x42, 0x3c, 0x00,
+	0x08, 0x18, 0x28, 0x08, 0x08, 0x08, 0x3e, 0x00,
+	0x3c, 0x42, 0x02, 0x0c, 0x30, 0x40, 0x7e, 0x00,
+	0x3c, 0x42, 0x02, 0x1c, 0x02, 0x42, 0x3c, 0x00,
+	0x04, 0x0c, 0x14, 0x24, 0x7e, 0x04, 0x04, 0x00,
+	0x7e, 0x40, 0x78, 0x04, 0x02, 0x44, 0x38, 0x00,
+	0x1c, 0x20, 0x40, 0x7c, 0x42, 0x42, 0x3c, 0x00,
+	0x7e, 0x42, 0x04, 0x08, 0x10, 0x10, 0x10, 0x00,
+	0x3c, 0x42, 0x42, 0x3c, 0x42, 0x42, 0x3c, 0x00,
+	0x3c, 0x42, 0x42, 0x3e, 0x02, 0x04, 0x38, 0x00,
+	0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x00,
+	0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x08, 0x10,
+	0x0e, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0e, 0x00,
+	0x00, 0x00, 0x7e, 0x00, 0x7e, 0x00, 0x00, 0x00,
+	0x70, 0x18, 0x0c, 0x06, 0x0c, 0x18, 0x70, 0x00,
+	0x3c, 0x42, 0x02, 0x0c, 0x10, 0x00, 0x10, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
+	0x08, 0x1c, 0x3e, 0x7f, 0x7f, 0x1c, 0x3e, 0x00,
+	0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00,
+	0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+	0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+	0x00, 0x00, 0x00, 0x00, 0xe0, 0x10, 0x08, 0x08,
+	0x08, 0x08, 0x08, 0x04, 0x03, 0x00, 0x00, 0x00,
+	0x08, 0x08, 0x08, 0x10, 0xe0, 0x00, 0x00, 0x00,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xff,
+	0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+	0xff, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0xff, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+	0x00, 0x3c, 0x7e, 0x7e, 0x7e, 0x7e, 0x3c, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00,
+	0x36, 0x7f, 0x7f, 0x7f, 0x3e, 0x1c, 0x08, 0x00,
+	0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40,
+	0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x08, 0x08,
+	0x81, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x81,
+	0x00, 0x3c, 0x42, 0x42, 0x42, 0x42, 0x3c, 0x00,
+	0x08, 0x1c, 0x2a, 0x77, 0x2a, 0x08, 0x08, 0x00,
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+	0x08, 0x1c, 0x3e, 0x7f, 0x3e, 0x1c, 0x08, 0x00,
+	0x08, 0x08, 0x08, 0x08, 0xff, 0x08, 0x08, 0x08,
+	0xa0, 0x50, 0xa0, 0x50, 0xa0, 0x50, 0xa0, 0x50,
+	0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x01, 0x3e, 0x54, 0x14, 0x14, 0x00,
+	0xff, 0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0x03, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0xaa, 0x55, 0xaa, 0x55,
+	0xff, 0xfe, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0x80,
+	0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+	0x08, 0x08, 0x08, 0x08, 0x0f, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f,
+	0x08, 0x08, 0x08, 0x08, 0x0f, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xf8, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+	0x00, 0x00, 0x00, 0x00, 0x0f, 0x08, 0x08, 0x08,
+	0x08, 0x08, 0x08, 0x08, 0xff, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0x08, 0x08, 0x08,
+	0x08, 0x08, 0x08, 0x08, 0xf8, 0x08, 0x08, 0x08,
+	0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0,
+	0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0,
+	0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+	0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xff,
+	0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0xf0, 0xf0,
+	0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00,
+	0x08, 0x08, 0x08, 0x08, 0xf8, 0x00, 0x00, 0x00,
+	0xf0, 0xf0, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0xf0, 0xf0, 0xf0, 0x0f, 0x0f, 0x0f, 0x0f,
+	0x1c, 0x22, 0x4a, 0x56, 0x4c, 0x20, 0x1e, 0x00,
+	0x00, 0x00, 0x38, 0x04, 0x3c, 0x44, 0x3a, 0x00,
+	0x40, 0x40, 0x5c, 0x62, 0x42, 0x62, 0x5c, 0x00,
+	0x00, 0x00, 0x3c, 0x42, 0x40, 0x42, 0x3c, 0x00,
+	0x02, 0x02, 0x3a, 0x46, 0x42, 0x46, 0x3a, 0x00,
+	0x00, 0x00, 0x3c, 0x42, 0x7e, 0x40, 0x3c, 0x00,
+	0x0c, 0x12, 0x10, 0x7c, 0x10, 0x10, 0x10, 0x00,
+	0x00, 0x00, 0x3a, 0x46, 0x46, 0x3a, 0x02, 0x3c,
+	0x40, 0x40, 0x5c, 0x62, 0x42, 0x42, 0x42, 0x00,
+	0x08, 0x00, 0x18, 0x08, 0x08, 0x08, 0x1c, 0x00,
+	0x04, 0x00, 0x0c, 0x04, 0x04, 0x04, 0x44, 0x38,
+	0x40, 0x40, 0x44, 0x48, 0x50, 0x68, 0x44, 0x00,
+	0x18, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1c, 0x00,
+	0x00, 0x00, 0x76, 0x49, 0x49, 0x49, 0x49, 0x00,
+	0x00, 0x00, 0x5c, 0x62, 0x42, 0x42, 0x42, 0x00,
+	0x00, 0x00, 0x3c, 0x42, 0x42, 0x42, 0x3c, 0x00,
+	0x00, 0x00, 0x5c, 0x62, 0x62, 0x5c, 0x40, 0x40,
+	0x00, 0x00, 0x3a, 0x46, 0x46, 0x3a, 0x02, 0x02,
+	0x00, 0x00, 0x5c, 0x62, 0x40, 0x40, 0x40, 0x00,
+	0x00, 0x00, 0x3e, 0x40, 0x3c, 0x02, 0x7c, 0x00,
+	0x10, 0x10, 0x7c, 0x10, 0x10, 0x12, 0x0c, 0x00,
+	0x00, 0x00, 0x42, 0x42, 0x42, 0x46, 0x3a, 0x00,
+	0x00, 0x00, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00,
+	0x00, 0x00, 0x41, 0x49, 0x49, 0x49, 0x36, 0x00,
+	0x00, 0x00, 0x42, 0x24, 0x18, 0x24, 0x42, 0x00,
+	0x00, 0x00, 0x42, 0x42, 0x46, 0x3a, 0x02, 0x3c,
+	0x00, 0x00, 0x7e, 0x04, 0x18, 0x20, 0x7e, 0x00,
+	0x3c, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x00,
+	0x00, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00,
+	0x3c, 0x04, 0x04, 0x04, 0x04, 0x04, 0x3c, 0x00,
+	0x00, 0x08, 0x1c, 0x2a, 0x08, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x10, 0x20, 0x7f, 0x20, 0x10, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x08, 0x00,
+	0x24, 0x24, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x24, 0x24, 0x7e, 0x24, 0x7e, 0x24, 0x24, 0x00,
+	0x08, 0x1e, 0x28, 0x1c, 0x0a, 0x3c, 0x08, 0x00,
+	0x00, 0x62, 0x64, 0x08, 0x10, 0x26, 0x46, 0x00,
+	0x30, 0x48, 0x48, 0x30, 0x4a, 0x44, 0x3a, 0x00,
+	0x04, 0x08, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x04, 0x08, 0x10, 0x10, 0x10, 0x08, 0x04, 0x00,
+	0x20, 0x10, 0x08, 0x08, 0x08, 0x10, 0x20, 0x00,
+	0x08, 0x2a, 0x1c, 0x3e, 0x1c, 0x2a, 0x08, 0x00,
+	0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x10,
+	0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00,
+	0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x00,
+	0x3c, 0x42, 0x46, 0x5a, 0x62, 0x42, 0x3c, 0x00,
+	0x08, 0x18, 0x28, 0x08, 0x08, 0x08, 0x3e, 0x00,
+	0x3c, 0x42, 0x02, 0x0c, 0x30, 0x40, 0x7e, 0x00,
+	0x3c, 0x42, 0x02, 0x1c, 0x02, 0x42, 0x3c, 0x00,
+	0x04, 0x0c, 0x14, 0x24, 0x7e, 0x04, 0x04, 0x00,
+	0x7e, 0x40, 0x78, 0x04, 0x02, 0x44, 0x38, 0x00,
+	0x1c, 0x20, 0x40, 0x7c, 0x42, 0x42, 0x3c, 0x00,
+	0x7e, 0x42, 0x04, 0x08, 0x10, 0x10, 0x10, 0x00,
+	0x3c, 0x42, 0x42, 0x3c, 0x42, 0x42, 0x3c, 0x00,
+	0x3c, 0x42, 0x42, 0x3e, 0x02, 0x04, 0x38, 0x00,
+	0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x00, 0x00,
+	0x00, 0x00, 0x08, 0x00, 0x00, 0x08, 0x08, 0x10,
+	0x0e, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0e, 0x00,
+	0x00, 0x00, 0x7e, 0x00, 0x7e, 0x00, 0x00, 0x00,
+	0x70, 0x18, 0x0c, 0x06, 0x0c, 0x18, 0x70, 0x00,
+	0x3c, 0x42, 0x02, 0x0c, 0x10, 0x00, 0x10, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
+	0x18, 0x24, 0x42, 0x7e, 0x42, 0x42, 0x42, 0x00,
+	0x7c, 0x22, 0x22, 0x3c, 0x22, 0x22, 0x7c, 0x00,
+	0x1c, 0x22, 0x40, 0x40, 0x40, 0x22, 0x1c, 0x00,
+	0x78, 0x24, 0x22, 0x22, 0x22, 0x24, 0x78, 0x00,
+	0x7e, 0x40, 0x40, 0x78, 0x40, 0x40, 0x7e, 0x00,
+	0x7e, 0x40, 0x40, 0x78, 0x40, 0x40, 0x40, 0x00,
+	0x1c, 0x22, 0x40, 0x4e, 0x42, 0x22, 0x1c, 0x00,
+	0x42, 0x42, 0x42, 0x7e, 0x42, 0x42, 0x42, 0x00,
+	0x1c, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1c, 0x00,
+	0x0e, 0x04, 0x04, 0x04, 0x04, 0x44, 0x38, 0x00,
+	0x42, 0x44, 0x48, 0x70, 0x48, 0x44, 0x42, 0x00,
+	0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x7e, 0x00,
+	0x42, 0x66, 0x5a, 0x5a, 0x42, 0x42, 0x42, 0x00,
+	0x42, 0x62, 0x52, 0x4a, 0x46, 0x42, 0x42, 0x00,
+	0x18, 0x24, 0x42, 0x42, 0x42, 0x24, 0x18, 0x00,
+	0x7c, 0x42, 0x42, 0x7c, 0x40, 0x40, 0x40, 0x00,
+	0x18, 0x24, 0x42, 0x42, 0x4a, 0x24, 0x1a, 0x00,
+	0x7c, 0x42, 0x42, 0x7c, 0x48, 0x44, 0x42, 0x00,
+	0x3c, 0x42, 0x40, 0x3c, 0x02, 0x42, 0x3c, 0x00,
+	0x3e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00,
+	0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x3c, 0x00,
+	0x42, 0x42, 0x42, 0x24, 0x24, 0x18, 0x18, 0x00,
+	0x42, 0x42, 0x42, 0x5a, 0x5a, 0x66, 0x42, 0x00,
+	0x42, 0x42, 0x24, 0x18, 0x24, 0x42, 0x42, 0x00,
+	0x22, 0x22, 0x22, 0x1c, 0x08, 0x08, 0x08, 0x00,
+	0x7e, 0x02, 0x04, 0x18, 0x20, 0x40, 0x7e, 0x00,
+	0x08, 0x08, 0x08, 0x08, 0xff, 0x08, 0x08, 0x08,
+	0xa0, 0x50, 0xa0, 0x50, 0xa0, 0x50, 0xa0, 0x50,
+	0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+	0xcc, 0xcc, 0x33, 0x33, 0xcc, 0xcc, 0x33, 0x33,
+	0xcc, 0x66, 0x33, 0x99, 0xcc, 0x66, 0x33, 0x99,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0xaa, 0x55, 0xaa, 0x55,
+	0x99, 0x33, 0x66, 0xcc, 0x99, 0x33, 0x66, 0xcc,
+	0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+	0x08, 0x08, 0x08, 0x08, 0x0f, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f,
+	0x08, 0x08, 0x08, 0x08, 0x0f, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xf8, 0x08, 0x08, 0x08,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+	0x00, 0x00, 0x00, 0x00, 0x0f, 0x08, 0x08, 0x08,
+	0x08, 0x08, 0x08, 0x08, 0xff, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0x08, 0x08, 0x08,
+	0x08, 0x08, 0x08, 0x08, 0xf8, 0x08, 0x08, 0x08,
+	0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0,
+	0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0, 0xe0,
+	0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+	0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff,
+	0x01, 0x02, 0x44, 0x48, 0x50, 0x60, 0x40, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0xf0, 0xf0,
+	0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00,
+	0x08, 0x08, 0x08, 0x08, 0xf8, 0x00, 0x00, 0x00,
+	0xf0, 0xf0, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0xf0, 0xf0, 0xf0, 0x0f, 0x0f, 0x0f, 0x0f
+};
@@ -1,18 +1,246 @@
 #include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <new>
 
 #include "PetVideoStub.h"
+#include "PetRender.h"
 #include "Pet2001.h"
+#include "Movie.h"
+#include "Spawn.h"
+#include "Media.h"
+#include "BootCache.h"
 
 extern const uint8_t petrom1[];
 
+// Every PET here shares the one copy of the ROMs, from the ROM
+// directory if it has them.
+static void
+loadRom(Pet2001 &pet)
+{
+	static ImageRef rom = Media::findRom(MEDIA_PET, 1);
+
+	if (!rom)
+		rom = Image::wrap(petrom1, 0x3800);
+	pet.setRom(0xC000, rom, 0, rom->getSize());
+}
+
+// Replay a movie as fast as it goes and check its frame hashes.  The
+// hashes cover the renderer's state, so this uses the real one.
+static int
+playMovie(const char *filename)
+{
+	PetRender video;
+	Pet2001 pet(&video);
+	Movie movie("PET ", PET_FRAME_CYCLES);
+
+	loadRom(pet);
+
+	movie.setSaveFunc([&] (StateWriter &w) { pet.saveState(w); });
+	movie.setHashFunc([&] { return pet.stateHash(); });
+	movie.setLoadFunc([&] (StateReader &r) { return pet.loadState(r); });
+	movie.setInputFunc([&] (const InputEvent &in) {
+		pet.input(in.type, in.a, in.b);
+	});
+
+	if (!movie.load(filename) || !movie.play()) {
+		fprintf(stderr, "%s: can't play movie\n", filename);
+		return 1;
+	}
+
+	clock_t t = clock();
+	while (movie.isPlaying()) {
+		int n = movie.until(PET_FRAME_CYCLES);
+		for (int i = n; i > 0; )
+			if (pet.cycle())
+				i--;
+		movie.ran(n);
+	}
+	double secs = (double)(clock() - t) / CLOCKS_PER_SEC;
+
+	printf("%s: %u frames checked, %u mismatches", filename,
+	       movie.getChecked(), movie.getMismatches());
+	if (movie.getMismatches() > 0)
+		printf(" (first at clock %llu)",
+		       (unsigned long long)movie.getFirstMismatch());
+	if (secs > 0.0)
+		printf(", %.1fx real time",
+		       movie.getLength() / (PET_CLOCK_RATE * secs));
+	printf("\n");
+
+	return movie.getMismatches() > 0 ? 1 : 0;
+}
+
+#define PET_NDX		0x020d	// BASIC 1 keyboard buffer count
+#define PET_KEYD	0x020f	// and buffer, ten characters
+
+static void
+runFrames(Pet2001 &pet, int frames)
+{
+	for (int i = frames * PET_FRAME_CYCLES; i > 0; )
+		if (pet.cycle())
+			i--;
+}
+
+// Cold start BASIC up to READY, or load a snapshot of having done so.
+static void
+bootBasic(Pet2001 &pet, BootCache &cache)
+{
+	cache.setBootFunc([&] {
+		pet.reset();
+		for (int i = 0; i < 600 && !pet.basicReady(); i++)
+			runFrames(pet, 1);
+	});
+	cache.setSaveFunc([&] (StateWriter &w) { pet.saveState(w); });
+	cache.setLoadFunc([&] (StateReader &r) { return pet.loadState(r); });
+	cache.boot("PET ", pet.getRamsize(), pet.romHash());
+}
+
+// Type a line through the keyboard buffer and give BASIC time for it.
+static void
+typeLine(Pet2001 &pet, const char *s)
+{
+	uint8_t n = strlen(s);
+
+	pet.writeRange(PET_KEYD, (const uint8_t *)s, n);
+	pet.writeRange(PET_NDX, &n, 1);
+	runFrames(pet, 10);
+}
+
+// Boot BASIC and RUN a program that waits at an INPUT prompt, then fork
+// a branch answering each of 0 to n-1 and collect what it prints.
+static int
+branchBasic(int n)
+{
+	PetVideoStub video;
+	Pet2001 pet(&video);
+	Spawn spawn;
+	BootCache cache;
+	std::vector<std::string> results(n);
+
+	loadRom(pet);
+	bootBasic(pet, cache);
+
+	typeLine(pet, "1INPUTA\r");
+	typeLine(pet, "2?A*A+1\r");
+	typeLine(pet, "RUN\r");
+
+	spawn.setBranchFunc([&] (int branch, std::vector<uint8_t> &result) {
+		char line[12];
+		uint8_t scr[1000];
+
+		snprintf(line, sizeof(line), "%d\r", branch);
+		typeLine(pet, line);
+
+		// The answer is on the line after the prompt.
+		pet.readRange(0x8000, scr, sizeof(scr));
+		for (int row = 0; row < 24; row++)
+			if (scr[row * 40] == '?' && scr[row * 40 + 1] == ' ') {
+				result.assign(&scr[row * 40 + 40],
+					      &scr[row * 40 + 80]);
+				break;
+			}
+	});
+	spawn.setResultFunc([&] (int branch,
+				 const std::vector<uint8_t> &result) {
+		std::string s;
+		for (uint8_t c : result)
+			s += (c & 0x7f) < 0x20 ? (c & 0x7f) + 0x40 : c & 0x7f;
+		s.erase(s.find_last_not_of(' ') + 1);
+		results[branch] = s;
+	});
+
+	auto t0 = std::chrono::steady_clock::now();
+	spawn.run(0, n);
+	double secs = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - t0).count();
+
+	for (int i = 0; i < n && i < 8; i++)
+		printf("%d:%s\n", i, results[i].c_str());
+	printf("%u branches, %u failed\n", spawn.getFinished(),
+	       spawn.getFailed());
+	if (secs > 0.0)
+		printf("%.1f s, %.0f branches/s\n", secs,
+		       spawn.getFinished() / secs);
+
+	return spawn.getFailed() > 0 ? 1 : 0;
+}
+
+// A machine and its renderer built in memory full of junk, so that
+// anything the constructors or reset leave uninitialized shows up in
+// the hash.
+struct JunkPet {
+	void		*vmem;
+	void		*mmem;
+	PetRender	*video;
+	Pet2001		*pet;
+
+	JunkPet(uint8_t junk)
+	{
+		vmem = ::operator new(sizeof(PetRender));
+		mmem = ::operator new(sizeof(Pet2001));
+		memset(vmem, junk, sizeof(PetRender));
+		memset(mmem, junk, sizeof(Pet2001));
+		video = new (vmem) PetRender;
+		pet = new (mmem) Pet2001(video);
+	}
+	~JunkPet()
+	{
+		pet->~Pet2001();
+		video->~PetRender();
+		::operator delete(mmem);
+		::operator delete(vmem);
+	}
+};
+
+// Check two fresh machines hash the same from reset and every frame
+// after for frames.
+static int
+checkFresh(int frames)
+{
+	JunkPet a(0x00), b(0xa5);
+
+	loadRom(*a.pet);
+	loadRom(*b.pet);
+	a.pet->reset();
+	b.pet->reset();
+
+	for (int f = 0; f <= frames; f++) {
+		if (a.pet->stateHash() != b.pet->stateHash()) {
+			printf("fresh machines differ at frame %d\n", f);
+			return 1;
+		}
+		runFrames(*a.pet, 1);
+		runFrames(*b.pet, 1);
+	}
+
+	printf("fresh machines the same for %d frames\n", frames);
+
+	return 0;
+}
+
+// Usage: pet [-p movie]
+//	  pet -b branches
+//	  pet -d frames
 int
 main(int argc, char *argv[])
 {
+	if (argc > 2 && strcmp(argv[1], "-p") == 0)
+		return playMovie(argv[2]);
+	if (argc > 2 && strcmp(argv[1], "-b") == 0)
+		return branchBasic(atoi(argv[2]));
+	if (argc > 2 && strcmp(argv[1], "-d") == 0)
+		return checkFresh(atoi(argv[2]));
+
 	PetVideoStub video;
 	Pet2001 pet(&video);
 
-	pet.writeRom(0xC000, petrom1, 0x2800);
-	pet.writeRom(0xF000, petrom1 + 0x2800, 0x1000);
+	loadRom(pet);
 
 	pet.reset();
 	pet.cycle();
@@ -32,8 +32,10 @@
 
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "Pet2001.h"
+#include "Media.h"
 
 #include "Pet2001GtkAppWin.h"
 #include "Pet2001GtkDisp.h"
@@ -52,15 +54,98 @@ extern uint8_t petrom1[];
 extern uint8_t petrom2[];
 extern uint8_t petrom4[];
 
+#define AUDIO_RATE	48000
+#define AUDIO_RING_SIZE	16384	// samples, about 1/3 second
+
 Pet2001GtkApp::Pet2001GtkApp()
 	: Gtk::Application("net.skibo.pet2001gtk"),
 	  cass(this),
 	  ieee(this),
 	  pet(nullptr, cass.getCassHw(), ieee.getIeeeHw()),
-	  debugger(pet.getCpu())
+	  emu(pet.getCpu(), PET_CLOCK_RATE, PET_FRAME_CYCLES),
+	  rewind(PET_FRAME_CYCLES),
+	  movie("PET ", PET_FRAME_CYCLES),
+	  debugger(pet.getCpu()),
+	  audioRing(AUDIO_RING_SIZE, AUDIO_RATE)
 {
 	DPRINTF(1, "Pet2001GtkApp::%s:\n", __func__);
 
+	pet.setAudioRing(&audioRing);
+
+	// Slices stop at rewind snapshots and at movie frames and inputs.
+	// A false cycle ran no clock.
+	emu.setSliceFunc([&] (int n) {
+		while (n > 0) {
+			int m = movie.until(rewind.until(n));
+			for (int i = 0; i < m; i++)
+				if (!pet.cycle()) {
+					rewind.ran(i);
+					movie.ran(i);
+					return false;
+				}
+			rewind.ran(m);
+			movie.ran(m);
+			n -= m;
+		}
+		return true;
+	});
+	emu.setStopCallback([&] { this->onStopped(); });
+	emu.setNotifyCallback([&] { emuNotify.emit(); });
+	emuNotify.connect(sigc::mem_fun(emu, &EmuThread::runGui));
+
+	rewind.setSaveFunc([&] (StateWriter &w) { pet.saveState(w); });
+	rewind.setLoadFunc([&] (StateReader &r) {
+		return pet.loadState(r);
+	});
+	rewind.setRunFunc([&] (int n) {
+		while (n > 0)
+			if (pet.cycle())
+				n--;
+	});
+	rewind.setInputFunc([&] (const InputEvent &in) {
+		pet.input(in.type, in.a, in.b);
+	});
+	rewind.setDirtyPages(pet.getDirtyPages());
+	pet.setInputCallback([&] (int type, int a, int b) {
+		rewind.input(type, a, b);
+		movie.input(type, a, b);
+	});
+	rewind.setEnable(true);
+
+	movie.setSaveFunc([&] (StateWriter &w) { pet.saveState(w); });
+	movie.setHashFunc([&] { return pet.stateHash(); });
+	movie.setLoadFunc([&] (StateReader &r) {
+		return pet.loadState(r);
+	});
+	movie.setInputFunc([&] (const InputEvent &in) {
+		pet.input(in.type, in.a, in.b);
+	});
+	movie.setDoneCallback([&] {
+		emu.postGui([&] { this->onMovieDone(); });
+	});
+
+	// Tape and disk transfers run flat out, if asked to, with the
+	// display taking only the frames it can show.
+	emu.setBusyFunc([&] {
+		return cass.getCassHw()->isMotorOn() ||
+			ieee.getIeeeHw()->isBusy();
+	});
+	emu.setTurboCallback([&] (bool flag) { disp->setTurbo(flag); });
+
+	// Launching or switching model goes straight to READY after the
+	// first cold start with those ROMs.
+	bootcache.setBootFunc([&] {
+		pet.reset();
+		for (int i = 0; i < 600 && !pet.basicReady(); i++)
+			for (int n = PET_FRAME_CYCLES; n > 0; )
+				if (pet.cycle())
+					n--;
+	});
+	bootcache.setSaveFunc([&] (StateWriter &w) { pet.saveState(w); });
+	bootcache.setLoadFunc([&] (StateReader &r) {
+		return pet.loadState(r);
+	});
+
 	appwindow = nullptr;
 	debuggerActive = false;
 	disp = nullptr;
@@ -122,7 +207,7 @@ Pet2001GtkApp::create_appwindow()
 {
 	DPRINTF(1, "Pet2001GtkApp::%s:\n", __func__);
 
-	auto appwindow = Pet2001GtkAppWin::create(&pet);
+	auto appwindow = Pet2001GtkAppWin::create(&pet, &emu);
 
 	add_window(*appwindow);
 
@@ -146,6 +231,7 @@ Pet2001GtkApp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 	DPRINTF(1, "Pet2001GtkApp::%s:\n", __func__);
 
 	builder->get_widget("pause_button", pauseButton);
+	builder->get_widget("label_speed", labelSpeed);
 	pauseButton->signal_toggled().connect(sigc::mem_fun(*this,
 				&Pet2001GtkApp::onPauseToggle));
 
@@ -164,6 +250,10 @@ Pet2001GtkApp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 	menu->signal_activate().connect(sigc::mem_fun(*this,
 				&Pet2001GtkApp::onMenuReset));
 
+	builder->get_widget("menu_rewind", menu);
+	menu->signal_activate().connect(sigc::mem_fun(*this,
+				&Pet2001GtkApp::onMenuRewind));
+
 	builder->get_widget("menu_load_prg", menu);
 	menu->signal_activate().connect(sigc::mem_fun(*this,
 				&Pet2001GtkApp::onMenuLoadPrg));
@@ -191,11 +281,26 @@ Pet2001GtkApp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 				&Pet2001GtkApp::onMenuLoadRom),
 				0xc));
 
+	Gtk::CheckMenuItem *checkmenu = nullptr;
+	builder->get_widget("menu_capture", checkmenu);
+	checkmenu->signal_toggled().connect(sigc::bind(sigc::mem_fun(*this,
+				&Pet2001GtkApp::onMenuCapture),
+				checkmenu));
+
+	builder->get_widget("menu_movie_record", checkmenu);
+	checkmenu->signal_toggled().connect(sigc::bind(sigc::mem_fun(*this,
+				&Pet2001GtkApp::onMenuMovieRecord),
+				checkmenu));
+
+	builder->get_widget("menu_movie_play", menu);
+	menu->signal_activate().connect(sigc::mem_fun(*this,
+				&Pet2001GtkApp::onMenuMoviePlay));
+
 	builder->get_widget("menu_quit", menu);
 	menu->signal_activate().connect(sigc::mem_fun(*this,
 				&Pet2001GtkApp::onMenuQuit));
 
-	Gtk::CheckMenuItem *checkmenu = nullptr;
+	checkmenu = nullptr;
 	builder->get_widget("menu_debug", checkmenu);
 	checkmenu->signal_toggled().connect(sigc::bind(sigc::mem_fun(*this,
 				&Pet2001GtkApp::onMenuDebugToggle),
@@ -211,17 +316,26 @@ Pet2001GtkApp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 				&Pet2001GtkApp::onMenuDispGreenToggle),
 				checkmenu));
 
+	builder->get_widget("menu_auto_turbo", checkmenu);
+	checkmenu->signal_toggled().connect(sigc::bind(sigc::mem_fun(*this,
+				&Pet2001GtkApp::onMenuAutoTurboToggle),
+				checkmenu));
+	emu.setAutoTurbo(checkmenu->get_active());
+
 	builder->get_widget("menu_model_1", checkmenu);
+	modelMenu[1] = checkmenu;
 	checkmenu->signal_activate().connect(sigc::bind(sigc::mem_fun(*this,
 				&Pet2001GtkApp::onMenuModel),
 				checkmenu, 1));
 
 	builder->get_widget("menu_model_2", checkmenu);
+	modelMenu[2] = checkmenu;
 	checkmenu->signal_activate().connect(sigc::bind(sigc::mem_fun(*this,
 				&Pet2001GtkApp::onMenuModel),
 				checkmenu, 2));
 
 	builder->get_widget("menu_model_4", checkmenu);
+	modelMenu[4] = checkmenu;
 	checkmenu->signal_activate().connect(sigc::bind(sigc::mem_fun(*this,
 				&Pet2001GtkApp::onMenuModel),
 				checkmenu, 4));
@@ -243,6 +357,7 @@ Pet2001GtkApp::connectSignals(Glib::RefPtr <Gtk::Builder> builder)
 
 	disp = nullptr;
 	builder->get_widget_derived("pet_display", disp);
+	disp->setCapture(&capture);
 
 	Gtk::AboutDialog *about = nullptr;
 	builder->get_widget("win_about", about);
@@ -282,9 +397,15 @@ Pet2001GtkApp::on_activate()
 	turbo = false;
 	pet.setRamsize(32768);
 	disp->setVersion(0);
-	loadRom(model);
-	pet.reset();
+	findRoms();
+	loadRom(model, roms[model]);
+	bootPet();
 	petRun(true);
+
+	Glib::signal_timeout().connect(sigc::mem_fun(*this,
+				&Pet2001GtkApp::onTimeout), 10);
+	Glib::signal_timeout().connect(sigc::mem_fun(*this,
+				&Pet2001GtkApp::onStatus), 1000);
 }
 
 void
@@ -292,6 +413,7 @@ Pet2001GtkApp::on_hide_window(Gtk::Window *win)
 {
 	DPRINTF(1, "Pet2001GtkApp::%s:\n", __func__);
 
+	petRun(false);
 	delete win;
 	appwindow = nullptr;
 }
@@ -312,7 +434,7 @@ Pet2001GtkApp::onResetButton(void)
 {
 	DPRINTF(1, "Pet200GtkApp::%s:\n", __func__);
 
-	pet.reset();
+	emu.post([&] { pet.reset(); });
 }
 
 void
@@ -328,11 +450,15 @@ Pet2001GtkApp::debugCallback(int typ)
 		break;
 
 	case CALLBACK_STEP:
-		pet.getCpu()->stepCpu();
-		if (!running) {
-			while (pet.cycle())
-				;
+		if (running) {
+			// Thread stops after one instruction; see onStopped().
+			emu.post([&] { pet.getCpu()->stepCpu(); });
+			break;
 		}
+		pet.getCpu()->stepCpu();
+		while (pet.cycle())
+			;
+		disp->flush();
 		break;
 
 	case CALLBACK_CONT:
@@ -372,7 +498,7 @@ Pet2001GtkApp::onMenuDispDebugToggle(Gtk::CheckMenuItem *menu)
 
 	DPRINTF(1, "Pet2001GtkApp::%s: state=%d\n", __func__, state);
 
-	disp->setDebug(state);
+	emu.post([=] { disp->setDebug(state); });
 }
 
 void
@@ -384,7 +510,17 @@ Pet2001GtkApp::onMenuDispGreenToggle(Gtk::CheckMenuItem *menu)
 
 	static uint8_t green[] = { 0x40, 0xff, 0x40, 0x00 };
 	static uint8_t white[] = { 0xff, 0xff, 0xff, 0x00 };
-	disp->setForeground(state ? green : white);
+	emu.post([=] { disp->setForeground(state ? green : white); });
+}
+
+void
+Pet2001GtkApp::onMenuAutoTurboToggle(Gtk::CheckMenuItem *menu)
+{
+	bool state = menu->get_active();
+
+	DPRINTF(1, "Pet2001GtkApp::%s: state=%d\n", __func__, state);
+
+	emu.setAutoTurbo(state);
 }
 
 void
@@ -392,7 +528,24 @@ Pet2001GtkApp::onMenuReset(void)
 {
 	DPRINTF(1, "Pet2001GtkApp::%s:\n", __func__);
 
-	pet.reset();
+	emu.post([&] { pet.reset(); });
+}
+
+void
+Pet2001GtkApp::onMenuRewind(void)
+{
+	DPRINTF(1, "Pet2001GtkApp::%s:\n", __func__);
+
+	// Show where it landed if paused.  Not while a movie is going, as
+	// it would no longer match what was recorded.
+	bool paused = !running;
+	emu.post([=] {
+		if (movie.isActive())
+			return;
+		rewind.seek(PET_CLOCK_RATE / PET_FRAME_CYCLES);
+		if (paused)
+			disp->flush();
+	});
 }
 
 void
@@ -409,42 +562,41 @@ Pet2001GtkApp::onMenuLoadPrg(void)
 	DPRINTF(1, "Pet2001GtkApp::%s: filename=%s\n", __func__,
 		filename.c_str());
 
-	std::ifstream file(filename, std::ios::in | std::ios::binary |
-			   std::ios::ate);
-	if (file.is_open()) {
-		int len = file.tellg();
+	std::string error;
+	ImageRef image = Media::open(filename, MEDIA_PRG, error);
+	if (image) {
+		const uint8_t *data = image->getData();
+		int len = image->getSize();
 
 		if (len > MAX_PROG_LEN)
 			len = MAX_PROG_LEN;
 
-		uint8_t *data = new uint8_t[len];
-		file.seekg(0, std::ios::beg);
-		file.read((char *)data, len);
-		file.close();
-
 		uint16_t start_addr = data[0] + ((uint16_t)data[1] << 8);
 
 		DPRINTF(1, "Pet2001GtkApp::%s: start_addr=0x%x len=%d\n",
 			__func__, start_addr, len);
 
-		pet.writeRange(start_addr, &data[2], len - 2);
-		if (start_addr == 0x0400 || start_addr == 0x0401) {
-			uint16_t end_addr = start_addr + len - 2;
-			uint8_t bytes[6];
-
-			bytes[0] = end_addr & 0xff;
-			bytes[1] = end_addr >> 8;
-			bytes[2] = bytes[0];
-			bytes[3] = bytes[1];
-			bytes[4] = bytes[0];
-			bytes[5] = bytes[1];
-
-			// Tweak BASIC pointers.
-			pet.writeRange(model > 1 ? 42 : 124, bytes, 6);
-		}
-
-		delete [] data;
-	}
+		// Tweak BASIC pointers too if it's a BASIC program.
+		uint16_t ptrs = model > 1 ? 42 : 124;
+		emu.post([=] {
+			pet.writeRange(start_addr, image->getData() + 2,
+				       len - 2);
+			if (start_addr == 0x0400 || start_addr == 0x0401) {
+				uint16_t end_addr = start_addr + len - 2;
+				uint8_t bytes[6];
+
+				bytes[0] = end_addr & 0xff;
+				bytes[1] = end_addr >> 8;
+				bytes[2] = bytes[0];
+				bytes[3] = bytes[1];
+				bytes[4] = bytes[0];
+				bytes[5] = bytes[1];
+
+				pet.writeRange(ptrs, bytes, 6);
+			}
+		});
+	} else
+		fprintf(stderr, "%s: %s\n", filename.c_str(), error.c_str());
 }
 
 void
@@ -461,23 +613,13 @@ Pet2001GtkApp::onMenuLoadDisk(void)
 	DPRINTF(1, "Pet2001GtkApp::%s: filename=%s\n", __func__,
 		filename.c_str());
 
-	std::ifstream file(filename, std::ios::in | std::ios::binary |
-			   std::ios::ate);
-	if (file.is_open()) {
-		int len = file.tellg();
-
-		if (len > MAX_DISK_LEN)
-			len = MAX_DISK_LEN;
-
-		uint8_t *data = new uint8_t[len];
-		file.seekg(0, std::ios::beg);
-		file.read((char *)data, len);
-		file.close();
-
-		ieee.loadDisk(data, len);
-
-		delete [] data;
-	}
+	// The disk is read and written on the emulation thread.
+	std::string error;
+	ImageRef image = Media::open(filename, MEDIA_D64, error);
+	if (image)
+		emu.post([=] { ieee.loadDisk(image); });
+	else
+		fprintf(stderr, "%s: %s\n", filename.c_str(), error.c_str());
 }
 
 void
@@ -494,6 +636,10 @@ Pet2001GtkApp::onMenuSavePrg(void)
 	DPRINTF(1, "Pet2001GtkApp::%s: filename=%s\n", __func__,
 		filename.c_str());
 
+	// Hold the machine still while copying the program out.
+	bool wasRunning = emu.isRunning();
+	emu.run(false);
+
 	// Get end address of current program.
 	uint8_t bytes[2];
 	pet.readRange(model > 1 ? 42 : 124, bytes, sizeof(bytes));
@@ -511,6 +657,7 @@ Pet2001GtkApp::onMenuSavePrg(void)
 		__func__, start_addr, len);
 
 	pet.readRange(start_addr, &data[2], len - 2);
+	emu.run(wasRunning);
 
 	std::ofstream file(filename, std::ios::out | std::ios::binary |
 			   std::ios::trunc);
@@ -556,45 +703,156 @@ Pet2001GtkApp::onMenuLoadRom(int page)
 	DPRINTF(1, "Pet2001GtkApp::%s:  filename=%s\n", __func__,
 		filename.c_str());
 
-	std::ifstream file(filename, std::ios::in | std::ios::binary |
-			   std::ios::ate);
-	if (file.is_open()) {
-		uint16_t addr;
-		uint16_t sysaddr = (model == 4) ? 0xb000 : 0xc000;
-		int maxlen;
-		if (page == 0xc) {
-			// System ROM image
-			addr = sysaddr;
-			maxlen = 0xf800 - addr;
-		} else {
-			// Expansion ROM image
-			addr = page * 0x1000;
-			maxlen = sysaddr - addr;
-		}
+	std::string error;
+	ImageRef image = Media::open(filename, MEDIA_ROM, error);
+	if (!image) {
+		fprintf(stderr, "%s: %s\n", filename.c_str(), error.c_str());
+		return;
+	}
 
-		int len = file.tellg();
+	// A known system ROM switches to its model.
+	const KnownRom *known = Media::identify(image);
+	if (page == 0xc && known && known->machine == MEDIA_PET) {
+		int n = known->model;
+
+		roms[n] = image;
+		if (n != model)
+			modelMenu[n]->set_active(true);
+		else
+			emu.post([=] {
+				loadRom(n, image);
+				bootPet();
+				rewind.clear();
+			});
+		return;
+	}
 
-		if (len > maxlen)
-			len = maxlen;
+	uint16_t addr;
+	uint16_t sysaddr = (model == 4) ? 0xb000 : 0xc000;
+	int maxlen;
+	if (page == 0xc) {
+		// System ROM image
+		addr = sysaddr;
+		maxlen = 0xf800 - addr;
+	} else {
+		// Expansion ROM image
+		addr = page * 0x1000;
+		maxlen = sysaddr - addr;
+	}
 
-		uint8_t *data = new uint8_t[len];
-		file.seekg(0, std::ios::beg);
-		file.read((char *)data, len);
-		file.close();
+	int len = image->getSize();
 
-		if (page != 0xc) {
-			pet.writeRom(addr, data, len);
-		} else {
-			int chunk1 = IO_ADDR - sysaddr;
-			pet.writeRom(addr, data, std::min(chunk1, len));
-			if (len > chunk1)
-				pet.writeRom(IO_ADDR + IO_SIZE,
-					     data + chunk1, len - chunk1);
+	if (len > maxlen)
+		len = maxlen;
+
+	// A system ROM runs on past I/O space.
+	emu.post([=] {
+		pet.setRom(addr, image, 0, len);
+		if (page == 0xc)
 			pet.reset();
-		}
+		rewind.clear();
+	});
+}
+
+void
+Pet2001GtkApp::onMenuCapture(Gtk::CheckMenuItem *menu)
+{
+	bool active = menu->get_active();
+	DPRINTF(1, "Pet2001GtkApp::%s: active=%d\n", __func__, active);
+
+	if (active == capture.isOpen())
+		return;
 
-		delete [] data;
+	// Frames are fed to capture on the emulation thread.
+	bool wasRunning = emu.isRunning();
+	emu.run(false);
+	drainAudio();
+
+	if (!active) {
+		capture.close();
+		printf("Capture: %u frames, %u dropped, %u samples dropped\n",
+		       capture.getFrames(), capture.getDropped(),
+		       capture.getDroppedSamples());
+		emu.run(wasRunning);
+		return;
+	}
+
+	// Capture appends .y4m and .wav to the name.
+	std::string filename = doFileChooser(true, false);
+	if (filename.size() > 4 &&
+	    filename.compare(filename.size() - 4, 4, ".y4m") == 0)
+		filename.resize(filename.size() - 4);
+
+	if (filename == "" ||
+	    !capture.open(filename.c_str(), disp->getFrameBuffer(),
+			  PET_CLOCK_RATE, PET_FRAME_CYCLES,
+			  audioRing.getRate()))
+		menu->set_active(false);
+
+	emu.run(wasRunning);
+}
+
+// Recording starts from the machine as it is.  Movies don't hold the
+// ROMs, so play them back with the same model.
+void
+Pet2001GtkApp::onMenuMovieRecord(Gtk::CheckMenuItem *menu)
+{
+	bool active = menu->get_active();
+	DPRINTF(1, "Pet2001GtkApp::%s: active=%d\n", __func__, active);
+
+	if (active == movie.isRecording())
+		return;
+
+	bool wasRunning = emu.isRunning();
+	emu.run(false);
+
+	if (active)
+		movie.record();
+	else {
+		movie.stop();
+		std::string filename = doFileChooser(true, false,
+						     "movie.e6mv");
+		if (filename != "" && !movie.save(filename.c_str()))
+			fprintf(stderr, "Can't save movie %s\n",
+				filename.c_str());
+	}
+
+	emu.run(wasRunning);
+}
+
+void
+Pet2001GtkApp::onMenuMoviePlay(void)
+{
+	DPRINTF(1, "Pet2001GtkApp::%s:\n", __func__);
+
+	std::string filename = doFileChooser(false, false);
+
+	// Empty string means Cancel.
+	if (filename == "")
+		return;
+
+	bool wasRunning = emu.isRunning();
+	emu.run(false);
+
+	if (!movie.load(filename.c_str()) || !movie.play())
+		fprintf(stderr, "Can't play movie %s\n", filename.c_str());
+	else {
+		rewind.clear();
+		disp->flush();
 	}
+
+	emu.run(wasRunning);
+}
+
+// Playback reached the end of the movie.
+void
+Pet2001GtkApp::onMovieDone(void)
+{
+	printf("Movie: %u frames checked, %u mismatches\n",
+	       movie.getChecked(), movie.getMismatches());
+	if (movie.getMismatches() > 0)
+		printf("Movie: first mismatch at clock %llu\n",
+		       (unsigned long long)movie.getFirstMismatch());
 }
 
 void
@@ -610,9 +868,13 @@ Pet2001GtkApp::onMenuModel(Gtk::CheckMenuItem *menu, int n)
 
 	model = n;
 
-	disp->setVersion(model < 3 ? 0 : 1);
-	loadRom(model);
-	pet.reset();
+	ImageRef rom = roms[n];
+	emu.post([=] {
+		disp->setVersion(n < 3 ? 0 : 1);
+		loadRom(n, rom);
+		bootPet();
+		rewind.clear();
+	});
 }
 
 void
@@ -623,8 +885,10 @@ Pet2001GtkApp::onMenuRamsize(Gtk::CheckMenuItem *menu, int kbytes)
 
 	DPRINTF(1, "Pet2001GtkApp::%s: kbytes=%d\n", __func__, kbytes);
 
-	pet.setRamsize(1024 * kbytes);
-	pet.reset();
+	emu.post([=] {
+		pet.setRamsize(1024 * kbytes);
+		pet.reset();
+	});
 }
 
 void
@@ -636,67 +900,87 @@ Pet2001GtkApp::onMenuAbout(Gtk::AboutDialog *about)
 	about->set_visible(false);
 }
 
+// The system ROMs, from the ROM directory if they're there or else the
+// built-in ones.
 void
-Pet2001GtkApp::loadRom(int model)
+Pet2001GtkApp::findRoms(void)
 {
-	switch (model) {
-	case 1:
-		pet.writeRom(0xC000, petrom1, 0x2800);
-		pet.writeRom(0xF000, petrom1 + 0x2800, 0x1000);
-		break;
-	case 2:
-		pet.writeRom(0xC000, petrom2, 0x2800);
-		pet.writeRom(0xF000, petrom2 + 0x2800, 0x1000);
-		break;
-	case 4:
-		pet.writeRom(0xB000, petrom4, 0x3800);
-		pet.writeRom(0xF000, petrom4 + 0x3800, 0x1000);
-		break;
-	}
+	roms[1] = Media::findRom(MEDIA_PET, 1);
+	if (!roms[1])
+		roms[1] = Image::wrap(petrom1, 0x3800);
+	roms[2] = Media::findRom(MEDIA_PET, 2);
+	if (!roms[2])
+		roms[2] = Image::wrap(petrom2, 0x3800);
+	roms[4] = Media::findRom(MEDIA_PET, 4);
+	if (!roms[4])
+		roms[4] = Image::wrap(petrom4, 0x4800);
 }
 
-// Timer call-back function.
-bool
-Pet2001GtkApp::onTimeout(void)
+// Map a model's system ROM, which runs on past I/O space to 0xffff.
+void
+Pet2001GtkApp::loadRom(int model, ImageRef rom)
 {
-	if (running) {
-		int cycles = 10000; // 10ms
+	pet.setRom(model == 4 ? 0xb000 : 0xc000, rom, 0, rom->getSize());
+}
 
-		while (cycles-- > 0) {
-			if (!pet.cycle()) {
-				// Stopped due to breakpoint or other
-				running = false;
-				pauseButton->set_active(true);
-				debugger.setState(debuggerActive, running);
-				return false;
-			}
-		}
+// Reset and run to READY, or load the snapshot of having done that.
+void
+Pet2001GtkApp::bootPet(void)
+{
+	bootcache.boot("PET ", pet.getRamsize(), pet.romHash());
+}
 
-		return true;
-	}
+// Empty the audio ring, saving samples if capturing.  There is no
+// sound device output yet so samples are dropped otherwise.
+void
+Pet2001GtkApp::drainAudio(void)
+{
+	int16_t buf[1024];
+	int n;
 
-	return false;
+	while ((n = audioRing.read(buf, 1024)) > 0)
+		capture.audio(buf, n);
 }
 
+// Timer call-back function.  Emulation runs on its own thread; this
+// just keeps audio moving.
 bool
-Pet2001GtkApp::onIdle(void)
-{
-	if (running && turbo) {
-		int cycles = 10000; // 10ms
-		while (cycles-- > 0) {
-			if (!pet.cycle()) {
-				// Stopped due to breakpoint or other
-				running = false;
-				pauseButton->set_active(true);
-				debugger.setState(debuggerActive, running);
-				return false;
-			}
-		}
+Pet2001GtkApp::onTimeout(void)
+{
+	drainAudio();
 
-		return true;
-	}
+	return true;
+}
 
-	return false;
+// Once a second, show emulated speed and how well pacing is going.
+bool
+Pet2001GtkApp::onStatus(void)
+{
+	const Pacer *pacer = emu.getPacer();
+	char buf[64];
+
+	if (running)
+		snprintf(buf, sizeof(buf),
+			 "%.3f MHz  %.2fx  %u late  %u dropped",
+			 pacer->getClockHz() / 1.0e6, pacer->getSpeed(),
+			 pacer->getOverruns(), pacer->getDropped());
+	else
+		buf[0] = '\0';
+	labelSpeed->set_text(buf);
+
+	return true;
+}
+
+// Emulation thread stopped on a breakpoint or after a single step.
+void
+Pet2001GtkApp::onStopped(void)
+{
+	DPRINTF(1, "Pet2001GtkApp::%s:\n", __func__);
+
+	running = false;
+	pauseButton->set_active(true);
+	debugger.setState(debuggerActive, running);
+	drainAudio();
 }
 
 // Start or stop PET.
@@ -706,14 +990,7 @@ Pet2001GtkApp::petRun(bool flag)
 	if (running == flag)
 		return;
 
-	if (flag) {
-		Glib::signal_timeout().connect(sigc::mem_fun(*this,
-				&Pet2001GtkApp::onTimeout), 10);
-
-		if (turbo)
-			Glib::signal_idle().connect(sigc::mem_fun(*this,
-					&Pet2001GtkApp::onIdle));
-	}
+	emu.run(flag);
 
 	running = flag;
 }
@@ -724,9 +1001,7 @@ Pet2001GtkApp::petTurbo(bool flag)
 	if (turbo == flag)
 		return;
 
-	if (running && flag)
-		Glib::signal_idle().connect(sigc::mem_fun(*this,
-				&Pet2001GtkApp::onIdle));
+	emu.setTurbo(flag);
 
 	turbo = flag;
 }
@@ -734,6 +1009,9 @@ Pet2001GtkApp::petTurbo(bool flag)
 void
 Pet2001GtkApp::onMenuQuit(void)
 {
+	petRun(false);
+	capture.close();
+
 	auto windows = get_windows();
 	for (auto window : windows)
 		window->hide();
@@ -30,6 +30,12 @@
 #include "Pet2001GtkCass.h"
 #include "Pet2001GtkIeee.h"
 #include "Cpu6502GtkDebug.h"
+#include "AudioRing.h"
+#include "Capture.h"
+#include "EmuThread.h"
+#include "Rewind.h"
+#include "Movie.h"
+#include "BootCache.h"
 
 class Pet2001GtkAppWin;
 class Pet2001GtkDisp;
@@ -40,10 +46,20 @@ private:
 	Pet2001GtkCass	cass;
 	Pet2001GtkIeee	ieee;
 	Pet2001		pet;
+	EmuThread	emu;
+	Rewind		rewind;
+	Movie		movie;
+	BootCache	bootcache;
+	Glib::Dispatcher emuNotify;
 	Cpu6502GtkDebug	debugger;
 	Pet2001GtkDisp	*disp;
+	AudioRing	audioRing;
+	Capture		capture;
 
 	Gtk::ToggleButton *pauseButton;
+	Gtk::Label	*labelSpeed;
+	Gtk::CheckMenuItem *modelMenu[5];
+	ImageRef	roms[5];		// system ROMs by model
 
 	void		connectSignals(Glib::RefPtr <Gtk::Builder> builder);
 	int		model;
@@ -52,7 +68,9 @@ private:
 	bool		debuggerActive;
 
 	bool		onTimeout(void);
-	bool		onIdle(void);
+	bool		onStatus(void);
+	void		onStopped(void);
+	void		drainAudio(void);
 	void		petRun(bool flag);
 	void		petTurbo(bool flag);
 	void		onPauseToggle(void);
@@ -62,21 +80,31 @@ private:
 	void		onMenuDebugToggle(Gtk::CheckMenuItem *menu);
 	void		onMenuDispDebugToggle(Gtk::CheckMenuItem *menu);
 	void		onMenuDispGreenToggle(Gtk::CheckMenuItem *menu);
+	void		onMenuAutoTurboToggle(Gtk::CheckMenuItem *menu);
 	void		onMenuReset(void);
+	void		onMenuRewind(void);
 	void		onMenuLoadPrg(void);
 	void		onMenuSavePrg(void);
 	void		onMenuLoadDisk(void);
 	void		onMenuLoadRom(int);
+	void		onMenuCapture(Gtk::CheckMenuItem *menu);
+	void		onMenuMovieRecord(Gtk::CheckMenuItem *menu);
+	void		onMenuMoviePlay(void);
+	void		onMovieDone(void);
 	void		onMenuQuit(void);
 	void		onMenuModel(Gtk::CheckMenuItem *menu, int n);
 	void		onMenuRamsize(Gtk::CheckMenuItem *menu, int kbytes);
 	void		onMenuAbout(Gtk::AboutDialog *about);
-	void		loadRom(int model);
+	void		findRoms(void);
+	void		loadRom(int model, ImageRef rom);
+	void		bootPet(void);
 protected:
 	Pet2001GtkApp();
 public:
 	static Glib::RefPtr<Pet2001GtkApp> create();
 	Pet2001GtkAppWin *create_appwindow();
+	EmuThread	*getEmu(void)
+	{ return &emu; }
 	std::string	doFileChooser(bool dosave, bool diskfile,
 				      const char *hint = nullptr);
 	void		on_startup();
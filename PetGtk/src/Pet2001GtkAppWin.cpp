@@ -53,7 +53,7 @@ Pet2001GtkAppWin::Pet2001GtkAppWin(BaseObjectType *cobject,
 
 // Class function
 Pet2001GtkAppWin *
-Pet2001GtkAppWin::create(Pet2001 *pet)
+Pet2001GtkAppWin::create(Pet2001 *pet, EmuThread *emu)
 {
 	DPRINTF(1, "Pet2001GtkAppWin::%s:\n", __func__);
 
@@ -80,7 +80,7 @@ Pet2001GtkAppWin::create(Pet2001 *pet)
 	pet->setVideo(disp);
 
 	Pet2001GtkKeys *keys = nullptr;
-	builder->get_widget_derived("pet_keys", keys, pet);
+	builder->get_widget_derived("pet_keys", keys, pet, emu);
 	keys->connectSignals();
 
 	return window;
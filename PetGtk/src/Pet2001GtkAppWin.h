@@ -29,6 +29,7 @@
 #define __PET2001GTKAPPWIN_H__
 
 class Pet2001;
+class EmuThread;
 
 class Pet2001GtkAppWin : public Gtk::ApplicationWindow
 {
@@ -42,7 +43,7 @@ public:
 	~Pet2001GtkAppWin();
 	Glib::RefPtr<Gtk::Builder> getBuilder() { return this->builder; }
 
-	static Pet2001GtkAppWin *create(Pet2001 *pet);
+	static Pet2001GtkAppWin *create(Pet2001 *pet, EmuThread *emu);
 };
 
 #endif // __PET2001GTKAPPWIN_H__
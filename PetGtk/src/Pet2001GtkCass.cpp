@@ -30,10 +30,12 @@
 
 #include "Pet2001GtkCass.h"
 
+#include <cstdio>
 #include <iostream>
 #include <fstream>
 
 #include "PetCassHw.h"
+#include "Media.h"
 #include "Pet2001GtkApp.h"
 
 #ifdef DEBUGCASS
@@ -55,7 +57,12 @@ Pet2001GtkCass::Pet2001GtkCass(Pet2001GtkApp *app)
 	progsaving = false;
 	record_button = nullptr;
 	play_button = nullptr;
-	cass.setCassDoneCallback([&] (int len) {this->cassDoneCallback(len);});
+	// Called on the emulation thread; the rest runs on the GUI thread.
+	cass.setCassDoneCallback([&] (int len) {
+		this->app->getEmu()->postGui([=] {
+			this->cassDoneCallback(len);
+		});
+	});
 }
 
 void
@@ -67,7 +74,7 @@ Pet2001GtkCass::reset(void)
 	progsaving = false;
 	play_button->set_active(false);
 	record_button->set_active(false);
-	cass.reset();
+	app->getEmu()->post([&] { cass.reset(); });
 }
 
 void
@@ -132,13 +139,15 @@ Pet2001GtkCass::onRecordButton(Gtk::ToggleButton *button)
 	if (!active) {
 		// Cancel save if saving.
 		if (progsaving) {
-			cass.reset();
+			app->getEmu()->post([&] { cass.reset(); });
 			progsaving = false;
 		}
 		return;
 	}
 
-	cass.cassSave(proghdr, progdata, MAX_PROG_LEN);
+	app->getEmu()->post([&] {
+		cass.cassSave(proghdr, progdata, MAX_PROG_LEN);
+	});
 	progsaving = true;
 }
 
@@ -159,7 +168,7 @@ Pet2001GtkCass::onPlayButton(Gtk::ToggleButton *button)
 	if (!active) {
 		// Cancel load if loading.
 		if (progloading) {
-			cass.reset();
+			app->getEmu()->post([&] { cass.reset(); });
 			progloading = false;
 		}
 		return;
@@ -179,18 +188,16 @@ Pet2001GtkCass::onPlayButton(Gtk::ToggleButton *button)
 	DPRINTF(1, "Pet2001GtkModel::%s: filename=%s\n", __func__,
 		filename.c_str());
 
-	std::ifstream file(filename, std::ios::in | std::ios::binary |
-			   std::ios::ate);
-	if (file.is_open()) {
-		int len = file.tellg();
+	// The cassette plays straight from the mapped file.
+	std::string error;
+	progimage = Media::open(filename, MEDIA_PRG, error);
+	if (progimage) {
+		const uint8_t *data = progimage->getData();
+		int len = progimage->getSize();
 		if (len > MAX_PROG_LEN)
 			len = MAX_PROG_LEN;
 
-		file.seekg(0, std::ios::beg);
-		file.read((char *)progdata, len);
-		file.close();
-
-		uint16_t start_addr = progdata[0] + 256 * progdata[1];
+		uint16_t start_addr = data[0] + 256 * data[1];
 		uint16_t end_addr = start_addr + len - 2;
 
 		DPRINTF(1, "Pet2001GtkCass::%s: start_addr=0x%x len=%d\n",
@@ -210,11 +217,14 @@ Pet2001GtkCass::onPlayButton(Gtk::ToggleButton *button)
 		proghdr[10] = 'A';
 		proghdr[11] = 'M';
 
-		cass.cassLoad(proghdr, &progdata[2], len - 2);
+		app->getEmu()->post([=] {
+			cass.cassLoad(proghdr, data + 2, len - 2);
+		});
 		progloading = true;
 	}
 	else {
 		// Couldn't open file.  XXX: need an alert!
+		fprintf(stderr, "%s: %s\n", filename.c_str(), error.c_str());
 		progloading = false;
 		button->set_active(false);
 		return;
@@ -29,6 +29,7 @@
 #define __PET2001GTKCASS_H__
 
 #include "PetCassHw.h"
+#include "Image.h"
 class Pet2001GtkApp;
 
 #define MAX_PROG_LEN	32768
@@ -38,7 +39,8 @@ private:
 	Pet2001GtkApp	*app;
 	PetCassHw	cass;
 	uint8_t		proghdr[192];
-	uint8_t		progdata[MAX_PROG_LEN];
+	uint8_t		progdata[MAX_PROG_LEN];	// program saved
+	ImageRef	progimage;		// program loaded
 	bool		progloading;
 	bool		progsaving;
 	Gtk::ToggleButton *play_button;
@@ -28,63 +28,50 @@
 #ifndef __PET2001GTKDISP_H__
 #define __PET2001GTKDISP_H__
 
-#include "PetVideo.h"
+#include "PetRender.h"
+#include "Capture.h"
+#include "FrameSwap.h"
 
-#define PET_VIDPIXELS_SIZE 	8000
-
-class Pet2001GtkDisp : public Gtk::DrawingArea, public PetVideo {
+// Presents frames PetRender draws on the emulation thread.  The
+// renderer's side runs on that thread; everything else is GUI thread.
+class Pet2001GtkDisp : public Gtk::DrawingArea, public PetRender {
 private:
 	float		disp_scale;
 	float		disp_left;
 	float		disp_top;
 
-	uint8_t		vidmem[PET_VRAM_SIZE];
-	uint8_t		vidpixels[PET_VIDPIXELS_SIZE];
-	uint8_t		*charrom;
-	int		version;
-	bool		alt_charset;
-	bool		blank;
-	int		video_cycle;
-	bool		snowcycle;
-	uint8_t		snowbyte;
 	bool 		debugMode;
 
-	Glib::RefPtr<Gdk::Pixbuf> pixbuf;
-	u_char		*pb_data;
-	int		pb_stride;
-	int		pb_n_channels;
-	u_char		bg_color[4];
-	u_char		fg_color[4];
-
-	Gdk::Rectangle	update_rect;
+	Glib::RefPtr<Gdk::Pixbuf> pixbufs[FS_NBUFS];
+	FrameSwap	*swap;
+	Capture		*capture;
 
 	bool	onConfigure(GdkEventConfigure *event);
 	bool	onDraw(const ::Cairo::RefPtr<::Cairo::Context> &cr);
-	void	syncPixbuf(void);
-	void 	updateChar(int col, int row, uint8_t d8);
-	void	updateAll(void);
+	bool	onTick(const Glib::RefPtr<Gdk::FrameClock> &clock);
+	void	onFrame(FrameBuffer *frame);
 public:
 	Pet2001GtkDisp(BaseObjectType *cobject,
 		       const Glib::RefPtr<Gtk::Builder> &refBuilder);
+	~Pet2001GtkDisp();
 
+	void	setCapture(Capture *_capture)
+	{ this->capture = _capture; }
 	void	connectSignals(void);
 
-	void	setVersion(int);	// 0 = PET 2001, 1 = PET 2001N.
+	// Emulation thread, or GUI thread while emulation is stopped.
+	void	flush(void)
+	{ swap->publish(); }
+	void	setTurbo(bool flag)
+	{ swap->setTurbo(flag); }
 	void 	setDebug(bool _m);	// debug mode.
 	void	setForeground(uint8_t []);
 	void	setBackground(uint8_t []);
-	int	*getCycleCounter(void)
-	{ return &this->video_cycle; }
 
-	// PetVideo interface
-	void	sync(void);
-	void	reset(void);
-	void	cycle(void);
+	// PetVideo interface, where debug mode draws immediately.
 	void	setCharset(bool alt);
 	void	setBlank(bool blank);
-
 	void	write(uint16_t offset, uint8_t d8);
-	uint8_t	read(uint16_t offset);
 };
 
 #endif // __PET2001GTKDISP_H__
@@ -49,6 +49,7 @@ Pet2001GtkIeee::Pet2001GtkIeee(Pet2001GtkApp *app)
 	DPRINTF(1, "Pet2001GtkIeee::%s: app=%p\n", __func__, app);
 
 	this->app = app;
+	save_to_disk = false;
 
 	ieee.setIeeeDev(this);
 
@@ -62,6 +63,17 @@ Pet2001GtkIeee::connectSignals(Glib::RefPtr<Gtk::Builder> builder)
 
 	check_menu_save_to_disk = nullptr;
 	builder->get_widget("menu_save_to_disk", check_menu_save_to_disk);
+	check_menu_save_to_disk->signal_toggled().connect(sigc::mem_fun(*this,
+				&Pet2001GtkIeee::onSaveToDiskToggle));
+	onSaveToDiskToggle();
+}
+
+void
+Pet2001GtkIeee::onSaveToDiskToggle(void)
+{
+	save_to_disk = check_menu_save_to_disk->get_active();
+
+	DPRINTF(1, "Pet2001GtkIeee::%s: %d\n", __func__, (int)save_to_disk);
 }
 
 void
@@ -140,7 +152,7 @@ Pet2001GtkIeee::ieeeClose(int f)
 {
 	DPRINTF(1, "Pet2001GtkIeee::%s: f=%d\n", __func__, f);
 
-	if (f == 1 && check_menu_save_to_disk->get_active()) {
+	if (f == 1 && save_to_disk) {
 		(void)disk.writeFile(fname, fdata, flen);
 	} else if (f == 1) {
 		char hint[256];
@@ -148,20 +160,30 @@ Pet2001GtkIeee::ieeeClose(int f)
 		strncpy(hint, fname, sizeof(hint) - 4);
 		strcat(hint, ".prg");
 
-		std::string loc_filename = app->doFileChooser(true, false,
-							      hint);
-
-		// Empty string means Cancel.
-		if (loc_filename != "") {
-			DPRINTF(1, "Pet2001GtkIeee::%s: loc_filename=%s\n",
-				__func__, loc_filename.c_str());
-
-			std::ofstream file(loc_filename, std::ios::out |
-					   std::ios::binary | std::ios::trunc);
-			if (file.is_open()) {
-				file.write((char *)fdata, flen);
-				file.close();
-			} // XXX: else do error dialog
-		}
+		// On the emulation thread here.  Ask for a file name on
+		// the GUI thread with a copy of the data.
+		std::string h(hint);
+		std::vector<uint8_t> data(fdata, fdata + flen);
+		app->getEmu()->postGui([=] { this->saveFile(h, data); });
+	}
+}
+
+void
+Pet2001GtkIeee::saveFile(std::string hint, std::vector<uint8_t> data)
+{
+	std::string loc_filename = app->doFileChooser(true, false,
+						      hint.c_str());
+
+	// Empty string means Cancel.
+	if (loc_filename != "") {
+		DPRINTF(1, "Pet2001GtkIeee::%s: loc_filename=%s\n",
+			__func__, loc_filename.c_str());
+
+		std::ofstream file(loc_filename, std::ios::out |
+				   std::ios::binary | std::ios::trunc);
+		if (file.is_open()) {
+			file.write((char *)data.data(), data.size());
+			file.close();
+		} // XXX: else do error dialog
 	}
 }
@@ -32,6 +32,10 @@
 #include "PetIeeeHw.h"
 #include "PetDisk.h"
 
+#include <atomic>
+#include <string>
+#include <vector>
+
 class Pet2001GtkApp;
 
 #define MAXFILESIZE	32768
@@ -48,6 +52,10 @@ private:
 	int		findex;
 
 	Gtk::CheckMenuItem *check_menu_save_to_disk;
+	std::atomic<bool> save_to_disk;	// menu state for emulation thread
+
+	void		onSaveToDiskToggle(void);
+	void		saveFile(std::string hint, std::vector<uint8_t> data);
 
 	// IeeeDev interface
 	void		ieeeReset(void);
@@ -63,6 +71,8 @@ public:
 	void		connectSignals(Glib::RefPtr<Gtk::Builder> builder);
 	void		loadDisk(uint8_t data[], int len)
 		{ disk.loadDisk(data, len); }
+	void		loadDisk(ImageRef image)
+		{ disk.loadDisk(image); }
 };
 
 #endif // __PET2001GTKIEEE_H__
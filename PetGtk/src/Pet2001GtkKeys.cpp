@@ -31,6 +31,7 @@
 #include "Pet2001GtkKeys.h"
 
 #include "Pet2001.h"
+#include "EmuThread.h"
 
 #ifdef DEBUGKEYS
 #  include <cstdio>
@@ -87,10 +88,11 @@ static int keyascii[] = {
 
 Pet2001GtkKeys::Pet2001GtkKeys(BaseObjectType *cobject,
 			       const Glib::RefPtr<Gtk::Builder> &refBuilder,
-			       Pet2001 *_pet)
+			       Pet2001 *_pet, EmuThread *_emu)
 	: Gtk::DrawingArea(cobject)
 {
 	this->pet = _pet;
+	this->emu = _emu;
 
 	for (int i = 0; i < KEYSTATE_SIZE; i++)
 		key_state[i] = false;
@@ -157,7 +159,7 @@ Pet2001GtkKeys::updatePetKeys(void)
 			if (key_state[row * 8 + column])
 				keyrow &= ~(1 << column);
 		}
-		pet->setKeyrow(row, keyrow);
+		emu->post([=] { pet->setKeyrow(row, keyrow); });
 	}
 }
 
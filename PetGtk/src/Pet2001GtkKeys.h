@@ -32,10 +32,12 @@
 #define KEYMAP_SIZE	65536
 
 class Pet2001;
+class EmuThread;
 
 class Pet2001GtkKeys : public Gtk::DrawingArea {
 private:
 	Pet2001	*pet;
+	EmuThread *emu;
 	int	mouse_key;
 	bool	key_state[KEYSTATE_SIZE];
 	bool	key_shift;
@@ -59,7 +61,7 @@ private:
 public:
 	Pet2001GtkKeys(BaseObjectType *cobject,
 		       const Glib::RefPtr<Gtk::Builder> &refBuilder,
-		       Pet2001 *_pet);
+		       Pet2001 *_pet, EmuThread *_emu);
 	void	connectSignals(void);
 };
 